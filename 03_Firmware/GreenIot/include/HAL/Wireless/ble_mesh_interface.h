@@ -113,8 +113,8 @@ typedef struct {
  * @brief Mesh sensor data packet (multiple properties)
  */
 typedef struct {
-    float temperature_celsius;                  ///< Temperature in °C
-    float humidity_percent;                     ///< Humidity in %
+    int16_t temperature_centi_c;                ///< Temperature in 0.01 °C
+    uint16_t humidity_centi_pct;                ///< Humidity in 0.01 %RH
     uint8_t battery_level;                      ///< Battery level (0-100%)
     uint32_t timestamp;                         ///< Timestamp (milliseconds)
 } mesh_sensor_data_t;
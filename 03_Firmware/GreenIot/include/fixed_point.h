@@ -0,0 +1,51 @@
+/**
+ * @file fixed_point.h
+ * @brief Fixed-point measurement units and log formatting helpers
+ * 
+ * The ESP32-C3 (RV32IMC) has no FPU, so every float operation is a soft-float
+ * library call. Measurements are therefore carried in integer units from the
+ * raw sensor code to the mesh payload:
+ * 
+ *   temperature  int16_t   centi-°C   (2250 = 22.50 °C)
+ *   humidity     uint16_t  centi-%RH  (6120 = 61.20 %RH)
+ *   voltage      uint16_t  mV
+ * 
+ * Convert to float only at the human-facing edge (tests, host tools).
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief printf helpers for centi-unit values (no float formatting)
+ * 
+ * Usage: ESP_LOGI(TAG, "T: " CENTI_FMT " °C", CENTI_ARGS(t_centi));
+ * CENTI_ARGS evaluates its argument several times; pass a plain variable.
+ */
+#define CENTI_FMT "%s%d.%02d"
+#define CENTI_ABS(v) ((v) < 0 ? -(int32_t)(v) : (int32_t)(v))
+#define CENTI_ARGS(v) ((v) < 0 ? "-" : ""), (int)(CENTI_ABS(v) / 100), (int)(CENTI_ABS(v) % 100)
+
+#define CENTI_PER_UNIT 100
+
+/**
+ * @brief Human-facing conversion (host tools, tests)
+ */
+static inline float centi_to_float(int32_t centi) {
+    return (float)centi / (float)CENTI_PER_UNIT;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FIXED_POINT_H
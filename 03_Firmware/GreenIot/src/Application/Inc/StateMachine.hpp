@@ -4,6 +4,13 @@
  * 
  * Architecture Layer: APPLICATION LAYER
  * 
+ * Event driven: run() blocks on the state machine's event queue until an
+ * event arrives (state entered, a wait armed by the current state ran out,
+ * sensor ready, radio done, sensor ALERT). Nothing polls, so between events
+ * every task is blocked and tickless idle / automatic light sleep can
+ * engage. The queue leaves the task's notification value to the drivers
+ * (SHT31 async completion) running on the same task.
+ * 
  * @author GreenIoT Vertical Farming Project
  * @date 2025-11-03
  */
@@ -12,8 +19,14 @@
 #define STATE_MACHINE_HPP
 
 #include "ISensor.hpp"
+#include "SensorGroup.hpp"
+#include "MeasurementPipeline.hpp"
+#include "SensorScheduler.hpp"
+#include "MeasurementBatch.hpp"
+#include "RtcTimebase.hpp"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
 #include <cstdint>
-#include <memory>
 
 enum class SystemState {
     INIT,
@@ -24,17 +37,41 @@ enum class SystemState {
     ERROR
 };
 
+/**
+ * @brief Events that wake the state machine (one queue item each)
+ */
+enum class SystemEvent : uint8_t {
+    ENTER,          // A state was entered: run its handler
+    TIMEOUT,        // The wait armed by the current state ran out
+    SENSOR_READY,   // Sensor rail up for its startup time
+    RADIO_DONE,     // Mesh publication handed to the radio
+    SENSOR_ALERT,   // ALERT line went high while awake
+    COUNT
+};
+
 struct SystemConfig {
     uint32_t measurement_interval_sec;
     uint32_t transmission_interval_sec;
     uint8_t max_retries;
     const char* sensor_type;
+    const char* extra_sensor_types[SENSOR_GROUP_MAX_MEMBERS - 1];  // Further sensors on the bus (nullptr = unused)
+    uint32_t extra_sensor_interval_sec[SENSOR_GROUP_MAX_MEMBERS - 1];  // Their periods (0 = measurement_interval_sec)
+    uint32_t schedule_slack_sec;  // How early an acquisition may run to share another one's wake
+    bool enable_alert_wake;  // Wake on sensor ALERT; lets measurement_interval_sec be stretched
+    bool enable_adaptive_precision;  // Lowest burst repeatability that meets the noise target
+    uint8_t batch_size;  // Publish once this many readings are kept (0 = transmission schedule only)
     
     SystemConfig()
         : measurement_interval_sec(60)    // 1 minute
         , transmission_interval_sec(300)  // 5 minutes
         , max_retries(3)
-        , sensor_type("SHT31") {}
+        , sensor_type("SHT31")
+        , extra_sensor_types()
+        , extra_sensor_interval_sec()
+        , schedule_slack_sec(30)
+        , enable_alert_wake(true)
+        , enable_adaptive_precision(true)
+        , batch_size(0) {}
 };
 
 /**
@@ -45,33 +82,79 @@ public:
     StateMachine();
     ~StateMachine() = default;
     
-    void init(const SystemConfig& config);
-    void run();  // Called in loop
+    void init(const SystemConfig& config);  // From the task that calls run()
+    void run();  // Blocks until the next event and handles it; called in loop
+    
+    // Wake the state machine task (handled in the order posted)
+    void post(SystemEvent event);
+    void postFromISR(SystemEvent event);
     
     SystemState getState() const { return m_current_state; }
     
 private:
+    static constexpr uint8_t MAX_FAST_RECOVERIES = 2;  // Bus recoveries before the long back-off
+    static constexpr uint32_t RETRY_DELAY_MS = 1000;
+    static constexpr uint32_t ERROR_BACKOFF_MS = 5000;
+    static constexpr uint32_t PUBLISH_TIMEOUT_MS = 2000;  // Radio-done wait before sleeping anyway
+    static constexpr uint32_t MIN_DEEP_SLEEP_MS = 1000;   // Closer deadlines are waited for in IDLE
+    
     SystemState m_current_state;
     SystemState m_previous_state;
     SystemConfig m_config;
     
-    std::unique_ptr<ISensor> m_sensor;
-    SensorData m_last_reading;
+    ISensor* m_sensor;  // Static instance owned by SensorFactory, or m_group
+    SensorGroup m_group;  // Used when extra_sensor_types lists further sensors
+    MeasurementSample m_sample;  // Last measurement, from burst to mesh payload
+    MeasurementBatch m_batch;    // Readings not yet published (RTC memory)
+    uint8_t m_batch_in_flight;   // Readings in the publication awaiting RADIO_DONE
+    
+    // Per-sensor periods and the transmission, coalesced into shared wakes,
+    // on a clock kept through deep sleep
+    RtcTimebase m_timebase;
+    SensorScheduler m_scheduler;
+    uint8_t m_sensor_entries;   // Schedule entries 0..n-1 = sensors (group members), n = transmit
+    uint32_t m_due_mask;        // Entries served by this wake
     
     uint32_t m_last_measurement_time;
-    uint32_t m_last_transmission_time;
     uint8_t m_retry_count;
+    uint8_t m_fast_recovery_count;
+    bool m_alert_wake;  // Woken by the sensor ALERT: measure and publish at once
+    
+    // Event loop
+    QueueHandle_t m_events;      // Posted events, drained by run()
+    int64_t m_wait_until_us;     // Wait armed by the current state (0 = none)
+    SystemEvent m_wait_event;    // Delivered when that wait runs out
+    bool m_alert_watch;          // Sensor watching the alert window while IDLE waits
+    bool m_publish_pending;      // TRANSMIT waiting for the radio
+    bool m_error_backoff;        // ERROR waiting out the back-off
+    bool m_radio_started;        // BLE Mesh up (not on measure-only wakes)
     
     // State handlers
     void handleInit();
     void handleIdle();
-    void handleMeasure();
-    void handleTransmit();
+    void handleMeasure(SystemEvent event);
+    void handleTransmit(SystemEvent event);
     void handleSleep();
-    void handleError();
+    void handleError(SystemEvent event);
     
+    void dispatch(SystemEvent event);
+    void waitFor(uint32_t duration_ms, SystemEvent event);
+    TickType_t waitTicks() const;
+    void startAlertWatch();
+    void stopAlertWatch();
+    void finishTransmit(bool published);
+    void armAlertWake();
+    template <typename Sensor>
+    PipelineStatus acquire(Sensor& sensor);
+    bool setupSchedule();  // true if the kept deadlines were resumed
+    uint64_t nextWakeMs(uint64_t now_ms) const;  // Measurement interval without a schedule
+    bool startRadio();
+    bool batchDueAt(uint8_t readings) const;
+    uint32_t sensorMask() const { return (1UL << m_sensor_entries) - 1; }
+    uint32_t transmitMask() const { return 1UL << m_sensor_entries; }
     void transitionTo(SystemState new_state);
     uint32_t getUptime() const;
+    uint64_t getClockMs() const;  // Keeps counting through deep sleep
 };
 
 #endif // STATE_MACHINE_HPP
@@ -8,54 +8,175 @@
 
 #include "StateMachine.hpp"
 #include "I2CDriver.hpp"
+#include "SensorBinding.hpp"
 #include "PowerManager.hpp"
 #include "BLEMeshManager.hpp"
+#include "MeasurementStages.hpp"
+#include "WakeTrace.hpp"
+#include "HAL/Wireless/ble_mesh_config.h"
+#include "esp_attr.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+#include "freertos/queue.h"
+#include <cstring>
 
 static const char* TAG = "STATE_MACHINE";
 
+// Event queue: a state's ENTER plus the asynchronous events (radio done,
+// one ALERT per armed interrupt), with room to spare
+#define EVENT_QUEUE_DEPTH 8
+
+static StaticQueue_t s_event_queue_storage;
+static uint8_t s_event_queue_buffer[EVENT_QUEUE_DEPTH * sizeof(SystemEvent)];
+
+// Clock and acquisition/transmission deadlines, kept through deep sleep
+RTC_DATA_ATTR static RtcTimebaseState s_timebase;
+RTC_DATA_ATTR static SensorScheduleState s_schedule;
+
+// Readings waiting for the next radio session, kept through deep sleep
+RTC_DATA_ATTR static MeasurementBatchState s_batch;
+static uint8_t s_batch_payload[MEASUREMENT_BATCH_PAYLOAD_MAX];
+
+// Alert window: the basil critical limits, with hysteresis so a reading that
+// hovers at a limit does not toggle ALERT on every sample
+static constexpr SensorAlertLimits BASIL_ALERT_LIMITS = {
+    static_cast<int16_t>(BASIL_TEMP_MIN_CRITICAL * 100),
+    static_cast<int16_t>(BASIL_TEMP_MAX_CRITICAL * 100),
+    static_cast<uint16_t>(BASIL_HUM_MIN_CRITICAL * 100),
+    static_cast<uint16_t>(BASIL_HUM_MAX_CRITICAL * 100),
+    50,    // 0.5 °C
+    200    // 2 %RH
+};
+
+// Called from the ALERT GPIO interrupt
+static void IRAM_ATTR onSensorAlert(void* arg) {
+    static_cast<StateMachine*>(arg)->postFromISR(SystemEvent::SENSOR_ALERT);
+}
+
+// Called from the mesh stack once a publication is on air
+static void onPublishDone(BLEMeshStatus status, void* arg) {
+    TRACE_INSTANT(TracePoint::RADIO_DONE, static_cast<uint8_t>(status));
+    (void)status;
+    static_cast<StateMachine*>(arg)->post(SystemEvent::RADIO_DONE);
+}
+
+#ifdef WAKE_TRACE_ENABLE
+// One trace span per state
+static TracePoint stateTracePoint(SystemState state) {
+    switch (state) {
+        case SystemState::INIT: return TracePoint::STATE_INIT;
+        case SystemState::IDLE: return TracePoint::STATE_IDLE;
+        case SystemState::MEASURE: return TracePoint::STATE_MEASURE;
+        case SystemState::TRANSMIT: return TracePoint::STATE_TRANSMIT;
+        case SystemState::SLEEP: return TracePoint::STATE_SLEEP;
+        case SystemState::ERROR: return TracePoint::STATE_ERROR;
+        default: return TracePoint::NONE;
+    }
+}
+#endif
+
+// Adaptive repeatability: bursts run at high repeatability once a reading
+// comes within this margin of a basil critical limit
+static constexpr int16_t PRECISION_MARGIN_CENTI_C = 100;     // 1 °C
+static constexpr uint16_t PRECISION_MARGIN_CENTI_PCT = 500;  // 5 %RH
+
 StateMachine::StateMachine()
     : m_current_state(SystemState::INIT)
     , m_previous_state(SystemState::INIT)
+    , m_sensor(nullptr)
+    , m_batch(s_batch)
+    , m_batch_in_flight(0)
+    , m_timebase(s_timebase)
+    , m_scheduler(s_schedule)
+    , m_sensor_entries(1)
+    , m_due_mask(0)
     , m_last_measurement_time(0)
-    , m_last_transmission_time(0)
     , m_retry_count(0)
+    , m_fast_recovery_count(0)
+    , m_alert_wake(false)
+    , m_events(nullptr)
+    , m_wait_until_us(0)
+    , m_wait_event(SystemEvent::TIMEOUT)
+    , m_alert_watch(false)
+    , m_publish_pending(false)
+    , m_error_backoff(false)
+    , m_radio_started(false)
 {
-    m_last_reading = {};
+    m_sample = {};
 }
 
 void StateMachine::init(const SystemConfig& config) {
     m_config = config;
-    ESP_LOGI(TAG, "StateMachine initializing...");
-    ESP_LOGI(TAG, "  Measurement interval: %d sec", (int)config.measurement_interval_sec);
-    ESP_LOGI(TAG, "  Transmission interval: %d sec", (int)config.transmission_interval_sec);
-    ESP_LOGI(TAG, "  Sensor type: %s", config.sensor_type);
+    ESP_LOGD(TAG, "StateMachine initializing...");
+    ESP_LOGD(TAG, "  Measurement interval: %d sec", (int)config.measurement_interval_sec);
+    ESP_LOGD(TAG, "  Transmission interval: %d sec", (int)config.transmission_interval_sec);
+    ESP_LOGD(TAG, "  Sensor type: %s", config.sensor_type);
+    ESP_LOGD(TAG, "  Alert wake: %s", config.enable_alert_wake ? "enabled" : "disabled");
+    ESP_LOGD(TAG, "  Adaptive precision: %s", config.enable_adaptive_precision ? "enabled" : "disabled");
     
     m_current_state = SystemState::INIT;
+    TRACE_BEGIN(stateTracePoint(m_current_state));
+    if (m_events == nullptr) {
+        m_events = xQueueCreateStatic(EVENT_QUEUE_DEPTH, sizeof(SystemEvent),
+                                      s_event_queue_buffer, &s_event_queue_storage);
+    }
+    post(SystemEvent::ENTER);
 }
 
 void StateMachine::run() {
+    // Block until an event or the armed wait runs out; nothing else runs here,
+    // so the idle task can light-sleep through the gap
+    SystemEvent event;
+    if (xQueueReceive(m_events, &event, waitTicks()) != pdTRUE) {
+        event = m_wait_event;
+        m_wait_until_us = 0;
+    }
+    dispatch(event);
+}
+
+void StateMachine::post(SystemEvent event) {
+    // Never blocks: the poster may be the task that drains the queue
+    if (xQueueSend(m_events, &event, 0) != pdTRUE) {
+        ESP_LOGW(TAG, "Event queue full, event %d dropped", static_cast<int>(event));
+    }
+}
+
+void StateMachine::postFromISR(SystemEvent event) {
+    BaseType_t woken = pdFALSE;
+    xQueueSendFromISR(m_events, &event, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void StateMachine::dispatch(SystemEvent event) {
+    if (event == SystemEvent::SENSOR_ALERT) {
+        // Climate left the alert window: measure and publish as soon as possible
+        ESP_LOGW(TAG, "Sensor alert while awake");
+        m_alert_wake = true;
+    }
+    
     switch (m_current_state) {
         case SystemState::INIT:
-            handleInit();
+            if (event == SystemEvent::ENTER) {
+                handleInit();
+            }
             break;
         case SystemState::IDLE:
-            handleIdle();
+            handleIdle();  // Any event: re-evaluate the schedule
             break;
         case SystemState::MEASURE:
-            handleMeasure();
+            handleMeasure(event);
             break;
         case SystemState::TRANSMIT:
-            handleTransmit();
+            handleTransmit(event);
             break;
         case SystemState::SLEEP:
-            handleSleep();
+            if (event == SystemEvent::ENTER) {
+                handleSleep();
+            }
             break;
         case SystemState::ERROR:
-            handleError();
+            handleError(event);
             break;
     }
 }
@@ -68,15 +189,28 @@ void StateMachine::handleInit() {
     ESP_LOGI(TAG, "Wake-up cause: %s", 
              wakeup_cause == WakeupSource::TIMER ? "Timer" :
              wakeup_cause == WakeupSource::BUTTON ? "Button" :
+             wakeup_cause == WakeupSource::SENSOR_ALERT ? "Sensor Alert" :
              wakeup_cause == WakeupSource::POWER_ON ? "Power On" : "Unknown");
     
+    // Bridge the sleep on the RTC counter before anything reads the clock
+    if (m_timebase.start(PowerManager::getInstance().slowClockTicks(),
+                         PowerManager::getInstance().slowClockPeriod(),
+                         wakeup_cause == WakeupSource::TIMER)) {
+        ESP_LOGI(TAG, "Clock: %u ms wake latency, %u ppm drift",
+                 (unsigned int)(m_timebase.wakeLatencyUs() / 1000), (unsigned int)m_timebase.driftPpm());
+    }
+    
     // Initialize I2C
     I2CConfig i2c_config;
     i2c_config.sda_pin = 8;
     i2c_config.scl_pin = 9;
-    i2c_config.frequency_hz = 100000;
+    // frequency_hz stays at Standard mode for discovery; sensor drivers
+    // register faster per-device profiles once they have found their device
     
-    if (I2CDriver::getInstance().init(i2c_config) != I2CStatus::OK) {
+    TRACE_BEGIN(TracePoint::I2C_INIT);
+    I2CStatus i2c_status = I2CDriver::getInstance().init(i2c_config);
+    TRACE_END(TracePoint::I2C_INIT);
+    if (i2c_status != I2CStatus::OK) {
         ESP_LOGE(TAG, "I2C init failed");
         transitionTo(SystemState::ERROR);
         return;
@@ -87,130 +221,240 @@ void StateMachine::handleInit() {
     power_config.deep_sleep_duration_sec = m_config.measurement_interval_sec;  // Sleep between measurements
     power_config.enable_sensor_power_control = true;
     power_config.sensor_power_pin = 10;  // GPIO 10 for sensor power
+    power_config.sensor_alert_pin = 3;   // GPIO 3 <- SHT31 ALERT
+    power_config.enable_sensor_alert_wake = m_config.enable_alert_wake;
+    power_config.enable_auto_light_sleep = true;  // IDLE blocks between events
+    TRACE_BEGIN(TracePoint::POWER_INIT);
     PowerManager::getInstance().init(power_config);
+    TRACE_END(TracePoint::POWER_INIT);
+    PowerManager::getInstance().setSensorAlertHandler(onSensorAlert, this);
     
-    // Turn sensor power on for initialization
+    // Turn sensor power on for initialization (its startup time runs
+    // while the sensor is created and the radio initialises)
     PowerManager::getInstance().sensorPowerOn();
     
-    // Initialize BLE Mesh
-    BLEMeshConfig mesh_config;
-    mesh_config.company_id = 0x02E5;  // Espressif
-    mesh_config.product_id = 0x0001;  // GreenIoT Sensor Node
-    mesh_config.prov_method = ProvisioningMethod::PB_ADV;
-    mesh_config.enable_lpn = true;    // Low power node for battery operation
-    
-    if (BLEMeshManager::getInstance().init(mesh_config) != BLEMeshStatus::OK) {
-        ESP_LOGE(TAG, "BLE Mesh init failed");
-        transitionTo(SystemState::ERROR);
-        return;
+    // Create sensor
+#ifdef SENSOR_STATIC_BINDING
+    // Chosen at build time; sensor_type only has to agree with it
+    if (strcmp(m_config.sensor_type, SENSOR_STATIC_NAME) != 0) {
+        ESP_LOGW(TAG, "sensor_type %s ignored, image is built for %s",
+                 m_config.sensor_type, SENSOR_STATIC_NAME);
     }
-    
-    // Enable provisioning if not already provisioned
-    if (!BLEMeshManager::getInstance().isProvisioned()) {
-        if (BLEMeshManager::getInstance().enableProvisioning() != BLEMeshStatus::OK) {
-            ESP_LOGE(TAG, "Failed to enable provisioning");
-            transitionTo(SystemState::ERROR);
-            return;
+    m_sensor = BoundSensor::dynamicInstance();
+#else
+    m_sensor = SensorFactory::create(m_config.sensor_type);
+#endif
+    
+    // Further sensors: acquire all of them as one group (overlapping conversions)
+    if (m_sensor && m_config.extra_sensor_types[0] != nullptr) {
+        m_group.clear();
+        m_group.add(m_sensor);
+        for (uint8_t i = 0; i < SENSOR_GROUP_MAX_MEMBERS - 1; i++) {
+            const char* type = m_config.extra_sensor_types[i];
+            if (type == nullptr) break;
+            if (!m_group.add(SensorFactory::create(type))) {
+                ESP_LOGW(TAG, "Extra sensor %s not available", type);
+            }
         }
+        m_sensor = &m_group;
     }
-    
-    // Create sensor
-    m_sensor = SensorFactory::create(m_config.sensor_type);
     if (!m_sensor) {
         ESP_LOGE(TAG, "Sensor creation failed: %s", m_config.sensor_type);
         transitionTo(SystemState::ERROR);
         return;
     }
     
+    // Rail policy from the sensor's own figures; wait only for what is left
+    // of its startup time
+    const SensorInfo& power_info = m_sensor->getInfo();
+    PowerManager::getInstance().configureSensorPower(power_info);
+    PowerManager::getInstance().waitSensorStartup();
+    
     // Initialize sensor
-    if (m_sensor->init() != SensorStatus::OK) {
+    TRACE_BEGIN(TracePoint::SENSOR_INIT);
+    SensorStatus sensor_status = m_sensor->init();
+    TRACE_END(TracePoint::SENSOR_INIT);
+    if (sensor_status != SensorStatus::OK) {
         ESP_LOGE(TAG, "Sensor init failed");
         transitionTo(SystemState::ERROR);
         return;
     }
     
-    const SensorInfo& info = m_sensor->getInfo();
-    ESP_LOGI(TAG, "Sensor initialized: %s by %s", info.name.c_str(), info.manufacturer.c_str());
-    ESP_LOGI(TAG, "  Temp range: %.1f to %.1f °C (±%.2f °C)", 
-             info.temp_min, info.temp_max, info.temp_accuracy);
-    ESP_LOGI(TAG, "  Humidity range: %.1f to %.1f %% (±%.1f %%)", 
-             info.hum_min, info.hum_max, info.hum_accuracy);
+    SensorConfig sensor_config;
+    sensor_config.adaptive_precision = m_config.enable_adaptive_precision;
+    sensor_config.precision_window = {
+        static_cast<int16_t>(BASIL_ALERT_LIMITS.temp_low_centi_c + PRECISION_MARGIN_CENTI_C),
+        static_cast<int16_t>(BASIL_ALERT_LIMITS.temp_high_centi_c - PRECISION_MARGIN_CENTI_C),
+        static_cast<uint16_t>(BASIL_ALERT_LIMITS.hum_low_centi_pct + PRECISION_MARGIN_CENTI_PCT),
+        static_cast<uint16_t>(BASIL_ALERT_LIMITS.hum_high_centi_pct - PRECISION_MARGIN_CENTI_PCT),
+        0, 0
+    };
+    if (m_sensor->configure(sensor_config) != SensorStatus::OK) {
+        ESP_LOGW(TAG, "Sensor configuration failed, using driver defaults");
+    }
     
-    // Check battery
-    float battery_v = PowerManager::getInstance().getBatteryVoltage();
-    uint8_t battery_pct = PowerManager::getInstance().getBatteryPercent();
-    ESP_LOGI(TAG, "Battery: %.2fV (%d%%)", battery_v, battery_pct);
+    const SensorInfo& info = m_sensor->getInfo();
+    ESP_LOGD(TAG, "Sensor initialized: %s by %s", info.name, info.manufacturer);
+    ESP_LOGD(TAG, "  Temp range: " CENTI_FMT " to " CENTI_FMT " °C (±" CENTI_FMT " °C)", 
+             CENTI_ARGS(info.temp_min_centi_c), CENTI_ARGS(info.temp_max_centi_c),
+             CENTI_ARGS(info.temp_accuracy_centi_c));
+    ESP_LOGD(TAG, "  Humidity range: " CENTI_FMT " to " CENTI_FMT " %% (±" CENTI_FMT " %%)", 
+             CENTI_ARGS(info.hum_min_centi_pct), CENTI_ARGS(info.hum_max_centi_pct),
+             CENTI_ARGS(info.hum_accuracy_centi_pct));
     
     m_last_measurement_time = getUptime();
-    m_last_transmission_time = getUptime();
+    bool resumed = setupSchedule();
+    if (m_batch.restore() && m_batch.size() > 0) {
+        ESP_LOGI(TAG, "Batch: %u readings kept for transmission", m_batch.size());
+    }
+    
+    // Measure-only wake: a timer wake of a running schedule with no
+    // transmission due and a batch this reading will not fill. The radio
+    // stays off (TRANSMIT starts it should the reading need publishing)
+    bool transmit_due = (m_scheduler.dueMask(getClockMs()) & transmitMask()) != 0;
+    bool measure_only = wakeup_cause == WakeupSource::TIMER && resumed && !transmit_due &&
+                        !batchDueAt(m_batch.size() + 1);
+    if (measure_only) {
+        ESP_LOGI(TAG, "Measure-only wake, radio stays off");
+        TRACE_INSTANT(TracePoint::MEASURE_ONLY, m_batch.size());
+    } else if (!startRadio()) {
+        transitionTo(SystemState::ERROR);
+        return;
+    }
+    
+    if (wakeup_cause == WakeupSource::SENSOR_ALERT) {
+        // Climate left the alert window: skip the idle wait, measure and publish
+        ESP_LOGW(TAG, "Sensor alert wake, measuring immediately");
+        m_alert_wake = true;
+        m_due_mask = sensorMask() | transmitMask();
+        transitionTo(SystemState::MEASURE);
+        return;
+    }
     
     transitionTo(SystemState::IDLE);
 }
 
 void StateMachine::handleIdle() {
-    uint32_t now = getUptime();
-    
-    // Check if measurement is due
-    if ((now - m_last_measurement_time) >= (m_config.measurement_interval_sec * 1000)) {
+    // Everything whose window is open is served by this one wake
+    uint64_t now_ms = getClockMs();
+    m_due_mask = m_scheduler.dueMask(now_ms);
+    if (m_alert_wake) {
+        m_due_mask |= sensorMask() | transmitMask();
+    }
+    if (m_due_mask != 0) {
+        if (m_due_mask & transmitMask()) {
+            m_due_mask |= sensorMask();  // Publish a fresh reading
+        }
         transitionTo(SystemState::MEASURE);
         return;
     }
     
-    // Else sleep for a bit
-    vTaskDelay(pdMS_TO_TICKS(100));
+    // Else block until the earliest deadline; the sensor watches the alert
+    // window meanwhile
+    startAlertWatch();
+    uint64_t sleep_ms = nextWakeMs(now_ms) - now_ms;
+    waitFor((sleep_ms > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(sleep_ms), SystemEvent::TIMEOUT);
 }
 
-void StateMachine::handleMeasure() {
-    ESP_LOGI(TAG, "STATE: MEASURE");
+void StateMachine::handleMeasure(SystemEvent event) {
+    if (event == SystemEvent::SENSOR_ALERT || event == SystemEvent::RADIO_DONE) {
+        return;  // Measuring already; the pending wait stands
+    }
+    if (event == SystemEvent::ENTER) {
+        ESP_LOGI(TAG, "STATE: MEASURE");
+    }
     
-    // Ensure sensor is powered on
-    if (!PowerManager::getInstance().isSensorPowered()) {
-        PowerManager::getInstance().sensorPowerOn();
-        vTaskDelay(pdMS_TO_TICKS(50));  // Wait for sensor to stabilize
+    // Ensure sensor is powered on; what is left of its startup time is
+    // spent blocked (nothing if the rail stayed up)
+    PowerManager& power = PowerManager::getInstance();
+    power.sensorPowerOn();
+    uint32_t startup_ms = power.sensorStartupRemainingMs();
+    if (startup_ms > 0) {
+        waitFor(startup_ms, SystemEvent::SENSOR_READY);
+        return;
     }
+    power.waitSensorStartup();
     
     if (!m_sensor) {
         ESP_LOGE(TAG, "Sensor not initialized");
         transitionTo(SystemState::ERROR);
         return;
     }
+    stopAlertWatch();  // Measurements need the sensor out of alert monitoring
     
-    // Trigger measurement
-    if (m_sensor->triggerMeasurement() != SensorStatus::OK) {
-        ESP_LOGE(TAG, "Failed to trigger measurement");
-        transitionTo(SystemState::ERROR);
-        return;
-    }
+    // Battery sampling (ADC averaging) before the burst, which keeps the
+    // sensor converting back to back
+    m_sample.battery_percent = PowerManager::getInstance().getBatteryPercent();
     
-    // Read sensor data
-    SensorData data;
-    SensorStatus status = m_sensor->read(data);
+    // Only the due members of a group are acquired
+    uint32_t sensors_due = m_due_mask & sensorMask();
+    if (sensors_due == 0) {
+        sensors_due = sensorMask();
+    }
+    if (m_sensor == &m_group) {
+        m_group.select(static_cast<uint8_t>(sensors_due));
+    }
     
-    if (status != SensorStatus::OK) {
-        ESP_LOGE(TAG, "Sensor read failed: %s", ISensor::statusToString(status));
+    // Burst of low-repeatability samples aggregated in one powered window;
+    // a single bad sample is masked out instead of costing a retry
+#ifdef SENSOR_STATIC_BINDING
+    PipelineStatus status = (m_sensor == &m_group) ? acquire(m_group)  // Direct calls
+                                                   : acquire(BoundSensor::instance());
+#else
+    PipelineStatus status = acquire(*m_sensor);
+#endif
+    const BurstResult& burst = m_sample.burst;
+    const SensorData& data = burst.data;
+    
+    if (status != PipelineStatus::OK) {
+        if (status == PipelineStatus::ERROR_ACQUIRE) {
+            ESP_LOGE(TAG, "Sensor read failed: %s", ISensor::statusToString(m_sample.sensor_status));
+        } else {
+            ESP_LOGE(TAG, "Measurement rejected: %s", pipelineStatusToString(status));
+        }
         m_retry_count++;
         
         if (m_retry_count >= m_config.max_retries) {
             transitionTo(SystemState::ERROR);
         } else {
-            vTaskDelay(pdMS_TO_TICKS(1000));
-            // Retry measurement
+            waitFor(RETRY_DELAY_MS, SystemEvent::TIMEOUT);  // Retry measurement
         }
         return;
     }
     
     // Valid data
-    m_last_reading = data;
     m_retry_count = 0;
+    m_fast_recovery_count = 0;
     m_last_measurement_time = getUptime();
+    uint64_t now_ms = getClockMs();
+    m_sample.burst.data.timestamp = static_cast<uint32_t>(now_ms / 1000);
+    m_scheduler.complete(sensors_due, now_ms);
+    m_batch.push(m_sample.burst.data.timestamp, data);
+    
+    ESP_LOGI(TAG, "Measurement successful (%u/%u samples):", burst.valid, burst.samples);
+    ESP_LOGI(TAG, "  Temperature: " CENTI_FMT " °C", CENTI_ARGS(data.temperature_centi_c));
+    ESP_LOGI(TAG, "  Humidity: " CENTI_FMT " %%", CENTI_ARGS(data.humidity_centi_pct));
+    if (m_sensor == &m_group) {
+        for (uint8_t i = 0; i < m_group.size(); i++) {
+            if (!(sensors_due & (1UL << i))) continue;
+            const SensorData& member = m_group.memberData(i);
+            const char* name = m_group.member(i)->getInfo().name;
+            if (m_group.validMask() & (1U << i)) {
+                ESP_LOGI(TAG, "    %s: " CENTI_FMT " °C, " CENTI_FMT " %%", name,
+                         CENTI_ARGS(member.temperature_centi_c), CENTI_ARGS(member.humidity_centi_pct));
+            } else {
+                ESP_LOGW(TAG, "    %s: no valid reading", name);
+            }
+        }
+    }
     
-    ESP_LOGI(TAG, "Measurement successful:");
-    ESP_LOGI(TAG, "  Temperature: %.2f °C", data.temperature_celsius);
-    ESP_LOGI(TAG, "  Humidity: %.1f %%", data.humidity_percent);
-    
-    // Check if transmission is due
-    uint32_t now = getUptime();
-    if ((now - m_last_transmission_time) >= (m_config.transmission_interval_sec * 1000)) {
+    // Check if transmission is due (an alert wake or reading always publishes;
+    // so does a batch that reached its size or would start dropping readings)
+    if (m_sample.alert) {
+        ESP_LOGW(TAG, "Reading outside the basil critical limits, publishing now");
+    }
+    bool batch_due = batchDueAt(m_batch.size());
+    if (m_alert_wake || m_sample.alert || batch_due || (m_due_mask & transmitMask())) {
         transitionTo(SystemState::TRANSMIT);
     } else {
         // After measurement, go to sleep if auto-sleep enabled
@@ -222,25 +466,47 @@ void StateMachine::handleMeasure() {
     }
 }
 
-void StateMachine::handleTransmit() {
+void StateMachine::handleTransmit(SystemEvent event) {
+    if (m_publish_pending) {
+        // Sleep once the radio is done with the message (or it never says so)
+        if (event == SystemEvent::TIMEOUT) {
+            ESP_LOGW(TAG, "No publish completion from the radio");
+            finishTransmit(false);
+        } else if (event == SystemEvent::RADIO_DONE) {
+            finishTransmit(true);
+        }
+        return;
+    }
+    if (event != SystemEvent::ENTER) {
+        return;
+    }
+    
     ESP_LOGI(TAG, "STATE: TRANSMIT");
     
-    // Prepare mesh sensor data
-    MeshSensorData mesh_data;
-    mesh_data.temperature = m_last_reading.temperature_celsius;
-    mesh_data.humidity = m_last_reading.humidity_percent;
-    mesh_data.timestamp = m_last_reading.timestamp;
-    mesh_data.battery_percent = PowerManager::getInstance().getBatteryPercent();
+    // Radio not started yet on a measure-only wake whose reading needs publishing
+    if (!startRadio()) {
+        transitionTo(SystemState::ERROR);
+        return;
+    }
     
-    // Send via BLE Mesh
-    BLEMeshStatus status = BLEMeshManager::getInstance().sendSensorData(mesh_data);
+    // Several readings kept: all of them in one message, or the last one as
+    // a Sensor Status while the mesh carries no batch. Either way the
+    // message covers the whole batch once the radio is done with it
+    if (m_batch.dropped() > 0) {
+        ESP_LOGW(TAG, "Batch full: %u oldest readings dropped", m_batch.dropped());
+    }
+    if (m_batch.size() > 1) {
+        ESP_LOGI(TAG, "Publishing %u kept readings", m_batch.size());
+    }
+    MeasurementPipeline publish(MeshTransmitStage<BLEMeshManager>(
+        BLEMeshManager::getInstance(), m_batch, s_batch_payload, static_cast<uint32_t>(getClockMs() / 1000)));
+    PipelineStatus status = publish.run(m_sample);
     
-    if (status != BLEMeshStatus::OK) {
-        ESP_LOGW(TAG, "BLE Mesh transmission failed: %s", 
-                 BLEMeshManager::statusToString(status));
+    if (status != PipelineStatus::OK) {
+        ESP_LOGW(TAG, "BLE Mesh transmission failed: %s", pipelineStatusToString(status));
         
         // If not provisioned, that's OK - we'll try again later
-        if (status != BLEMeshStatus::ERROR_NOT_PROVISIONED) {
+        if (status != PipelineStatus::ERROR_OFFLINE) {
             m_retry_count++;
             if (m_retry_count >= m_config.max_retries) {
                 ESP_LOGE(TAG, "Max transmission retries reached");
@@ -250,9 +516,25 @@ void StateMachine::handleTransmit() {
         }
     } else {
         m_retry_count = 0;  // Reset retry counter on success
+        m_batch_in_flight = m_batch.size();
+        m_publish_pending = true;
+        waitFor(PUBLISH_TIMEOUT_MS, SystemEvent::TIMEOUT);
+        return;
     }
     
-    m_last_transmission_time = getUptime();
+    finishTransmit(false);
+}
+
+void StateMachine::finishTransmit(bool published) {
+    // Unpublished readings stay in the batch for the next radio session
+    if (published) {
+        m_batch.consume(m_batch_in_flight);
+    }
+    m_batch_in_flight = 0;
+    m_publish_pending = false;
+    m_scheduler.complete(transmitMask(), getClockMs());
+    m_due_mask = 0;
+    m_alert_wake = false;
     
     // After transmission, enter sleep mode
     transitionTo(SystemState::SLEEP);
@@ -261,61 +543,277 @@ void StateMachine::handleTransmit() {
 void StateMachine::handleSleep() {
     ESP_LOGI(TAG, "STATE: SLEEP");
     
-    // Calculate sleep duration based on measurement interval
-    uint32_t sleep_duration_sec = m_config.measurement_interval_sec;
+    // Be running at the earliest deadline: the timer fires the learned wake
+    // latency early, and early by the clock's guard time so a fast clock
+    // cannot make the wake late (IDLE waits out whatever is left)
+    uint64_t now_us = getClockMs() * 1000;
+    uint64_t sleep_us = m_timebase.sleepUs(now_us, nextWakeMs(now_us / 1000) * 1000);
+    uint32_t guard_us = m_timebase.guardUs(sleep_us);
+    sleep_us = (sleep_us > guard_us) ? sleep_us - guard_us : 0;
+    if (sleep_us > UINT32_MAX * 1000ULL) {
+        sleep_us = UINT32_MAX * 1000ULL;
+    }
+    uint32_t sleep_ms = static_cast<uint32_t>(sleep_us / 1000);
+    if (sleep_ms < MIN_DEEP_SLEEP_MS) {
+        // Not worth a reboot
+        ESP_LOGI(TAG, "Next deadline in %u ms, waiting awake", (unsigned int)sleep_ms);
+        transitionTo(SystemState::IDLE);
+        return;
+    }
     
     // Update power statistics before sleep
     uint32_t now = getUptime();
     uint32_t active_time = now - m_last_measurement_time;
-    PowerManager::getInstance().updatePowerStats(active_time, sleep_duration_sec * 1000);
+    PowerManager::getInstance().updatePowerStats(active_time, sleep_ms);
     
     // Log power statistics
     PowerStats stats = PowerManager::getInstance().getPowerStats();
     ESP_LOGI(TAG, "Power Statistics:");
-    ESP_LOGI(TAG, "  Average current: %.2f µA", stats.avg_current_ua);
-    ESP_LOGI(TAG, "  Active current: %.2f mA", stats.active_current_ma);
-    ESP_LOGI(TAG, "  Sleep current: %.2f µA", stats.sleep_current_ua);
+    ESP_LOGI(TAG, "  Average current: %u µA", (unsigned int)stats.avg_current_ua);
+    ESP_LOGI(TAG, "  Active current: %u µA", (unsigned int)stats.active_current_ua);
+    ESP_LOGI(TAG, "  Sleep current: %u µA", (unsigned int)stats.sleep_current_ua);
     ESP_LOGI(TAG, "  Wake-up count: %u", (unsigned int)stats.wakeup_count);
-    ESP_LOGI(TAG, "  Estimated battery life: %.1f days", stats.estimated_battery_life_days);
+    ESP_LOGI(TAG, "  Estimated battery life: %u days", (unsigned int)stats.estimated_battery_life_days);
+    
+    const I2CDriverStats& i2c_stats = I2CDriver::getInstance().getStats();
+    ESP_LOGI(TAG, "I2C: %u transactions, %u heap link allocations",
+             (unsigned int)i2c_stats.transactions, (unsigned int)i2c_stats.heap_link_allocs);
+    ESP_LOGI(TAG, "I2C: bus busy %u us, %u clock switches, %u speed fallbacks, %u recoveries",
+             (unsigned int)i2c_stats.bus_busy_us, (unsigned int)i2c_stats.clock_switches,
+             (unsigned int)i2c_stats.speed_fallbacks, (unsigned int)i2c_stats.bus_recoveries);
+    
+    // Per-address latency/error statistics (also available for mesh telemetry)
+    const I2CStats& bus_stats = I2CDriver::getInstance().getBusStats();
+    I2CDeviceStatsSnapshot dev;
+    for (uint8_t i = 0; bus_stats.snapshotAt(i, dev); i++) {
+        ESP_LOGI(TAG, "  0x%02X: %u txn, %u B, %u/%u/%u us min/avg/max, %u NACK, %u timeout, %u retry",
+                 dev.address, (unsigned int)dev.transactions, (unsigned int)dev.bytes,
+                 (unsigned int)dev.min_us, (unsigned int)dev.avgUs(), (unsigned int)dev.max_us,
+                 (unsigned int)dev.nacks, (unsigned int)dev.timeouts, (unsigned int)dev.retries);
+    }
+    ESP_LOGI(TAG, "I2C bus utilisation: %u permille",
+             (unsigned int)bus_stats.utilisationPermille(static_cast<uint32_t>(esp_timer_get_time())));
+    
+    armAlertWake();
     
     // Enter deep sleep (device will reset on wake-up)
-    ESP_LOGI(TAG, "Entering deep sleep for %d seconds...", (int)sleep_duration_sec);
-    PowerManager::getInstance().enterDeepSleep(sleep_duration_sec);
+    ESP_LOGI(TAG, "Entering deep sleep for %u ms (guard %u us)...",
+             (unsigned int)sleep_ms, (unsigned int)guard_us);
+    m_timebase.prepareSleep(now_us, static_cast<uint64_t>(sleep_ms) * 1000);
+    PowerManager::getInstance().enterDeepSleepMs(sleep_ms);
     
     // NOTE: Execution NEVER reaches here (device resets on wakeup)
 }
 
-void StateMachine::handleError() {
+void StateMachine::handleError(SystemEvent event) {
+    if (m_error_backoff) {
+        if (event != SystemEvent::TIMEOUT) {
+            return;  // Back-off still running
+        }
+        m_error_backoff = false;
+        
+        // Reset retry counter
+        m_retry_count = 0;
+        
+        // Try reinitializing
+        if (m_sensor) {
+            m_sensor->reset();
+        }
+        
+        // INIT never finished (no schedule, maybe no radio): sleep one
+        // measurement interval and run it again from the reboot
+        transitionTo(m_scheduler.size() == 0 ? SystemState::SLEEP : SystemState::IDLE);
+        return;
+    }
+    if (event != SystemEvent::ENTER) {
+        return;
+    }
+    
     ESP_LOGE(TAG, "STATE: ERROR");
     
     // Log error details
-    float battery_v = PowerManager::getInstance().getBatteryVoltage();
-    ESP_LOGE(TAG, "System error occurred. Battery: %.2fV", battery_v);
+    uint16_t battery_mv = PowerManager::getInstance().getBatteryMillivolts();
+    ESP_LOGE(TAG, "System error occurred. Battery: %u mV", (unsigned int)battery_mv);
+    
+    // Fast path: free the I2C bus and reset the sensor (a few ms) before
+    // falling back to the long back-off, at most MAX_FAST_RECOVERIES in a row
+    if (m_sensor && m_fast_recovery_count < MAX_FAST_RECOVERIES) {
+        m_fast_recovery_count++;
+        if (I2CDriver::getInstance().recoverBus() == I2CStatus::OK &&
+            m_sensor->reset() == SensorStatus::OK) {
+            ESP_LOGW(TAG, "I2C bus and sensor recovered, retrying measurement");
+            m_retry_count = 0;
+            transitionTo(SystemState::MEASURE);
+            return;
+        }
+    }
     
-    // Attempt recovery
-    vTaskDelay(pdMS_TO_TICKS(5000));
+    // Attempt recovery after the back-off (blocked, like any other wait)
+    m_error_backoff = true;
+    waitFor(ERROR_BACKOFF_MS, SystemEvent::TIMEOUT);
+}
+
+bool StateMachine::startRadio() {
+    if (m_radio_started) {
+        return true;
+    }
+    TRACE_SCOPE(TracePoint::RADIO_START);
     
-    // Reset retry counter
-    m_retry_count = 0;
+    // Initialize BLE Mesh
+    BLEMeshConfig mesh_config;
+    mesh_config.company_id = 0x02E5;  // Espressif
+    mesh_config.product_id = 0x0001;  // GreenIoT Sensor Node
+    mesh_config.prov_method = ProvisioningMethod::PB_ADV;
+    mesh_config.enable_lpn = true;    // Low power node for battery operation
     
-    // Try reinitializing
-    if (m_sensor) {
-        m_sensor->reset();
+    if (BLEMeshManager::getInstance().init(mesh_config) != BLEMeshStatus::OK) {
+        ESP_LOGE(TAG, "BLE Mesh init failed");
+        return false;
     }
     
-    transitionTo(SystemState::IDLE);
+    BLEMeshManager::getInstance().setPublishCallback(onPublishDone, this);
+    
+    // Enable provisioning if not already provisioned
+    if (!BLEMeshManager::getInstance().isProvisioned()) {
+        if (BLEMeshManager::getInstance().enableProvisioning() != BLEMeshStatus::OK) {
+            ESP_LOGE(TAG, "Failed to enable provisioning");
+            return false;
+        }
+    }
+    
+    m_radio_started = true;
+    return true;
+}
+
+bool StateMachine::batchDueAt(uint8_t readings) const {
+    // Due at its configured size, and always before the ring drops readings
+    return readings >= MEASUREMENT_BATCH_CAPACITY ||
+           (m_config.batch_size > 0 && readings >= m_config.batch_size);
+}
+
+template <typename Sensor>
+PipelineStatus StateMachine::acquire(Sensor& sensor) {
+    // Burst -> range check -> alert check, in place on m_sample
+    MeasurementPipeline pipeline(AcquireStage<Sensor>(sensor),
+                                 RangeCheckStage(sensor.getInfo()),
+                                 AlertCheckStage(BASIL_ALERT_LIMITS));
+    return pipeline.run(m_sample);
+}
+
+void StateMachine::armAlertWake() {
+    if (!m_config.enable_alert_wake) {
+        return;
+    }
+    
+    // The sensor monitors the window itself while the MCU sleeps; without
+    // limit support only the timer wakes the node
+    bool armed = m_sensor && m_sensor->armAlert(BASIL_ALERT_LIMITS) == SensorStatus::OK;
+    if (!armed) {
+        ESP_LOGW(TAG, "Sensor alert not available, timer wake only");
+    }
+    PowerManager::getInstance().armSensorAlertWake(armed);
+}
+
+void StateMachine::startAlertWatch() {
+    if (m_alert_watch || !m_config.enable_alert_wake || !m_sensor) {
+        return;
+    }
+    
+    // Sensor compares every periodic sample with the window; ALERT wakes the
+    // task (and the chip from light sleep)
+    if (m_sensor->armAlert(BASIL_ALERT_LIMITS) == SensorStatus::OK) {
+        m_alert_watch = true;
+        PowerManager::getInstance().enableSensorAlertInterrupt(true);
+    }
+}
+
+void StateMachine::stopAlertWatch() {
+    if (!m_alert_watch) {
+        return;
+    }
+    
+    PowerManager::getInstance().enableSensorAlertInterrupt(false);
+    m_sensor->disarmAlert();
+    m_alert_watch = false;
+}
+
+void StateMachine::waitFor(uint32_t duration_ms, SystemEvent event) {
+    m_wait_until_us = esp_timer_get_time() + static_cast<int64_t>(duration_ms) * 1000;
+    m_wait_event = event;
+}
+
+TickType_t StateMachine::waitTicks() const {
+    if (m_wait_until_us == 0) {
+        return portMAX_DELAY;  // Nothing armed: only an event ends the wait
+    }
+    
+    // Rounded up: waking late is inside the window, waking early finds nothing due
+    int64_t remaining_us = m_wait_until_us - esp_timer_get_time();
+    if (remaining_us <= 0) {
+        return 0;
+    }
+    uint64_t ticks = (static_cast<uint64_t>(remaining_us) * configTICK_RATE_HZ + 999999) / 1000000;
+    return (ticks < portMAX_DELAY) ? static_cast<TickType_t>(ticks) : portMAX_DELAY - 1;
 }
 
 void StateMachine::transitionTo(SystemState new_state) {
     if (new_state != m_current_state) {
         ESP_LOGD(TAG, "State transition: %d -> %d", 
                  static_cast<int>(m_current_state), static_cast<int>(new_state));
+        TRACE_END(stateTracePoint(m_current_state));
+        TRACE_BEGIN(stateTracePoint(new_state));
         m_previous_state = m_current_state;
         m_current_state = new_state;
+        m_wait_until_us = 0;  // A wait belongs to the state that armed it
+        post(SystemEvent::ENTER);
+    }
+}
+
+bool StateMachine::setupSchedule() {
+    // One entry per sensor (group members keep their own periods), then the transmission
+    uint32_t slack_ms = m_config.schedule_slack_sec * 1000;
+    m_scheduler.clear();
+    if (m_sensor == &m_group) {
+        m_sensor_entries = m_group.size();
+        for (uint8_t i = 0; i < m_group.size(); i++) {
+            uint32_t period_sec = (i > 0 && m_config.extra_sensor_interval_sec[i - 1] != 0)
+                                      ? m_config.extra_sensor_interval_sec[i - 1]
+                                      : m_config.measurement_interval_sec;
+            m_scheduler.add(m_group.member(i)->getInfo().name, period_sec * 1000, slack_ms);
+        }
+    } else {
+        m_sensor_entries = 1;
+        m_scheduler.add(m_sensor->getInfo().name, m_config.measurement_interval_sec * 1000, slack_ms);
     }
+    m_scheduler.add("transmit", m_config.transmission_interval_sec * 1000, slack_ms);
+    
+    uint64_t now_ms = getClockMs();
+    if (m_scheduler.start(now_ms)) {
+        return true;
+    }
+    
+    uint32_t uncoalesced = 0;
+    uint32_t planned = m_scheduler.plannedWakes(now_ms, 24ULL * 3600 * 1000, &uncoalesced);
+    ESP_LOGI(TAG, "Schedule: %u wakes/day (%u without coalescing)",
+             (unsigned int)planned, (unsigned int)uncoalesced);
+    return false;
+}
+
+uint64_t StateMachine::nextWakeMs(uint64_t now_ms) const {
+    // No schedule yet (INIT failed before setting it up): one measurement interval
+    uint64_t next_ms = m_scheduler.nextWakeMs();
+    if (next_ms == UINT64_MAX) {
+        return now_ms + m_config.measurement_interval_sec * 1000ULL;
+    }
+    return (next_ms > now_ms) ? next_ms : now_ms;
 }
 
 uint32_t StateMachine::getUptime() const {
     return static_cast<uint32_t>(esp_timer_get_time() / 1000);  // milliseconds
 }
 
+uint64_t StateMachine::getClockMs() const {
+    // RTC counter, kept through deep sleep; esp_timer restarts at boot
+    return m_timebase.nowUs(PowerManager::getInstance().slowClockTicks()) / 1000;
+}
+
@@ -23,11 +23,12 @@
 #include <Arduino.h>
 #include "StateMachine.hpp"
 #include "PowerManager.hpp"
+#include "WakeTrace.hpp"
 #include "esp_log.h"
 #include "esp_sleep.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "nvs_flash.h"
+#include <sys/time.h>
 
 static const char* TAG = "MAIN";
 
@@ -36,49 +37,55 @@ static StateMachine* g_state_machine = nullptr;
 
 void setup() {
     Serial.begin(115200);
-    delay(1000);  // Allow serial monitor to connect
     
-    ESP_LOGI(TAG, "========================================");
-    ESP_LOGI(TAG, "  GreenIoT Vertical Farming Node");
-    ESP_LOGI(TAG, "  Basil Environmental Monitoring");
-    ESP_LOGI(TAG, "  Hardware: ESP32-C3");
-    ESP_LOGI(TAG, "  Firmware Version: 1.0.0");
-    ESP_LOGI(TAG, "  Issue #4: Deep Sleep & Wake-up");
-    ESP_LOGI(TAG, "========================================");
+#ifdef WAKE_TRACE_ENABLE
+    // Open this wake's trace cycle (prints the kept ring when it is nearly full)
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    TRACE_START_CYCLE(static_cast<uint64_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000);
+#endif
+    TRACE_BEGIN(TracePoint::SETUP);
     
     // Check wake-up cause (before PowerManager init)
     esp_sleep_wakeup_cause_t wakeup_cause = esp_sleep_get_wakeup_cause();
     if (wakeup_cause == ESP_SLEEP_WAKEUP_UNDEFINED) {
+        delay(1000);  // Allow serial monitor to connect
+        
+        ESP_LOGI(TAG, "========================================");
+        ESP_LOGI(TAG, "  GreenIoT Vertical Farming Node");
+        ESP_LOGI(TAG, "  Basil Environmental Monitoring");
+        ESP_LOGI(TAG, "  Hardware: ESP32-C3");
+        ESP_LOGI(TAG, "  Firmware Version: 1.0.0");
+        ESP_LOGI(TAG, "  Issue #4: Deep Sleep & Wake-up");
+        ESP_LOGI(TAG, "========================================");
         ESP_LOGI(TAG, "First boot or power-on reset");
     } else {
-        ESP_LOGI(TAG, "Wake-up from deep sleep");
-        ESP_LOGI(TAG, "  Cause: %s", 
+        // Deep sleep wake: every millisecond here is awake time, no banner
+        ESP_LOGI(TAG, "Wake-up from deep sleep (%s)",
                  wakeup_cause == ESP_SLEEP_WAKEUP_TIMER ? "Timer" :
                  wakeup_cause == ESP_SLEEP_WAKEUP_EXT0 ? "External GPIO (EXT0)" :
                  wakeup_cause == ESP_SLEEP_WAKEUP_EXT1 ? "External GPIO (EXT1)" :
+                 wakeup_cause == ESP_SLEEP_WAKEUP_GPIO ? "GPIO" :
                  "Unknown");
     }
     
-    // Initialize NVS (Non-Volatile Storage)
-    esp_err_t ret = nvs_flash_init();
-    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
-        ESP_LOGW(TAG, "Erasing NVS...");
-        ESP_ERROR_CHECK(nvs_flash_erase());
-        ret = nvs_flash_init();
-    }
-    ESP_ERROR_CHECK(ret);
-    
-    // Create state machine
-    g_state_machine = new StateMachine();
+    // Create state machine (static storage: no heap allocation at boot)
+    static StateMachine state_machine;
+    g_state_machine = &state_machine;
     
     // Configure system
     SystemConfig config;
     config.measurement_interval_sec = 300;    // Measure every 5 minutes (deep sleep interval)
-    config.transmission_interval_sec = 300;  // Transmit every 5 minutes
+    config.transmission_interval_sec = 1800;  // Radio up every 30 minutes at most...
+    config.batch_size = 6;                    // ...or once 6 readings are kept (one session)
     config.max_retries = 3;
     config.sensor_type = "SHT31";
+    // config.extra_sensor_types[0] = "AHT20";  // Second sensor on the bus (redundancy)
+    // config.extra_sensor_interval_sec[0] = 900;  // ...sampled every 15 minutes
+    config.schedule_slack_sec = 30;           // Acquisitions may run 30 s early to share a wake
     
-    // Initialize state machine
+    // Initialize state machine (its INIT state span starts here)
+    TRACE_END(TracePoint::SETUP);
     g_state_machine->init(config);
     
     ESP_LOGI(TAG, "Entering main loop...");
@@ -88,10 +95,9 @@ void setup() {
 
 void loop() {
     if (g_state_machine) {
+        // Blocks until the next event: no polling, so tickless idle and
+        // automatic light sleep can engage between events
         g_state_machine->run();
-        
-        // Small yield to watchdog/scheduler
-        delay(10);
     } else {
         ESP_LOGE(TAG, "State machine not initialized!");
         delay(1000);
@@ -0,0 +1,49 @@
+/**
+ * @file EspI2CBackend.hpp
+ * @brief ESP-IDF I2C master backend (Singleton pattern)
+ * 
+ * Architecture Layer: PERIPHERAL DRIVER LAYER
+ * Used by: I2CDriver (default backend on target)
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifndef ESP_I2C_BACKEND_HPP
+#define ESP_I2C_BACKEND_HPP
+
+#include "II2CBackend.hpp"
+
+class EspI2CBackend : public II2CBackend {
+public:
+    static EspI2CBackend& getInstance();
+    
+    EspI2CBackend(const EspI2CBackend&) = delete;
+    EspI2CBackend& operator=(const EspI2CBackend&) = delete;
+    
+    I2CStatus install(const I2CConfig& config, uint32_t frequency_hz) override;
+    void uninstall() override;
+    I2CStatus setClock(uint32_t frequency_hz) override;
+    I2CStatus transfer(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                       uint8_t* read_data, uint16_t read_len, uint32_t timeout_ms) override;
+    bool isSdaStuckLow() override;
+    bool clearBus() override;
+    
+    uint32_t staticLinkBuilds() const override { return m_static_link_builds; }
+    uint32_t heapLinkAllocs() const override { return m_heap_link_allocs; }
+    
+private:
+    EspI2CBackend()
+        : m_sda_pin(8)
+        , m_scl_pin(9)
+        , m_static_link_builds(0)
+        , m_heap_link_allocs(0) {}
+    ~EspI2CBackend() = default;
+    
+    uint8_t m_sda_pin;
+    uint8_t m_scl_pin;
+    uint32_t m_static_link_builds;
+    uint32_t m_heap_link_allocs;
+};
+
+#endif // ESP_I2C_BACKEND_HPP
@@ -12,34 +12,194 @@
 #ifndef I2C_DRIVER_HPP
 #define I2C_DRIVER_HPP
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "I2CStats.hpp"
+#include "I2CTypes.hpp"
+#include "II2CBackend.hpp"
 
-enum class I2CStatus {
-    OK = 0,
-    ERROR_INIT,
-    ERROR_NACK_ADDR,
-    ERROR_NACK_DATA,
-    ERROR_TIMEOUT,
-    ERROR_BUS_BUSY,
-    ERROR_INVALID_PARAM
+/**
+ * @brief Device kinds recorded in the topology cache
+ */
+enum class I2CDeviceType : uint8_t {
+    UNKNOWN = 0,
+    SHT3X,
+    AHT2X
+};
+
+/**
+ * @brief One discovered device (persisted across deep sleep)
+ */
+struct I2CTopologyEntry {
+    uint8_t address;
+    I2CDeviceType type;
+    I2CSpeed speed;  // Last working clock profile
+};
+
+#define I2C_MAX_TOPOLOGY_ENTRIES 8
+
+/**
+ * @brief Driver-level transaction counters
+ * 
+ * Command links are built in a preallocated static buffer; heap_link_allocs
+ * only increases if a link ever outgrows that buffer, so it must stay at 0
+ * on the measurement path. bus_busy_us is the time spent in backend
+ * transfers and shrinks with the clock profile in use.
+ */
+struct I2CDriverStats {
+    uint32_t transactions;        // Command links executed
+    uint32_t static_link_builds;  // Links built in the static buffer
+    uint32_t heap_link_allocs;    // Links that fell back to i2c_cmd_link_create()
+    uint32_t bus_busy_us;         // Bus-occupied time (command execution only)
+    uint32_t clock_switches;      // SCL reprogrammed between devices
+    uint32_t speed_fallbacks;     // Profiles stepped down after failures
+    uint32_t bus_recoveries;      // Clock-pulse recoveries + driver reinstalls
+    
+    I2CDriverStats()
+        : transactions(0)
+        , static_link_builds(0)
+        , heap_link_allocs(0)
+        , bus_busy_us(0)
+        , clock_switches(0)
+        , speed_fallbacks(0)
+        , bus_recoveries(0) {}
+};
+
+/**
+ * @brief Batch step types
+ */
+enum class I2COpType {
+    WRITE,
+    READ,
+    WRITE_READ,   // Write then read with repeated start
+    DELAY_UNTIL,  // Hold the bus until an offset from batch start
+    READ_POLL     // Read, retrying NACKs (data not ready) until an offset from batch start
 };
 
-struct I2CConfig {
-    uint8_t sda_pin;
-    uint8_t scl_pin;
-    uint32_t frequency_hz;
-    uint32_t timeout_ms;
-    
-    I2CConfig()
-        : sda_pin(8)
-        , scl_pin(9)
-        , frequency_hz(100000)
-        , timeout_ms(100) {}
+/**
+ * @brief One step of a batched acquisition
+ * 
+ * A batch describes a whole acquisition (e.g. command, conversion wait,
+ * fetch) across one or more devices; it runs inside a single bus-ownership
+ * window and reports one result per step.
+ */
+struct I2COp {
+    I2COpType type;
+    uint8_t device_addr;
+    const uint8_t* write_data;
+    uint16_t write_len;
+    uint8_t* read_data;
+    uint16_t read_len;
+    uint32_t delay_until_us;  // DELAY_UNTIL / READ_POLL deadline: offset from batch start
+    uint32_t poll_interval_us;  // READ_POLL: wait between attempts
+    I2CStatus result;         // Filled in by the driver
+    
+    I2COp()
+        : type(I2COpType::WRITE)
+        , device_addr(0)
+        , write_data(nullptr)
+        , write_len(0)
+        , read_data(nullptr)
+        , read_len(0)
+        , delay_until_us(0)
+        , poll_interval_us(0)
+        , result(I2CStatus::OK) {}
+    
+    static I2COp write(uint8_t addr, const uint8_t* data, uint16_t len) {
+        I2COp op;
+        op.type = I2COpType::WRITE;
+        op.device_addr = addr;
+        op.write_data = data;
+        op.write_len = len;
+        return op;
+    }
+    
+    static I2COp read(uint8_t addr, uint8_t* data, uint16_t len) {
+        I2COp op;
+        op.type = I2COpType::READ;
+        op.device_addr = addr;
+        op.read_data = data;
+        op.read_len = len;
+        return op;
+    }
+    
+    static I2COp writeRead(uint8_t addr, const uint8_t* write_data, uint16_t write_len,
+                           uint8_t* read_data, uint16_t read_len) {
+        I2COp op = write(addr, write_data, write_len);
+        op.type = I2COpType::WRITE_READ;
+        op.read_data = read_data;
+        op.read_len = read_len;
+        return op;
+    }
+    
+    static I2COp delayUntil(uint32_t offset_us) {
+        I2COp op;
+        op.type = I2COpType::DELAY_UNTIL;
+        op.delay_until_us = offset_us;
+        return op;
+    }
+    
+    static I2COp readPoll(uint8_t addr, uint8_t* data, uint16_t len,
+                          uint32_t deadline_us, uint32_t interval_us) {
+        I2COp op = read(addr, data, len);
+        op.type = I2COpType::READ_POLL;
+        op.delay_until_us = deadline_us;
+        op.poll_interval_us = interval_us;
+        return op;
+    }
+};
+
+/**
+ * @brief Completion callback for asynchronous transactions
+ * 
+ * Invoked from the I2C worker task, never from an ISR. Keep it short:
+ * store the result and notify the waiting task.
+ */
+typedef void (*I2CCompletionCallback)(I2CStatus status, void* context);
+
+/**
+ * @brief Asynchronous transaction descriptor
+ * 
+ * Same shape as write()/read()/writeRead(): a write phase, a read phase, or
+ * both (repeated start). When ops is set the whole batch runs instead and
+ * the callback reports the batch status. Buffers (and ops) are owned by the
+ * caller and must stay valid until the callback has run.
+ */
+struct I2CTransaction {
+    uint8_t device_addr;
+    const uint8_t* write_data;
+    uint16_t write_len;
+    uint8_t* read_data;
+    uint16_t read_len;
+    uint32_t start_delay_ms;         // Worker waits this long before starting (e.g. conversion time)
+    I2COp* ops;                      // Optional batch (see executeBatch())
+    uint8_t op_count;
+    I2CCompletionCallback callback;  // Optional
+    void* context;
+    
+    I2CTransaction()
+        : device_addr(0)
+        , write_data(nullptr)
+        , write_len(0)
+        , read_data(nullptr)
+        , read_len(0)
+        , start_delay_ms(0)
+        , ops(nullptr)
+        , op_count(0)
+        , callback(nullptr)
+        , context(nullptr) {}
 };
 
 /**
  * @brief I2C Driver (Singleton pattern for single I2C bus)
+ * 
+ * Blocking calls and the asynchronous queue share one bus mutex, so they
+ * can be mixed freely from different tasks.
  */
 class I2CDriver {
 public:
@@ -60,14 +220,217 @@ public:
     bool isDevicePresent(uint8_t device_addr);
     std::vector<uint8_t> scan();
     
+    /**
+     * @brief Read from a device that NACKs until its data is ready
+     * 
+     * Each failed attempt costs one address byte on the bus. NACKs are
+     * expected here, so they never trigger bus recovery or a speed
+     * fallback. The bus is released between attempts.
+     * 
+     * @param timeout_us Give up after this long (ERROR_TIMEOUT)
+     * @param interval_us Wait between attempts
+     * @return OK once the device answered, ERROR_TIMEOUT if it never did
+     */
+    I2CStatus pollRead(uint8_t device_addr, uint8_t* data, uint16_t len,
+                       uint32_t timeout_us, uint32_t interval_us);
+    
+    /**
+     * @brief One write+read attempt to a device that NACKs until its data is ready
+     * 
+     * For fetch commands issued on the caller's own schedule (e.g. SHT31
+     * periodic FETCH_DATA): like a pollRead() attempt, a NACK is returned
+     * as is and never triggers bus recovery or a speed fallback.
+     * 
+     * @return OK, or ERROR_NACK_ADDR / ERROR_NACK_DATA if nothing is ready
+     */
+    I2CStatus pollWriteRead(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                            uint8_t* read_data, uint16_t read_len);
+    
+    /**
+     * @brief Allocation-free bus scan
+     * @param found Buffer receiving responding addresses
+     * @param max_devices Capacity of the buffer
+     * @return Number of addresses written to the buffer
+     */
+    uint8_t scan(uint8_t* found, uint8_t max_devices);
+    
+    /**
+     * @brief Execute a list of heterogeneous steps as one scheduled batch
+     * 
+     * The bus is held for the whole batch, DELAY_UNTIL steps are timed from
+     * the batch start, and every step gets its own result. After a failure
+     * the remaining steps are marked ERROR_ABORTED.
+     * 
+     * @param ops Steps to execute (results written back)
+     * @param count Number of steps
+     * @return OK if every step succeeded, otherwise the first failure
+     */
+    I2CStatus executeBatch(I2COp* ops, uint8_t count);
+    
+    /**
+     * @brief Queue a batch for the worker task (see executeBatch())
+     * @return OK if queued, ERROR_BUS_BUSY if the queue is full
+     */
+    I2CStatus submitBatch(I2COp* ops, uint8_t count, I2CCompletionCallback callback, void* context);
+    
+    /**
+     * @brief Queue a transaction for the driver-owned worker task
+     * 
+     * Returns immediately; the transaction runs in FIFO order and the
+     * completion callback reports its status.
+     * 
+     * @param txn Transaction descriptor (copied into the queue)
+     * @return OK if queued, ERROR_BUS_BUSY if the queue is full
+     */
+    I2CStatus submit(const I2CTransaction& txn);
+    
+    /**
+     * @brief Block until all queued transactions have completed
+     * @param timeout_ms Maximum time to wait
+     * @return true if the queue drained in time
+     */
+    bool waitIdle(uint32_t timeout_ms);
+    
+    /**
+     * @brief Free a wedged bus and reinstall the controller
+     * 
+     * Clocks SCL up to 9 times until a slave holding SDA low releases it,
+     * issues a STOP, then reinstalls the driver at the current clock. Takes
+     * a few milliseconds. Transfers call this automatically (bounded by
+     * I2CConfig::recovery_retries) on a timeout or when SDA is stuck low.
+     * 
+     * @return OK if SDA is released and the driver is reinstalled
+     */
+    I2CStatus recoverBus();
+    
+    /**
+     * @brief Set the clock profile used for one device address
+     * 
+     * The bus clock is switched automatically before each transaction to
+     * that address. If a transfer fails at the elevated clock but succeeds
+     * when retried one step slower, the profile is stepped down for good.
+     * 
+     * @return false if the profile table is full
+     */
+    bool setDeviceSpeed(uint8_t device_addr, I2CSpeed speed);
+    
+    /**
+     * @brief Clock profile currently in effect for an address
+     */
+    I2CSpeed getDeviceSpeed(uint8_t device_addr) const;
+    
+    static uint32_t speedToHz(I2CSpeed speed);
+    
+    /**
+     * @brief Wait until an esp_timer timestamp with sub-tick resolution
+     * 
+     * Sleeps whole ticks and busy-waits only the remainder, so short waits
+     * are not rounded up to the next tick by pdMS_TO_TICKS().
+     * 
+     * @param deadline_us esp_timer_get_time() value to wait for
+     */
+    static void waitUntil(int64_t deadline_us);
+    
+    /**
+     * @brief Look up a device in the RTC topology cache
+     * 
+     * The cache survives deep sleep only; it is discarded after any other
+     * reset or if its CRC does not match. A hit also restores the device's
+     * last working clock profile, so the caller can skip probing.
+     * 
+     * @param type Device kind to look for
+     * @param address Receives the cached address on a hit
+     * @return true on a hit
+     */
+    bool lookupDevice(I2CDeviceType type, uint8_t& address);
+    
+    /**
+     * @brief Record a discovered device (address, type, current profile)
+     */
+    void rememberDevice(uint8_t device_addr, I2CDeviceType type);
+    
+    /**
+     * @brief Drop a device from the cache after a failure, forcing full
+     *        discovery on the next boot
+     */
+    void forgetDevice(uint8_t device_addr);
+    
+    /**
+     * @brief Select the bus backend (call before init())
+     * 
+     * On target init() defaults to EspI2CBackend; native builds must pass a
+     * simulated bus.
+     */
+    void setBackend(II2CBackend* backend);
+    
+    // Statistics
+    I2CDriverStats getStats() const;
+    void resetStats();
+    
+    /**
+     * @brief Per-address latency, error and retry statistics (lock-free)
+     */
+    const I2CStats& getBusStats() const { return m_bus_stats; }
+    
     static const char* statusToString(I2CStatus status);
     
 private:
-    I2CDriver() : m_initialized(false) {}
+    I2CDriver()
+        : m_initialized(false)
+        , m_backend(nullptr)
+        , m_current_hz(0)
+        , m_link_builds_base(0)
+        , m_heap_allocs_base(0)
+        , m_bus_mutex(nullptr)
+        , m_async_queue(nullptr)
+        , m_worker_task(nullptr)
+        , m_async_pending(0) {}
     ~I2CDriver() = default;
     
+    static constexpr uint32_t PROBE_TIMEOUT_MS = 50;
+    
     bool m_initialized;
+    II2CBackend* m_backend;
     I2CConfig m_config;
+    I2CDriverStats m_stats;
+    I2CStats m_bus_stats;
+    uint32_t m_current_hz;  // SCL frequency currently programmed
+    uint32_t m_link_builds_base;  // Backend link counters at last resetStats()
+    uint32_t m_heap_allocs_base;
+    
+    // Bus ownership and asynchronous worker (statically allocated)
+    SemaphoreHandle_t m_bus_mutex;
+    QueueHandle_t m_async_queue;
+    TaskHandle_t m_worker_task;
+    std::atomic<uint32_t> m_async_pending;  // Queued or executing
+    
+    void createWorker();
+    static void workerTask(void* arg);
+    
+    // Single command-link path shared by all public operations
+    I2CStatus transfer(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                       uint8_t* read_data, uint16_t read_len, uint32_t timeout_ms);
+    I2CStatus transferLocked(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                             uint8_t* read_data, uint16_t read_len, uint32_t timeout_ms);
+    I2CStatus executeLink(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                          uint8_t* read_data, uint16_t read_len, uint32_t timeout_ms);
+    I2CStatus pollAttemptLocked(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                                uint8_t* read_data, uint16_t read_len);
+    
+    // Clock profiles
+    I2CDeviceProfile* findProfile(uint8_t device_addr);
+    uint32_t profileHz(I2CSpeed speed) const;
+    bool applyClock(uint32_t frequency_hz);
+    
+    // Bus recovery
+    bool needsRecovery(I2CStatus status) const;
+    I2CStatus recoverBusLocked();
+    
+    // RTC topology cache
+    void loadTopology();
+    void updateTopologySpeed(uint8_t device_addr, I2CSpeed speed);
+    
+    I2CStatus runBatchLocked(I2COp* ops, uint8_t count);
 };
 
 #endif // I2C_DRIVER_HPP
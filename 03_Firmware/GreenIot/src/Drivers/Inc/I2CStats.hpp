@@ -0,0 +1,273 @@
+/**
+ * @file I2CStats.hpp
+ * @brief Per-address I2C transaction statistics (lock-free, header-only)
+ * 
+ * Architecture Layer: PERIPHERAL DRIVER LAYER
+ * Used by: I2CDriver (recording), Application (telemetry), native tests
+ * 
+ * Fixed-size table of per-address counters built from 32-bit atomics only
+ * (64-bit atomics are not lock-free on RV32), so recording is a handful of
+ * relaxed atomic adds and is cheap enough to leave enabled in production.
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifndef I2C_STATS_HPP
+#define I2C_STATS_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#define I2C_STATS_MAX_DEVICES 8
+#define I2C_STATS_HISTOGRAM_BUCKETS 16  // Bucket k: latency in [2^k, 2^(k+1)) us
+
+/**
+ * @brief Outcome of one recorded transaction
+ */
+enum class I2CStatsOutcome : uint8_t {
+    OK = 0,
+    NACK,
+    TIMEOUT,
+    ERROR
+};
+
+/**
+ * @brief Plain copy of one address's counters
+ */
+struct I2CDeviceStatsSnapshot {
+    uint8_t address;
+    uint32_t transactions;
+    uint32_t bytes;         // Payload bytes of successful transactions
+    uint32_t nacks;
+    uint32_t timeouts;
+    uint32_t retries;
+    uint32_t min_us;        // 0 if nothing recorded
+    uint32_t max_us;
+    uint32_t total_us;      // Bus-occupied time
+    uint32_t histogram[I2C_STATS_HISTOGRAM_BUCKETS];
+    
+    uint32_t avgUs() const { return transactions > 0 ? total_us / transactions : 0; }
+};
+
+/**
+ * @brief Lock-free per-address I2C statistics
+ * 
+ * Slots are claimed on first use with a compare-and-swap; addresses beyond
+ * I2C_STATS_MAX_DEVICES are counted in droppedRecords(). reset() must not
+ * race with record().
+ */
+class I2CStats {
+public:
+    I2CStats() : m_dropped(0) {
+        reset();
+    }
+    
+    /**
+     * @brief Record one completed transaction
+     * @param address 7-bit device address (0 is not tracked)
+     * @param latency_us Time the transaction occupied the bus
+     * @param bytes Payload bytes (counted only on success)
+     * @param outcome Transaction result
+     */
+    void record(uint8_t address, uint32_t latency_us, uint16_t bytes, I2CStatsOutcome outcome) {
+        Slot* slot = claim(address);
+        if (slot == nullptr) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        
+        slot->transactions.fetch_add(1, std::memory_order_relaxed);
+        slot->total_us.fetch_add(latency_us, std::memory_order_relaxed);
+        slot->histogram[bucketFor(latency_us)].fetch_add(1, std::memory_order_relaxed);
+        updateMin(slot->min_us, latency_us);
+        updateMax(slot->max_us, latency_us);
+        
+        switch (outcome) {
+            case I2CStatsOutcome::OK:
+                slot->bytes.fetch_add(bytes, std::memory_order_relaxed);
+                break;
+            case I2CStatsOutcome::NACK:
+                slot->nacks.fetch_add(1, std::memory_order_relaxed);
+                break;
+            case I2CStatsOutcome::TIMEOUT:
+                slot->timeouts.fetch_add(1, std::memory_order_relaxed);
+                break;
+            default:
+                break;
+        }
+    }
+    
+    /**
+     * @brief Count a driver-level retry (bus recovery or speed fallback)
+     */
+    void recordRetry(uint8_t address) {
+        Slot* slot = claim(address);
+        if (slot == nullptr) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        slot->retries.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Number of addresses with recorded activity
+     */
+    uint8_t deviceCount() const {
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < I2C_STATS_MAX_DEVICES; i++) {
+            if (m_slots[i].address.load(std::memory_order_acquire) != 0) {
+                count++;
+            }
+        }
+        return count;
+    }
+    
+    /**
+     * @brief Copy the counters of the n-th tracked address
+     * @return false if index is past the last tracked address
+     */
+    bool snapshotAt(uint8_t index, I2CDeviceStatsSnapshot& out) const {
+        uint8_t seen = 0;
+        for (uint8_t i = 0; i < I2C_STATS_MAX_DEVICES; i++) {
+            if (m_slots[i].address.load(std::memory_order_acquire) == 0) continue;
+            if (seen++ == index) {
+                copySlot(m_slots[i], out);
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    /**
+     * @brief Copy the counters of one address
+     * @return false if the address has no recorded activity
+     */
+    bool snapshot(uint8_t address, I2CDeviceStatsSnapshot& out) const {
+        for (uint8_t i = 0; i < I2C_STATS_MAX_DEVICES; i++) {
+            if (address != 0 && m_slots[i].address.load(std::memory_order_acquire) == address) {
+                copySlot(m_slots[i], out);
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    /**
+     * @brief Total bus-occupied time over all addresses
+     */
+    uint32_t busBusyUs() const {
+        uint32_t total = 0;
+        for (uint8_t i = 0; i < I2C_STATS_MAX_DEVICES; i++) {
+            total += m_slots[i].total_us.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+    
+    /**
+     * @brief Bus utilisation over an observation window
+     * @param elapsed_us Length of the window (e.g. uptime since reset())
+     * @return Busy time in parts per thousand
+     */
+    uint32_t utilisationPermille(uint32_t elapsed_us) const {
+        if (elapsed_us == 0) return 0;
+        return static_cast<uint32_t>(static_cast<uint64_t>(busBusyUs()) * 1000 / elapsed_us);
+    }
+    
+    uint32_t droppedRecords() const { return m_dropped.load(std::memory_order_relaxed); }
+    
+    void reset() {
+        for (uint8_t i = 0; i < I2C_STATS_MAX_DEVICES; i++) {
+            Slot& slot = m_slots[i];
+            slot.address.store(0, std::memory_order_relaxed);
+            slot.transactions.store(0, std::memory_order_relaxed);
+            slot.bytes.store(0, std::memory_order_relaxed);
+            slot.nacks.store(0, std::memory_order_relaxed);
+            slot.timeouts.store(0, std::memory_order_relaxed);
+            slot.retries.store(0, std::memory_order_relaxed);
+            slot.min_us.store(UINT32_MAX, std::memory_order_relaxed);
+            slot.max_us.store(0, std::memory_order_relaxed);
+            slot.total_us.store(0, std::memory_order_relaxed);
+            for (uint8_t b = 0; b < I2C_STATS_HISTOGRAM_BUCKETS; b++) {
+                slot.histogram[b].store(0, std::memory_order_relaxed);
+            }
+        }
+        m_dropped.store(0, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Histogram bucket for a latency (floor(log2), clamped)
+     */
+    static uint8_t bucketFor(uint32_t latency_us) {
+        if (latency_us < 2) return 0;
+        uint8_t bucket = static_cast<uint8_t>(31 - __builtin_clz(latency_us));
+        return bucket < I2C_STATS_HISTOGRAM_BUCKETS ? bucket : I2C_STATS_HISTOGRAM_BUCKETS - 1;
+    }
+    
+private:
+    struct Slot {
+        std::atomic<uint8_t> address;  // 0 = free
+        std::atomic<uint32_t> transactions;
+        std::atomic<uint32_t> bytes;
+        std::atomic<uint32_t> nacks;
+        std::atomic<uint32_t> timeouts;
+        std::atomic<uint32_t> retries;
+        std::atomic<uint32_t> min_us;
+        std::atomic<uint32_t> max_us;
+        std::atomic<uint32_t> total_us;
+        std::atomic<uint32_t> histogram[I2C_STATS_HISTOGRAM_BUCKETS];
+    };
+    
+    Slot m_slots[I2C_STATS_MAX_DEVICES];
+    std::atomic<uint32_t> m_dropped;
+    
+    Slot* claim(uint8_t address) {
+        if (address == 0) return nullptr;
+        
+        for (uint8_t i = 0; i < I2C_STATS_MAX_DEVICES; i++) {
+            uint8_t current = m_slots[i].address.load(std::memory_order_acquire);
+            if (current == address) return &m_slots[i];
+            if (current == 0) {
+                uint8_t expected = 0;
+                if (m_slots[i].address.compare_exchange_strong(expected, address,
+                                                               std::memory_order_acq_rel)) {
+                    return &m_slots[i];
+                }
+                if (expected == address) return &m_slots[i];  // Another task claimed it for us
+            }
+        }
+        return nullptr;
+    }
+    
+    static void updateMin(std::atomic<uint32_t>& target, uint32_t value) {
+        uint32_t current = target.load(std::memory_order_relaxed);
+        while (value < current &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+    
+    static void updateMax(std::atomic<uint32_t>& target, uint32_t value) {
+        uint32_t current = target.load(std::memory_order_relaxed);
+        while (value > current &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+    
+    static void copySlot(const Slot& slot, I2CDeviceStatsSnapshot& out) {
+        out.address = slot.address.load(std::memory_order_acquire);
+        out.transactions = slot.transactions.load(std::memory_order_relaxed);
+        out.bytes = slot.bytes.load(std::memory_order_relaxed);
+        out.nacks = slot.nacks.load(std::memory_order_relaxed);
+        out.timeouts = slot.timeouts.load(std::memory_order_relaxed);
+        out.retries = slot.retries.load(std::memory_order_relaxed);
+        uint32_t min_us = slot.min_us.load(std::memory_order_relaxed);
+        out.min_us = (min_us == UINT32_MAX) ? 0 : min_us;
+        out.max_us = slot.max_us.load(std::memory_order_relaxed);
+        out.total_us = slot.total_us.load(std::memory_order_relaxed);
+        for (uint8_t b = 0; b < I2C_STATS_HISTOGRAM_BUCKETS; b++) {
+            out.histogram[b] = slot.histogram[b].load(std::memory_order_relaxed);
+        }
+    }
+};
+
+#endif // I2C_STATS_HPP
@@ -0,0 +1,78 @@
+/**
+ * @file I2CTypes.hpp
+ * @brief I2C status codes, clock profiles and bus configuration
+ * 
+ * Shared by I2CDriver and its bus backends (ESP-IDF and simulated).
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifndef I2C_TYPES_HPP
+#define I2C_TYPES_HPP
+
+#include <cstdint>
+
+enum class I2CStatus {
+    OK = 0,
+    ERROR_INIT,
+    ERROR_NACK_ADDR,
+    ERROR_NACK_DATA,
+    ERROR_TIMEOUT,
+    ERROR_BUS_BUSY,
+    ERROR_INVALID_PARAM,
+    ERROR_ABORTED       // Batch step skipped after an earlier step failed
+};
+
+/**
+ * @brief Bus clock profiles
+ * 
+ * The ESP32-C3 controller tops out at 800 kHz, so FAST_PLUS is clamped to
+ * I2CConfig::max_frequency_hz on this target.
+ */
+enum class I2CSpeed : uint8_t {
+    STANDARD = 0,   // 100 kHz
+    FAST,           // 400 kHz
+    FAST_PLUS       // 1 MHz (clamped to controller limit)
+};
+
+/**
+ * @brief Requested clock profile for one device address
+ */
+struct I2CDeviceProfile {
+    uint8_t address;
+    I2CSpeed speed;
+};
+
+#define I2C_MAX_DEVICE_PROFILES 8
+
+struct I2CConfig {
+    uint8_t sda_pin;
+    uint8_t scl_pin;
+    uint32_t frequency_hz;       // Default clock for addresses without a profile (scan, probes)
+    uint32_t max_frequency_hz;   // Controller limit (ESP32-C3: 800 kHz)
+    uint32_t timeout_ms;
+    uint8_t recovery_retries;    // Bus recoveries + retries per transfer (0 = off)
+    I2CDeviceProfile device_profiles[I2C_MAX_DEVICE_PROFILES];
+    uint8_t device_profile_count;
+    
+    I2CConfig()
+        : sda_pin(8)
+        , scl_pin(9)
+        , frequency_hz(100000)
+        , max_frequency_hz(800000)
+        , timeout_ms(100)
+        , recovery_retries(2)
+        , device_profiles()
+        , device_profile_count(0) {}
+    
+    bool addDeviceProfile(uint8_t address, I2CSpeed speed) {
+        if (device_profile_count >= I2C_MAX_DEVICE_PROFILES) return false;
+        device_profiles[device_profile_count].address = address;
+        device_profiles[device_profile_count].speed = speed;
+        device_profile_count++;
+        return true;
+    }
+};
+
+#endif // I2C_TYPES_HPP
@@ -0,0 +1,72 @@
+/**
+ * @file II2CBackend.hpp
+ * @brief Abstract I2C bus backend (hardware access behind I2CDriver)
+ * 
+ * Architecture Layer: PERIPHERAL DRIVER LAYER
+ * Implementations:
+ * - EspI2CBackend: ESP-IDF I2C master (target)
+ * - SimI2CBus: host-side simulated bus with virtual devices (native tests)
+ * 
+ * I2CDriver owns locking, clock profiles, retries, recovery policy and
+ * statistics; a backend only moves bytes and manipulates the pins.
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifndef II2C_BACKEND_HPP
+#define II2C_BACKEND_HPP
+
+#include <cstdint>
+#include "I2CTypes.hpp"
+
+class II2CBackend {
+public:
+    virtual ~II2CBackend() = default;
+    
+    /**
+     * @brief Configure pins and install the bus master
+     */
+    virtual I2CStatus install(const I2CConfig& config, uint32_t frequency_hz) = 0;
+    
+    /**
+     * @brief Release the bus master (pins become plain GPIOs)
+     */
+    virtual void uninstall() = 0;
+    
+    /**
+     * @brief Reprogram SCL on an installed bus
+     */
+    virtual I2CStatus setClock(uint32_t frequency_hz) = 0;
+    
+    /**
+     * @brief One framed transfer
+     * 
+     * START, [addr+W, write bytes], [repeated START, addr+R, read bytes], STOP.
+     * With both lengths 0 this is an address-only probe.
+     * 
+     * @return OK, ERROR_NACK_ADDR or ERROR_TIMEOUT
+     */
+    virtual I2CStatus transfer(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                               uint8_t* read_data, uint16_t read_len, uint32_t timeout_ms) = 0;
+    
+    /**
+     * @brief True if a slave is holding SDA low
+     */
+    virtual bool isSdaStuckLow() = 0;
+    
+    /**
+     * @brief Clock SCL (up to 9 pulses) until SDA is released, then STOP
+     * 
+     * Called with the bus master uninstalled.
+     * 
+     * @return true if both lines are high afterwards
+     */
+    virtual bool clearBus() = 0;
+    
+    // Command link accounting (backends without command links report 0)
+    virtual uint32_t staticLinkBuilds() const { return 0; }
+    virtual uint32_t heapLinkAllocs() const { return 0; }
+};
+
+#endif // II2C_BACKEND_HPP
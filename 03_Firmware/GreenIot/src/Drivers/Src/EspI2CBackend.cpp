@@ -0,0 +1,194 @@
+/**
+ * @file EspI2CBackend.cpp
+ * @brief ESP-IDF I2C master backend implementation
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#include "EspI2CBackend.hpp"
+#include "driver/gpio.h"
+#include "driver/i2c.h"
+#include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "freertos/FreeRTOS.h"
+
+static const char* TAG = "I2C";
+
+#define I2C_MASTER_NUM I2C_NUM_0
+#define ACK_CHECK_EN 1
+#define ACK_CHECK_DIS 0
+
+// Worst case link is writeRead: START, addr, data, START, addr, read, read_byte, STOP
+#define CMD_LINK_TRANSACTIONS 2
+
+// Bus recovery: 9 clocks at ~100 kHz, then STOP
+#define RECOVERY_CLOCK_PULSES 9
+#define RECOVERY_HALF_PERIOD_US 5
+
+// Preallocated command link storage (no malloc/free per transaction)
+static uint8_t s_cmd_link_buffer[I2C_LINK_RECOMMENDED_SIZE(CMD_LINK_TRANSACTIONS)];
+
+static i2c_config_t busConfig(uint8_t sda_pin, uint8_t scl_pin, uint32_t frequency_hz) {
+    i2c_config_t conf = {};
+    conf.mode = I2C_MODE_MASTER;
+    conf.sda_io_num = static_cast<gpio_num_t>(sda_pin);
+    conf.scl_io_num = static_cast<gpio_num_t>(scl_pin);
+    conf.sda_pullup_en = GPIO_PULLUP_ENABLE;
+    conf.scl_pullup_en = GPIO_PULLUP_ENABLE;
+    conf.master.clk_speed = frequency_hz;
+    conf.clk_flags = 0;
+    return conf;
+}
+
+static esp_err_t buildLink(i2c_cmd_handle_t cmd, uint8_t device_addr,
+                           const uint8_t* write_data, uint16_t write_len,
+                           uint8_t* read_data, uint16_t read_len) {
+    esp_err_t err = i2c_master_start(cmd);
+    
+    // Write phase (an address-only probe has neither write nor read data)
+    if (err == ESP_OK && (write_len > 0 || read_len == 0)) {
+        err = i2c_master_write_byte(cmd, (device_addr << 1) | I2C_MASTER_WRITE, ACK_CHECK_EN);
+        if (err == ESP_OK && write_len > 0) {
+            err = i2c_master_write(cmd, const_cast<uint8_t*>(write_data), write_len, ACK_CHECK_EN);
+        }
+        if (err == ESP_OK && read_len > 0) {
+            err = i2c_master_start(cmd);  // Repeated start
+        }
+    }
+    
+    // Read phase
+    if (err == ESP_OK && read_len > 0) {
+        err = i2c_master_write_byte(cmd, (device_addr << 1) | I2C_MASTER_READ, ACK_CHECK_EN);
+        if (err == ESP_OK && read_len > 1) {
+            err = i2c_master_read(cmd, read_data, read_len - 1, I2C_MASTER_ACK);
+        }
+        if (err == ESP_OK) {
+            err = i2c_master_read_byte(cmd, read_data + read_len - 1, I2C_MASTER_NACK);
+        }
+    }
+    
+    if (err == ESP_OK) {
+        err = i2c_master_stop(cmd);
+    }
+    return err;
+}
+
+EspI2CBackend& EspI2CBackend::getInstance() {
+    static EspI2CBackend instance;
+    return instance;
+}
+
+I2CStatus EspI2CBackend::install(const I2CConfig& config, uint32_t frequency_hz) {
+    m_sda_pin = config.sda_pin;
+    m_scl_pin = config.scl_pin;
+    
+    i2c_config_t conf = busConfig(m_sda_pin, m_scl_pin, frequency_hz);
+    
+    esp_err_t err = i2c_param_config(I2C_MASTER_NUM, &conf);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "I2C param config failed");
+        return I2CStatus::ERROR_INIT;
+    }
+    
+    err = i2c_driver_install(I2C_MASTER_NUM, conf.mode, 0, 0, 0);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "I2C driver install failed");
+        return I2CStatus::ERROR_INIT;
+    }
+    return I2CStatus::OK;
+}
+
+void EspI2CBackend::uninstall() {
+    i2c_driver_delete(I2C_MASTER_NUM);
+}
+
+I2CStatus EspI2CBackend::setClock(uint32_t frequency_hz) {
+    i2c_config_t conf = busConfig(m_sda_pin, m_scl_pin, frequency_hz);
+    if (i2c_param_config(I2C_MASTER_NUM, &conf) != ESP_OK) {
+        return I2CStatus::ERROR_INIT;
+    }
+    return I2CStatus::OK;
+}
+
+I2CStatus EspI2CBackend::transfer(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                                  uint8_t* read_data, uint16_t read_len, uint32_t timeout_ms) {
+    bool heap_link = false;
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(s_cmd_link_buffer, sizeof(s_cmd_link_buffer));
+    esp_err_t ret = (cmd != nullptr) 
+        ? buildLink(cmd, device_addr, write_data, write_len, read_data, read_len)
+        : ESP_ERR_NO_MEM;
+    
+    if (ret == ESP_OK) {
+        m_static_link_builds++;
+    } else {
+        // Link did not fit the static buffer: fall back to the heap (counted)
+        if (cmd != nullptr) {
+            i2c_cmd_link_delete_static(cmd);
+        }
+        ESP_LOGW(TAG, "Static command link exhausted, using heap link");
+        cmd = i2c_cmd_link_create();
+        heap_link = true;
+        m_heap_link_allocs++;
+        ret = (cmd != nullptr)
+            ? buildLink(cmd, device_addr, write_data, write_len, read_data, read_len)
+            : ESP_ERR_NO_MEM;
+    }
+    
+    if (ret == ESP_OK) {
+        ret = i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, pdMS_TO_TICKS(timeout_ms));
+    }
+    
+    if (cmd != nullptr) {
+        if (heap_link) {
+            i2c_cmd_link_delete(cmd);
+        } else {
+            i2c_cmd_link_delete_static(cmd);
+        }
+    }
+    
+    if (ret == ESP_OK) return I2CStatus::OK;
+    if (ret == ESP_ERR_TIMEOUT) return I2CStatus::ERROR_TIMEOUT;
+    return I2CStatus::ERROR_NACK_ADDR;
+}
+
+bool EspI2CBackend::isSdaStuckLow() {
+    return gpio_get_level(static_cast<gpio_num_t>(m_sda_pin)) == 0;
+}
+
+bool EspI2CBackend::clearBus() {
+    gpio_num_t sda = static_cast<gpio_num_t>(m_sda_pin);
+    gpio_num_t scl = static_cast<gpio_num_t>(m_scl_pin);
+    
+    // Drive both lines as open-drain GPIOs
+    gpio_config_t io_conf = {};
+    io_conf.pin_bit_mask = (1ULL << m_sda_pin) | (1ULL << m_scl_pin);
+    io_conf.mode = GPIO_MODE_INPUT_OUTPUT_OD;
+    io_conf.pull_up_en = GPIO_PULLUP_ENABLE;
+    io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
+    io_conf.intr_type = GPIO_INTR_DISABLE;
+    gpio_config(&io_conf);
+    gpio_set_level(sda, 1);
+    gpio_set_level(scl, 1);
+    esp_rom_delay_us(RECOVERY_HALF_PERIOD_US);
+    
+    // Up to 9 clocks let a slave finish the byte it is shifting out
+    for (uint8_t i = 0; i < RECOVERY_CLOCK_PULSES && gpio_get_level(sda) == 0; i++) {
+        gpio_set_level(scl, 0);
+        esp_rom_delay_us(RECOVERY_HALF_PERIOD_US);
+        gpio_set_level(scl, 1);
+        esp_rom_delay_us(RECOVERY_HALF_PERIOD_US);
+    }
+    
+    // STOP: SDA rises while SCL is high
+    gpio_set_level(scl, 0);
+    esp_rom_delay_us(RECOVERY_HALF_PERIOD_US);
+    gpio_set_level(sda, 0);
+    esp_rom_delay_us(RECOVERY_HALF_PERIOD_US);
+    gpio_set_level(scl, 1);
+    esp_rom_delay_us(RECOVERY_HALF_PERIOD_US);
+    gpio_set_level(sda, 1);
+    esp_rom_delay_us(RECOVERY_HALF_PERIOD_US);
+    
+    return gpio_get_level(sda) == 1 && gpio_get_level(scl) == 1;
+}
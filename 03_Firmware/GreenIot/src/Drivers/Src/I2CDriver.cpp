@@ -1,20 +1,62 @@
 /**
  * @file I2CDriver.cpp
- * @brief I2C peripheral driver implementation for ESP-IDF
+ * @brief I2C peripheral driver implementation (backend-independent)
  * 
  * @author GreenIoT Vertical Farming Project
  * @date 2025-11-03
  */
 
 #include "I2CDriver.hpp"
-#include "driver/i2c.h"
+#include "esp_attr.h"
 #include "esp_log.h"
+#include "esp_rom_crc.h"
+#include "esp_rom_sys.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#ifndef NATIVE_BUILD
+#include "EspI2CBackend.hpp"
+#endif
+#include <cstddef>
+#include <cstring>
 
 static const char* TAG = "I2C";
 
-#define I2C_MASTER_NUM I2C_NUM_0
-#define ACK_CHECK_EN 1
-#define ACK_CHECK_DIS 0
+#define MAX_SCAN_RESULTS 126
+
+// Asynchronous worker
+#define I2C_ASYNC_QUEUE_DEPTH 8
+#define I2C_WORKER_STACK_SIZE 3072
+#define I2C_WORKER_PRIORITY 5
+
+// Static storage for the bus mutex, async queue and worker task
+static StaticSemaphore_t s_bus_mutex_storage;
+static StaticQueue_t s_async_queue_storage;
+static uint8_t s_async_queue_buffer[I2C_ASYNC_QUEUE_DEPTH * sizeof(I2CTransaction)];
+static StaticTask_t s_worker_tcb;
+static StackType_t s_worker_stack[I2C_WORKER_STACK_SIZE];
+
+// Discovered devices, kept across deep sleep so warm wakes skip probing
+#define TOPOLOGY_MAGIC 0x54504F31  // "TPO1"
+
+struct I2CTopologyCache {
+    uint32_t magic;
+    uint8_t count;
+    uint8_t reserved[3];  // Explicit padding, covered by the CRC
+    I2CTopologyEntry entries[I2C_MAX_TOPOLOGY_ENTRIES];
+    uint32_t crc;
+};
+
+RTC_DATA_ATTR static I2CTopologyCache s_topology;
+
+static uint32_t topologyCrc(const I2CTopologyCache& cache) {
+    return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&cache), 
+                            offsetof(I2CTopologyCache, crc));
+}
+
+static void sealTopology() {
+    s_topology.magic = TOPOLOGY_MAGIC;
+    s_topology.crc = topologyCrc(s_topology);
+}
 
 I2CDriver& I2CDriver::getInstance() {
     static I2CDriver instance;
@@ -23,38 +65,40 @@ I2CDriver& I2CDriver::getInstance() {
 
 I2CStatus I2CDriver::init(const I2CConfig& config) {
     m_config = config;
-    
-    i2c_config_t conf = {};
-    conf.mode = I2C_MODE_MASTER;
-    conf.sda_io_num = static_cast<gpio_num_t>(config.sda_pin);
-    conf.scl_io_num = static_cast<gpio_num_t>(config.scl_pin);
-    conf.sda_pullup_en = GPIO_PULLUP_ENABLE;
-    conf.scl_pullup_en = GPIO_PULLUP_ENABLE;
-    conf.master.clk_speed = config.frequency_hz;
-    conf.clk_flags = 0;
-    
-    esp_err_t err = i2c_param_config(I2C_MASTER_NUM, &conf);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "I2C param config failed");
+    if (m_config.frequency_hz > m_config.max_frequency_hz) {
+        m_config.frequency_hz = m_config.max_frequency_hz;
+    }
+
+#ifndef NATIVE_BUILD
+    if (m_backend == nullptr) {
+        m_backend = &EspI2CBackend::getInstance();
+    }
+#endif
+    if (m_backend == nullptr) {
+        ESP_LOGE(TAG, "No I2C backend");
         return I2CStatus::ERROR_INIT;
     }
     
-    err = i2c_driver_install(I2C_MASTER_NUM, conf.mode, 0, 0, 0);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "I2C driver install failed");
-        return I2CStatus::ERROR_INIT;
+    I2CStatus status = m_backend->install(m_config, m_config.frequency_hz);
+    if (status != I2CStatus::OK) {
+        return status;
     }
     
+    createWorker();
+    loadTopology();
+    
+    m_current_hz = m_config.frequency_hz;
     m_initialized = true;
-    ESP_LOGI(TAG, "I2C initialized (SDA=%d, SCL=%d, %d Hz)", 
-             config.sda_pin, config.scl_pin, (int)config.frequency_hz);
+    ESP_LOGD(TAG, "I2C initialized (SDA=%d, SCL=%d, %d Hz, %d device profiles)", 
+             config.sda_pin, config.scl_pin, (int)m_config.frequency_hz,
+             m_config.device_profile_count);
     return I2CStatus::OK;
 }
 
 I2CStatus I2CDriver::deinit() {
     if (!m_initialized) return I2CStatus::OK;
     
-    i2c_driver_delete(I2C_MASTER_NUM);
+    m_backend->uninstall();
     m_initialized = false;
     return I2CStatus::OK;
 }
@@ -63,42 +107,54 @@ I2CStatus I2CDriver::write(uint8_t device_addr, const uint8_t* data, uint16_t le
     if (!m_initialized) return I2CStatus::ERROR_INIT;
     if (data == nullptr || len == 0) return I2CStatus::ERROR_INVALID_PARAM;
     
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (device_addr << 1) | I2C_MASTER_WRITE, ACK_CHECK_EN);
-    i2c_master_write(cmd, const_cast<uint8_t*>(data), len, ACK_CHECK_EN);
-    i2c_master_stop(cmd);
-    
-    esp_err_t ret = i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, 
-                                         pdMS_TO_TICKS(m_config.timeout_ms));
-    i2c_cmd_link_delete(cmd);
-    
-    if (ret == ESP_OK) return I2CStatus::OK;
-    if (ret == ESP_ERR_TIMEOUT) return I2CStatus::ERROR_TIMEOUT;
-    return I2CStatus::ERROR_NACK_ADDR;
+    return transfer(device_addr, data, len, nullptr, 0, m_config.timeout_ms);
 }
 
 I2CStatus I2CDriver::read(uint8_t device_addr, uint8_t* data, uint16_t len) {
     if (!m_initialized) return I2CStatus::ERROR_INIT;
     if (data == nullptr || len == 0) return I2CStatus::ERROR_INVALID_PARAM;
     
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (device_addr << 1) | I2C_MASTER_READ, ACK_CHECK_EN);
+    return transfer(device_addr, nullptr, 0, data, len, m_config.timeout_ms);
+}
+
+I2CStatus I2CDriver::pollRead(uint8_t device_addr, uint8_t* data, uint16_t len,
+                              uint32_t timeout_us, uint32_t interval_us) {
+    if (!m_initialized) return I2CStatus::ERROR_INIT;
+    if (data == nullptr || len == 0) return I2CStatus::ERROR_INVALID_PARAM;
     
-    if (len > 1) {
-        i2c_master_read(cmd, data, len - 1, I2C_MASTER_ACK);
+    int64_t deadline_us = esp_timer_get_time() + timeout_us;
+    for (;;) {
+        if (xSemaphoreTake(m_bus_mutex, pdMS_TO_TICKS(m_config.timeout_ms)) != pdTRUE) {
+            return I2CStatus::ERROR_BUS_BUSY;
+        }
+        I2CStatus status = pollAttemptLocked(device_addr, nullptr, 0, data, len);
+        xSemaphoreGive(m_bus_mutex);
+        
+        if (status != I2CStatus::ERROR_NACK_ADDR) {
+            return status;
+        }
+        int64_t next_us = esp_timer_get_time() + interval_us;
+        if (next_us > deadline_us) {
+            return I2CStatus::ERROR_TIMEOUT;
+        }
+        waitUntil(next_us);
+    }
+}
+
+I2CStatus I2CDriver::pollWriteRead(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                                  uint8_t* read_data, uint16_t read_len) {
+    if (!m_initialized) return I2CStatus::ERROR_INIT;
+    if (write_data == nullptr || write_len == 0 || read_data == nullptr || read_len == 0) {
+        return I2CStatus::ERROR_INVALID_PARAM;
     }
-    i2c_master_read_byte(cmd, data + len - 1, I2C_MASTER_NACK);
-    i2c_master_stop(cmd);
     
-    esp_err_t ret = i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, 
-                                         pdMS_TO_TICKS(m_config.timeout_ms));
-    i2c_cmd_link_delete(cmd);
+    if (xSemaphoreTake(m_bus_mutex, pdMS_TO_TICKS(m_config.timeout_ms)) != pdTRUE) {
+        return I2CStatus::ERROR_BUS_BUSY;
+    }
+    I2CStatus status = pollAttemptLocked(device_addr, write_data, write_len, read_data, read_len);
+    xSemaphoreGive(m_bus_mutex);
     
-    if (ret == ESP_OK) return I2CStatus::OK;
-    if (ret == ESP_ERR_TIMEOUT) return I2CStatus::ERROR_TIMEOUT;
-    return I2CStatus::ERROR_NACK_ADDR;
+    return status;
 }
 
 I2CStatus I2CDriver::writeRead(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len, 
@@ -108,58 +164,504 @@ I2CStatus I2CDriver::writeRead(uint8_t device_addr, const uint8_t* write_data, u
         return I2CStatus::ERROR_INVALID_PARAM;
     }
     
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    return transfer(device_addr, write_data, write_len, read_data, read_len, m_config.timeout_ms);
+}
+
+bool I2CDriver::isDevicePresent(uint8_t device_addr) {
+    if (!m_initialized) return false;
     
-    // Write phase
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (device_addr << 1) | I2C_MASTER_WRITE, ACK_CHECK_EN);
-    i2c_master_write(cmd, const_cast<uint8_t*>(write_data), write_len, ACK_CHECK_EN);
+    // Address-only write: START, addr+W, STOP
+    return transfer(device_addr, nullptr, 0, nullptr, 0, PROBE_TIMEOUT_MS) == I2CStatus::OK;
+}
+
+std::vector<uint8_t> I2CDriver::scan() {
+    uint8_t found[MAX_SCAN_RESULTS];
+    uint8_t count = scan(found, MAX_SCAN_RESULTS);
+    return std::vector<uint8_t>(found, found + count);
+}
+
+uint8_t I2CDriver::scan(uint8_t* found, uint8_t max_devices) {
+    if (!m_initialized || found == nullptr) return 0;
     
-    // Read phase (repeated start)
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (device_addr << 1) | I2C_MASTER_READ, ACK_CHECK_EN);
+    uint8_t count = 0;
+    for (uint8_t addr = 1; addr < 127 && count < max_devices; addr++) {
+        if (isDevicePresent(addr)) {
+            found[count++] = addr;
+        }
+    }
     
-    if (read_len > 1) {
-        i2c_master_read(cmd, read_data, read_len - 1, I2C_MASTER_ACK);
+    return count;
+}
+
+I2CStatus I2CDriver::executeBatch(I2COp* ops, uint8_t count) {
+    if (!m_initialized) return I2CStatus::ERROR_INIT;
+    if (ops == nullptr || count == 0) return I2CStatus::ERROR_INVALID_PARAM;
+    
+    // One bus-ownership window for the whole batch
+    if (xSemaphoreTake(m_bus_mutex, pdMS_TO_TICKS(m_config.timeout_ms)) != pdTRUE) {
+        return I2CStatus::ERROR_BUS_BUSY;
     }
-    i2c_master_read_byte(cmd, read_data + read_len - 1, I2C_MASTER_NACK);
-    i2c_master_stop(cmd);
+    I2CStatus status = runBatchLocked(ops, count);
+    xSemaphoreGive(m_bus_mutex);
     
-    esp_err_t ret = i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, 
-                                         pdMS_TO_TICKS(m_config.timeout_ms));
-    i2c_cmd_link_delete(cmd);
+    return status;
+}
+
+I2CStatus I2CDriver::submitBatch(I2COp* ops, uint8_t count, 
+                                 I2CCompletionCallback callback, void* context) {
+    if (ops == nullptr || count == 0) return I2CStatus::ERROR_INVALID_PARAM;
     
-    if (ret == ESP_OK) return I2CStatus::OK;
-    if (ret == ESP_ERR_TIMEOUT) return I2CStatus::ERROR_TIMEOUT;
-    return I2CStatus::ERROR_NACK_ADDR;
+    I2CTransaction txn;
+    txn.ops = ops;
+    txn.op_count = count;
+    txn.callback = callback;
+    txn.context = context;
+    return submit(txn);
 }
 
-bool I2CDriver::isDevicePresent(uint8_t device_addr) {
-    if (!m_initialized) return false;
+I2CStatus I2CDriver::submit(const I2CTransaction& txn) {
+    if (!m_initialized) return I2CStatus::ERROR_INIT;
+    if ((txn.write_len > 0 && txn.write_data == nullptr) ||
+        (txn.read_len > 0 && txn.read_data == nullptr) ||
+        (txn.ops != nullptr && txn.op_count == 0)) {
+        return I2CStatus::ERROR_INVALID_PARAM;
+    }
+    
+    m_async_pending++;
+    if (xQueueSend(m_async_queue, &txn, 0) != pdTRUE) {
+        m_async_pending--;
+        ESP_LOGW(TAG, "Async queue full (addr 0x%02X)", txn.device_addr);
+        return I2CStatus::ERROR_BUS_BUSY;
+    }
+    return I2CStatus::OK;
+}
+
+bool I2CDriver::waitIdle(uint32_t timeout_ms) {
+    int64_t deadline = esp_timer_get_time() + static_cast<int64_t>(timeout_ms) * 1000;
     
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (device_addr << 1) | I2C_MASTER_WRITE, ACK_CHECK_EN);
-    i2c_master_stop(cmd);
+    while (m_async_pending > 0) {
+        if (esp_timer_get_time() >= deadline) {
+            return false;
+        }
+        vTaskDelay(1);
+    }
+    return true;
+}
+
+bool I2CDriver::setDeviceSpeed(uint8_t device_addr, I2CSpeed speed) {
+    bool ok = true;
     
-    esp_err_t ret = i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, pdMS_TO_TICKS(50));
-    i2c_cmd_link_delete(cmd);
+    if (m_bus_mutex != nullptr) {
+        xSemaphoreTake(m_bus_mutex, portMAX_DELAY);
+    }
+    I2CDeviceProfile* profile = findProfile(device_addr);
+    if (profile != nullptr) {
+        profile->speed = speed;
+    } else {
+        ok = m_config.addDeviceProfile(device_addr, speed);
+    }
+    if (m_bus_mutex != nullptr) {
+        xSemaphoreGive(m_bus_mutex);
+    }
     
-    return (ret == ESP_OK);
+    if (ok) {
+        ESP_LOGI(TAG, "Device 0x%02X clock profile: %u Hz", device_addr, (unsigned)profileHz(speed));
+    } else {
+        ESP_LOGW(TAG, "Device profile table full (0x%02X)", device_addr);
+    }
+    return ok;
 }
 
-std::vector<uint8_t> I2CDriver::scan() {
-    std::vector<uint8_t> devices;
+I2CSpeed I2CDriver::getDeviceSpeed(uint8_t device_addr) const {
+    for (uint8_t i = 0; i < m_config.device_profile_count; i++) {
+        if (m_config.device_profiles[i].address == device_addr) {
+            return m_config.device_profiles[i].speed;
+        }
+    }
+    return I2CSpeed::STANDARD;
+}
+
+uint32_t I2CDriver::speedToHz(I2CSpeed speed) {
+    switch (speed) {
+        case I2CSpeed::FAST: return 400000;
+        case I2CSpeed::FAST_PLUS: return 1000000;
+        case I2CSpeed::STANDARD:
+        default: return 100000;
+    }
+}
+
+I2CDeviceProfile* I2CDriver::findProfile(uint8_t device_addr) {
+    for (uint8_t i = 0; i < m_config.device_profile_count; i++) {
+        if (m_config.device_profiles[i].address == device_addr) {
+            return &m_config.device_profiles[i];
+        }
+    }
+    return nullptr;
+}
+
+uint32_t I2CDriver::profileHz(I2CSpeed speed) const {
+    uint32_t hz = speedToHz(speed);
+    return (hz > m_config.max_frequency_hz) ? m_config.max_frequency_hz : hz;
+}
+
+bool I2CDriver::applyClock(uint32_t frequency_hz) {
+    if (frequency_hz == m_current_hz) return true;
     
-    if (!m_initialized) return devices;
+    if (m_backend->setClock(frequency_hz) != I2CStatus::OK) {
+        ESP_LOGW(TAG, "Clock switch to %u Hz failed", (unsigned)frequency_hz);
+        return false;
+    }
+    m_current_hz = frequency_hz;
+    m_stats.clock_switches++;
+    return true;
+}
+
+void I2CDriver::setBackend(II2CBackend* backend) {
+    if (m_initialized) {
+        ESP_LOGW(TAG, "Backend must be set before init()");
+        return;
+    }
+    m_backend = backend;
+}
+
+I2CDriverStats I2CDriver::getStats() const {
+    I2CDriverStats stats = m_stats;
+    if (m_backend != nullptr) {
+        stats.static_link_builds = m_backend->staticLinkBuilds() - m_link_builds_base;
+        stats.heap_link_allocs = m_backend->heapLinkAllocs() - m_heap_allocs_base;
+    }
+    return stats;
+}
+
+void I2CDriver::resetStats() {
+    m_stats = I2CDriverStats();
+    m_bus_stats.reset();
+    if (m_backend != nullptr) {
+        m_link_builds_base = m_backend->staticLinkBuilds();
+        m_heap_allocs_base = m_backend->heapLinkAllocs();
+    }
+}
+
+I2CStatus I2CDriver::recoverBus() {
+    if (!m_initialized) return I2CStatus::ERROR_INIT;
     
-    for (uint8_t addr = 1; addr < 127; addr++) {
-        if (isDevicePresent(addr)) {
-            devices.push_back(addr);
+    if (xSemaphoreTake(m_bus_mutex, pdMS_TO_TICKS(m_config.timeout_ms)) != pdTRUE) {
+        return I2CStatus::ERROR_BUS_BUSY;
+    }
+    I2CStatus status = recoverBusLocked();
+    xSemaphoreGive(m_bus_mutex);
+    
+    return status;
+}
+
+bool I2CDriver::needsRecovery(I2CStatus status) const {
+    // A timeout usually leaves the controller FSM wedged; a NACK is only a
+    // bus fault if a slave is still holding SDA low (absent devices also NACK)
+    if (status == I2CStatus::ERROR_TIMEOUT) return true;
+    if (status == I2CStatus::ERROR_NACK_ADDR) {
+        return m_backend->isSdaStuckLow();
+    }
+    return false;
+}
+
+I2CStatus I2CDriver::recoverBusLocked() {
+    m_backend->uninstall();
+    m_stats.bus_recoveries++;
+    
+    bool released = m_backend->clearBus();
+    
+    // Reinstall at the clock the current device was using
+    I2CStatus status = m_backend->install(m_config, m_current_hz);
+    if (status != I2CStatus::OK) {
+        ESP_LOGE(TAG, "Bus recovery: driver reinstall failed");
+        return status;
+    }
+    
+    if (!released) {
+        ESP_LOGE(TAG, "Bus recovery failed: SDA/SCL still held low");
+        return I2CStatus::ERROR_BUS_BUSY;
+    }
+    ESP_LOGW(TAG, "Bus recovered");
+    return I2CStatus::OK;
+}
+
+void I2CDriver::loadTopology() {
+    bool warm = esp_reset_reason() == ESP_RST_DEEPSLEEP;
+    bool valid = s_topology.magic == TOPOLOGY_MAGIC &&
+                 s_topology.count <= I2C_MAX_TOPOLOGY_ENTRIES &&
+                 s_topology.crc == topologyCrc(s_topology);
+    
+    if (!warm || !valid) {
+        // Power-on or other reset, or corrupted RTC memory: full discovery
+        memset(&s_topology, 0, sizeof(s_topology));
+        sealTopology();
+        ESP_LOGI(TAG, "Topology cache %s, full discovery", warm ? "invalid" : "cleared");
+        return;
+    }
+    ESP_LOGD(TAG, "Topology cache: %d device(s)", s_topology.count);
+}
+
+bool I2CDriver::lookupDevice(I2CDeviceType type, uint8_t& address) {
+    for (uint8_t i = 0; i < s_topology.count; i++) {
+        const I2CTopologyEntry& entry = s_topology.entries[i];
+        if (entry.type == type) {
+            address = entry.address;
+            setDeviceSpeed(entry.address, entry.speed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void I2CDriver::rememberDevice(uint8_t device_addr, I2CDeviceType type) {
+    I2CSpeed speed = getDeviceSpeed(device_addr);
+    
+    for (uint8_t i = 0; i < s_topology.count; i++) {
+        if (s_topology.entries[i].address == device_addr) {
+            s_topology.entries[i].type = type;
+            s_topology.entries[i].speed = speed;
+            sealTopology();
+            return;
+        }
+    }
+    
+    if (s_topology.count >= I2C_MAX_TOPOLOGY_ENTRIES) {
+        ESP_LOGW(TAG, "Topology cache full (0x%02X)", device_addr);
+        return;
+    }
+    I2CTopologyEntry& entry = s_topology.entries[s_topology.count++];
+    entry.address = device_addr;
+    entry.type = type;
+    entry.speed = speed;
+    sealTopology();
+}
+
+void I2CDriver::forgetDevice(uint8_t device_addr) {
+    for (uint8_t i = 0; i < s_topology.count; i++) {
+        if (s_topology.entries[i].address == device_addr) {
+            s_topology.entries[i] = s_topology.entries[--s_topology.count];
+            sealTopology();
+            ESP_LOGW(TAG, "Device 0x%02X dropped from topology cache", device_addr);
+            return;
+        }
+    }
+}
+
+void I2CDriver::updateTopologySpeed(uint8_t device_addr, I2CSpeed speed) {
+    for (uint8_t i = 0; i < s_topology.count; i++) {
+        if (s_topology.entries[i].address == device_addr) {
+            s_topology.entries[i].speed = speed;
+            sealTopology();
+            return;
+        }
+    }
+}
+
+void I2CDriver::createWorker() {
+    if (m_worker_task != nullptr) return;  // Survives deinit()/init() cycles
+    
+    m_bus_mutex = xSemaphoreCreateMutexStatic(&s_bus_mutex_storage);
+    m_async_queue = xQueueCreateStatic(I2C_ASYNC_QUEUE_DEPTH, sizeof(I2CTransaction),
+                                       s_async_queue_buffer, &s_async_queue_storage);
+    m_worker_task = xTaskCreateStatic(workerTask, "i2c_worker", I2C_WORKER_STACK_SIZE, this,
+                                      I2C_WORKER_PRIORITY, s_worker_stack, &s_worker_tcb);
+}
+
+void I2CDriver::workerTask(void* arg) {
+    I2CDriver* self = static_cast<I2CDriver*>(arg);
+    I2CTransaction txn;
+    
+    for (;;) {
+        if (xQueueReceive(self->m_async_queue, &txn, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        
+        if (txn.start_delay_ms > 0) {
+            vTaskDelay(pdMS_TO_TICKS(txn.start_delay_ms));
+        }
+        
+        I2CStatus status;
+        if (!self->m_initialized) {
+            status = I2CStatus::ERROR_INIT;
+        } else if (txn.ops != nullptr) {
+            status = self->executeBatch(txn.ops, txn.op_count);
+        } else {
+            status = self->transfer(txn.device_addr, txn.write_data, txn.write_len,
+                                    txn.read_data, txn.read_len, self->m_config.timeout_ms);
+        }
+        
+        if (txn.callback != nullptr) {
+            txn.callback(status, txn.context);
+        }
+        self->m_async_pending--;
+    }
+}
+
+I2CStatus I2CDriver::runBatchLocked(I2COp* ops, uint8_t count) {
+    int64_t batch_start_us = esp_timer_get_time();
+    I2CStatus first_error = I2CStatus::OK;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        I2COp& op = ops[i];
+        
+        if (first_error != I2CStatus::OK) {
+            op.result = I2CStatus::ERROR_ABORTED;
+            continue;
+        }
+        
+        switch (op.type) {
+            case I2COpType::WRITE:
+                op.result = (op.write_data == nullptr || op.write_len == 0)
+                    ? I2CStatus::ERROR_INVALID_PARAM
+                    : transferLocked(op.device_addr, op.write_data, op.write_len,
+                                     nullptr, 0, m_config.timeout_ms);
+                break;
+            case I2COpType::READ:
+                op.result = (op.read_data == nullptr || op.read_len == 0)
+                    ? I2CStatus::ERROR_INVALID_PARAM
+                    : transferLocked(op.device_addr, nullptr, 0,
+                                     op.read_data, op.read_len, m_config.timeout_ms);
+                break;
+            case I2COpType::WRITE_READ:
+                op.result = (op.write_data == nullptr || op.write_len == 0 ||
+                             op.read_data == nullptr || op.read_len == 0)
+                    ? I2CStatus::ERROR_INVALID_PARAM
+                    : transferLocked(op.device_addr, op.write_data, op.write_len,
+                                     op.read_data, op.read_len, m_config.timeout_ms);
+                break;
+            case I2COpType::DELAY_UNTIL:
+                waitUntil(batch_start_us + op.delay_until_us);
+                op.result = I2CStatus::OK;
+                break;
+            case I2COpType::READ_POLL: {
+                if (op.read_data == nullptr || op.read_len == 0) {
+                    op.result = I2CStatus::ERROR_INVALID_PARAM;
+                    break;
+                }
+                // The bus stays held between attempts, like DELAY_UNTIL
+                int64_t deadline_us = batch_start_us + op.delay_until_us;
+                for (;;) {
+                    op.result = pollAttemptLocked(op.device_addr, nullptr, 0, op.read_data, op.read_len);
+                    if (op.result != I2CStatus::ERROR_NACK_ADDR) break;
+                    
+                    int64_t next_us = esp_timer_get_time() + op.poll_interval_us;
+                    if (next_us > deadline_us) {
+                        op.result = I2CStatus::ERROR_TIMEOUT;
+                        break;
+                    }
+                    waitUntil(next_us);
+                }
+                break;
+            }
+            default:
+                op.result = I2CStatus::ERROR_INVALID_PARAM;
+                break;
+        }
+        
+        if (op.result != I2CStatus::OK) {
+            first_error = op.result;
+        }
+    }
+    
+    return first_error;
+}
+
+I2CStatus I2CDriver::transfer(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                              uint8_t* read_data, uint16_t read_len, uint32_t timeout_ms) {
+    // Blocking callers and the worker share the bus (and the backend's link buffer)
+    if (xSemaphoreTake(m_bus_mutex, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        return I2CStatus::ERROR_BUS_BUSY;
+    }
+    I2CStatus status = transferLocked(device_addr, write_data, write_len, 
+                                      read_data, read_len, timeout_ms);
+    xSemaphoreGive(m_bus_mutex);
+    
+    return status;
+}
+
+I2CStatus I2CDriver::transferLocked(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                                    uint8_t* read_data, uint16_t read_len, uint32_t timeout_ms) {
+    // Addresses without a profile (scan, probes) run at the default clock
+    I2CDeviceProfile* profile = findProfile(device_addr);
+    applyClock(profile != nullptr ? profileHz(profile->speed) : m_config.frequency_hz);
+    
+    I2CStatus status = executeLink(device_addr, write_data, write_len, read_data, read_len, timeout_ms);
+    
+    // Wedged bus: recover and retry transparently, within the configured budget
+    for (uint8_t attempt = 0; attempt < m_config.recovery_retries && needsRecovery(status); attempt++) {
+        if (recoverBusLocked() != I2CStatus::OK) {
+            break;
+        }
+        m_bus_stats.recordRetry(device_addr);
+        status = executeLink(device_addr, write_data, write_len, read_data, read_len, timeout_ms);
+    }
+    
+    // A failure at an elevated clock may be the device or cable, not the
+    // address: retry one step slower and keep that profile if it works
+    if ((status == I2CStatus::ERROR_NACK_ADDR || status == I2CStatus::ERROR_TIMEOUT) &&
+        profile != nullptr && profile->speed != I2CSpeed::STANDARD) {
+        I2CSpeed slower = static_cast<I2CSpeed>(static_cast<uint8_t>(profile->speed) - 1);
+        if (profileHz(slower) < m_current_hz && applyClock(profileHz(slower))) {
+            m_bus_stats.recordRetry(device_addr);
+            status = executeLink(device_addr, write_data, write_len, read_data, read_len, timeout_ms);
+            if (status == I2CStatus::OK) {
+                ESP_LOGW(TAG, "Device 0x%02X failed at elevated clock, falling back to %u Hz",
+                         device_addr, (unsigned)m_current_hz);
+                profile->speed = slower;
+                m_stats.speed_fallbacks++;
+                updateTopologySpeed(device_addr, slower);
+            }
         }
     }
     
-    return devices;
+    return status;
+}
+
+I2CStatus I2CDriver::pollAttemptLocked(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                                       uint8_t* read_data, uint16_t read_len) {
+    // A NACK only means "not ready": no recovery, no speed fallback
+    I2CDeviceProfile* profile = findProfile(device_addr);
+    applyClock(profile != nullptr ? profileHz(profile->speed) : m_config.frequency_hz);
+    
+    return executeLink(device_addr, write_data, write_len, read_data, read_len, m_config.timeout_ms);
+}
+
+void I2CDriver::waitUntil(int64_t deadline_us) {
+    const int64_t tick_us = static_cast<int64_t>(portTICK_PERIOD_MS) * 1000;
+    
+    // vTaskDelay(n) may return up to one tick early, so sleep one tick short
+    int64_t remaining_us = deadline_us - esp_timer_get_time();
+    if (remaining_us >= 2 * tick_us) {
+        vTaskDelay(static_cast<TickType_t>(remaining_us / tick_us - 1));
+    }
+    
+    remaining_us = deadline_us - esp_timer_get_time();
+    if (remaining_us > 0) {
+        esp_rom_delay_us(static_cast<uint32_t>(remaining_us));
+    }
+}
+
+I2CStatus I2CDriver::executeLink(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                                 uint8_t* read_data, uint16_t read_len, uint32_t timeout_ms) {
+    int64_t start_us = esp_timer_get_time();
+    I2CStatus status = m_backend->transfer(device_addr, write_data, write_len, 
+                                           read_data, read_len, timeout_ms);
+    uint32_t latency_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+    
+    m_stats.bus_busy_us += latency_us;
+    m_stats.transactions++;
+    
+    I2CStatsOutcome outcome;
+    switch (status) {
+        case I2CStatus::OK: outcome = I2CStatsOutcome::OK; break;
+        case I2CStatus::ERROR_NACK_ADDR:
+        case I2CStatus::ERROR_NACK_DATA: outcome = I2CStatsOutcome::NACK; break;
+        case I2CStatus::ERROR_TIMEOUT: outcome = I2CStatsOutcome::TIMEOUT; break;
+        default: outcome = I2CStatsOutcome::ERROR; break;
+    }
+    m_bus_stats.record(device_addr, latency_us, write_len + read_len, outcome);
+    
+    return status;
 }
 
 const char* I2CDriver::statusToString(I2CStatus status) {
@@ -171,6 +673,7 @@ const char* I2CDriver::statusToString(I2CStatus status) {
         case I2CStatus::ERROR_TIMEOUT: return "Timeout";
         case I2CStatus::ERROR_BUS_BUSY: return "Bus Busy";
         case I2CStatus::ERROR_INVALID_PARAM: return "Invalid Parameter";
+        case I2CStatus::ERROR_ABORTED: return "Aborted";
         default: return "Unknown Error";
     }
 }
@@ -0,0 +1,87 @@
+/**
+ * @file AHT20Sensor.hpp
+ * @brief AHT20 sensor driver (Aosong) - C++ implementation
+ * 
+ * Implements ISensor interface for AHT20 temperature & humidity sensor
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#ifndef AHT20_SENSOR_HPP
+#define AHT20_SENSOR_HPP
+
+#include "ISensor.hpp"
+#include "I2CDriver.hpp"
+#include <cstdint>
+
+/**
+ * @brief AHT20 sensor driver class
+ * 
+ * Single-shot only (no periodic mode, heater or alert output). The sensor
+ * acknowledges while converting and reports progress in its status byte,
+ * so readiness is polled on the busy bit rather than on a NACK.
+ */
+class AHT20Sensor final : public ISensor {
+public:
+    AHT20Sensor();
+    ~AHT20Sensor() override;
+    
+    // ISensor interface implementation
+    SensorStatus init() override;
+    SensorStatus deinit() override;
+    SensorStatus triggerMeasurement() override;
+    SensorStatus read(SensorData& data) override;
+    SensorStatus sleep() override;
+    SensorStatus wakeup() override;
+    SensorStatus selfTest() override;
+    SensorStatus reset() override;
+    SensorStatus configure(const SensorConfig& config) override;
+    const SensorInfo& getInfo() const override;
+    
+    /**
+     * @brief Datasheet conversions in fixed point, rounded to nearest
+     * 
+     * RH = 100 * raw / 2^20 and T = 200 * raw / 2^20 - 50 on the 20-bit codes
+     * (10000 / 2^20 = 625 / 2^16, so the products stay within 32 bits).
+     */
+    static int16_t rawToCentiCelsius(uint32_t raw) {
+        return static_cast<int16_t>(static_cast<int32_t>((raw * 625UL + 16384UL) >> 15) - 5000);
+    }
+    
+    static uint16_t rawToCentiPercent(uint32_t raw) {
+        return static_cast<uint16_t>((raw * 625UL + 32768UL) >> 16);
+    }
+    
+private:
+    // AHT20 Hardware Constants
+    static constexpr uint8_t I2C_ADDR = 0x38;
+    static constexpr I2CSpeed I2C_SPEED = I2CSpeed::FAST;  // AHT20 supports 400 kHz
+    
+    static constexpr uint8_t CMD_STATUS = 0x71;
+    static constexpr uint8_t CMD_INIT[3] = {0xBE, 0x08, 0x00};
+    static constexpr uint8_t CMD_MEASURE[3] = {0xAC, 0x33, 0x00};
+    static constexpr uint8_t CMD_SOFT_RESET = 0xBA;
+    
+    static constexpr uint8_t STATUS_BUSY = 0x80;
+    static constexpr uint8_t STATUS_CALIBRATED = 0x08;
+    
+    static constexpr uint16_t MEAS_TIME_MS = 80;         // Datasheet wait before the first fetch
+    static constexpr uint32_t POLL_INTERVAL_US = 2000;   // Busy-bit polling after that
+    static constexpr uint32_t POLL_LIMIT_US = 20000;
+    static constexpr uint16_t INIT_TIME_MS = 10;
+    static constexpr uint16_t RESET_TIME_MS = 20;
+    
+    // Private state
+    bool m_initialized;
+    SensorConfig m_config;
+    int64_t m_last_meas_time_us;  // Measurement command sent
+    
+    // Private helper methods
+    uint8_t calculateCRC8(const uint8_t* data, uint8_t len);
+    SensorStatus readStatus(uint8_t& status);
+    SensorStatus decodeMeasurement(const uint8_t* buf, SensorData& data);
+    void convertRawData(uint32_t temp_raw, uint32_t hum_raw, SensorData& data);
+};
+
+#endif // AHT20_SENSOR_HPP
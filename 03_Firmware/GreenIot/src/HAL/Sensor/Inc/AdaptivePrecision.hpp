@@ -0,0 +1,141 @@
+/**
+ * @file AdaptivePrecision.hpp
+ * @brief Noise-adaptive repeatability selection for burst acquisition (header-only)
+ * 
+ * Architecture Layer: HAL (Hardware Abstraction Layer)
+ * Used by: SHT31Sensor::readBurst(), native tests
+ * 
+ * The sample-to-sample variance of a burst is the sensor's own noise at the
+ * chosen repeatability plus whatever short-term fluctuation the air adds.
+ * Subtracting the datasheet part leaves the excess, which does not depend on
+ * the repeatability; it is smoothed across wakes and used to predict the
+ * aggregate noise at every level. The lowest level that meets the target
+ * wins. Steps down are one level per burst, steps up are immediate, and a
+ * reading outside the precision window forces high repeatability.
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#ifndef ADAPTIVE_PRECISION_HPP
+#define ADAPTIVE_PRECISION_HPP
+
+#include "ISensor.hpp"
+#include <cstdint>
+
+#define ADAPTIVE_PRECISION_LEVELS 3   // 0=low, 1=medium, 2=high
+
+/**
+ * @brief Per-sample variance of a sensor at each precision, 1/16 centi-unit²
+ */
+struct SensorNoiseProfile {
+    uint16_t temp_variance_q4[ADAPTIVE_PRECISION_LEVELS];
+    uint16_t hum_variance_q4[ADAPTIVE_PRECISION_LEVELS];
+};
+
+/**
+ * @brief Selector state; plain data so it can live in RTC memory
+ * 
+ * All-zero (cold boot) means no burst has been observed yet.
+ */
+struct AdaptivePrecisionState {
+    uint32_t temp_excess_q4;    // Smoothed variance beyond the sensor's own noise
+    uint32_t hum_excess_q4;
+    int16_t last_temp_centi_c;  // Last aggregate, checked against the precision window
+    uint16_t last_hum_centi_pct;
+    uint8_t precision;          // Precision of the last observed burst
+    uint8_t observations;       // Saturates at 255
+};
+
+class AdaptivePrecision {
+public:
+    static constexpr uint8_t PRECISION_HIGH = ADAPTIVE_PRECISION_LEVELS - 1;
+    static constexpr uint8_t MIN_VALID_SAMPLES = 3;   // At least two differences per estimate
+    static constexpr uint8_t SMOOTHING_SHIFT = 2;     // EWMA weight 1/4 for a new burst
+    
+    /**
+     * @brief Precision for the next burst
+     * 
+     * High until a first burst has been observed, and while the last reading
+     * lies outside config.precision_window.
+     */
+    static uint8_t select(const AdaptivePrecisionState& state, const SensorNoiseProfile& profile,
+                          const SensorConfig& config) {
+        if (state.observations == 0 || !insideWindow(state, config.precision_window)) {
+            return PRECISION_HIGH;
+        }
+        
+        uint8_t floor = (state.precision > 0) ? static_cast<uint8_t>(state.precision - 1) : 0;
+        for (uint8_t level = floor; level < PRECISION_HIGH; level++) {
+            if (meetsTarget(aggregateVarianceQ4(profile.temp_variance_q4[level], state.temp_excess_q4,
+                                                config.burst_samples), config.noise_target_centi_c) &&
+                meetsTarget(aggregateVarianceQ4(profile.hum_variance_q4[level], state.hum_excess_q4,
+                                                config.burst_samples), config.noise_target_centi_pct)) {
+                return level;
+            }
+        }
+        return PRECISION_HIGH;
+    }
+    
+    /**
+     * @brief Fold a completed burst into the state
+     * 
+     * Bursts with fewer than MIN_VALID_SAMPLES valid samples only update the
+     * last reading.
+     */
+    static void observe(AdaptivePrecisionState& state, const SensorNoiseProfile& profile,
+                        uint8_t precision, const BurstResult& burst) {
+        if (precision > PRECISION_HIGH) precision = PRECISION_HIGH;
+        state.last_temp_centi_c = burst.data.temperature_centi_c;
+        state.last_hum_centi_pct = burst.data.humidity_centi_pct;
+        if (burst.valid < MIN_VALID_SAMPLES) return;
+        
+        uint32_t temp_excess = excessQ4(burst.temp_variance_q4, profile.temp_variance_q4[precision]);
+        uint32_t hum_excess = excessQ4(burst.hum_variance_q4, profile.hum_variance_q4[precision]);
+        if (state.observations == 0) {
+            state.temp_excess_q4 = temp_excess;
+            state.hum_excess_q4 = hum_excess;
+        } else {
+            state.temp_excess_q4 = smooth(state.temp_excess_q4, temp_excess);
+            state.hum_excess_q4 = smooth(state.hum_excess_q4, hum_excess);
+        }
+        state.precision = precision;
+        if (state.observations < UINT8_MAX) state.observations++;
+    }
+    
+    /**
+     * @brief Predicted variance of a median over samples values, 1/16 centi-unit²
+     * 
+     * The median of n normal samples has about 1.25² / n times the variance
+     * of one sample (the trimmed mean does slightly better).
+     */
+    static uint32_t aggregateVarianceQ4(uint16_t sensor_q4, uint32_t excess_q4, uint8_t samples) {
+        if (samples == 0) samples = 1;
+        uint64_t total = static_cast<uint64_t>(sensor_q4) + excess_q4;
+        uint64_t aggregate = (total * 25 + 8 * samples) / (16 * static_cast<uint64_t>(samples));
+        return (aggregate > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(aggregate);
+    }
+    
+private:
+    static bool insideWindow(const AdaptivePrecisionState& state, const SensorAlertLimits& window) {
+        return state.last_temp_centi_c >= window.temp_low_centi_c &&
+               state.last_temp_centi_c <= window.temp_high_centi_c &&
+               state.last_hum_centi_pct >= window.hum_low_centi_pct &&
+               state.last_hum_centi_pct <= window.hum_high_centi_pct;
+    }
+    
+    static bool meetsTarget(uint32_t variance_q4, uint16_t target) {
+        return variance_q4 <= static_cast<uint32_t>(target) * target * 16;
+    }
+    
+    static uint32_t excessQ4(uint32_t measured_q4, uint16_t sensor_q4) {
+        return (measured_q4 > sensor_q4) ? measured_q4 - sensor_q4 : 0;
+    }
+    
+    static uint32_t smooth(uint32_t average, uint32_t sample) {
+        return (sample >= average) ? average + ((sample - average) >> SMOOTHING_SHIFT)
+                                   : average - ((average - sample) >> SMOOTHING_SHIFT);
+    }
+};
+
+#endif // ADAPTIVE_PRECISION_HPP
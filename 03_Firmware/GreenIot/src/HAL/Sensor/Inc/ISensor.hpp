@@ -14,10 +14,10 @@
 #ifndef ISENSOR_HPP
 #define ISENSOR_HPP
 
+#include <cstddef>
 #include <cstdint>
-#include <string>
-#include <memory>
-#include <vector>
+#include "fixed_point.h"
+#include "SensorFilter.hpp"
 
 /**
  * @brief Sensor status codes
@@ -35,16 +35,38 @@ enum class SensorStatus {
 
 /**
  * @brief Sensor data structure (standardized output)
+ * 
+ * Fixed-point units (see fixed_point.h): the whole pipeline runs without
+ * soft-float on the ESP32-C3.
  */
 struct SensorData {
-    float temperature_celsius;
-    float humidity_percent;
-    uint32_t timestamp;
+    int16_t temperature_centi_c;    // 0.01 °C
+    uint16_t humidity_centi_pct;    // 0.01 %RH
+    uint32_t timestamp;             // s; drivers stamp uptime, StateMachine the kept clock
     uint8_t quality_flags;  // [7]=temp_valid, [6]=hum_valid
     
     bool isValid() const {
         return (quality_flags & 0xC0) == 0xC0;
     }
+    
+    // Human-facing edge only (host tools, tests)
+    float temperatureCelsius() const { return centi_to_float(temperature_centi_c); }
+    float humidityPercent() const { return centi_to_float(humidity_centi_pct); }
+};
+
+/**
+ * @brief Threshold alert window (ISensor::armAlert())
+ * 
+ * The alert asserts when temperature or humidity leaves [low, high] and
+ * releases once both are back inside by at least the hysteresis.
+ */
+struct SensorAlertLimits {
+    int16_t temp_low_centi_c;
+    int16_t temp_high_centi_c;
+    uint16_t hum_low_centi_pct;
+    uint16_t hum_high_centi_pct;
+    uint16_t temp_hysteresis_centi_c;
+    uint16_t hum_hysteresis_centi_pct;
 };
 
 /**
@@ -52,33 +74,85 @@ struct SensorData {
  */
 struct SensorConfig {
     uint8_t precision;         // 0=low, 1=medium, 2=high
-    float temp_offset_celsius;
-    float hum_offset_percent;
+    int16_t temp_offset_centi_c;
+    int16_t hum_offset_centi_pct;
     bool enable_heater;
+    bool poll_ready;           // Poll for data-ready instead of waiting the worst-case conversion time
+    uint8_t burst_samples;     // Samples per readBurst() (1..SENSOR_BURST_MAX_SAMPLES)
+    uint8_t burst_precision;   // Precision of each burst sample (0=low, 1=medium, 2=high)
+    BurstFilter burst_filter;  // Aggregate of the valid burst samples
+    
+    // Adaptive repeatability (drivers with a repeatability setting): each burst
+    // runs at the lowest precision whose predicted aggregate noise (1 sigma)
+    // meets the targets, and at high precision outside precision_window
+    bool adaptive_precision;
+    uint16_t noise_target_centi_c;
+    uint16_t noise_target_centi_pct;
+    SensorAlertLimits precision_window;  // Hysteresis fields unused
     
     // Default constructor
     SensorConfig() 
         : precision(2)
-        , temp_offset_celsius(0.0f)
-        , hum_offset_percent(0.0f)
-        , enable_heater(false) {}
+        , temp_offset_centi_c(0)
+        , hum_offset_centi_pct(0)
+        , enable_heater(false)
+        , poll_ready(true)
+        , burst_samples(5)
+        , burst_precision(0)
+        , burst_filter(BurstFilter::MEDIAN)
+        , adaptive_precision(false)
+        , noise_target_centi_c(5)       // 0.05 °C
+        , noise_target_centi_pct(20)    // 0.2 %RH
+        , precision_window{INT16_MIN, INT16_MAX, 0, UINT16_MAX, 0, 0} {}
+};
+
+/**
+ * @brief Result of a burst acquisition (ISensor::readBurst())
+ */
+struct BurstResult {
+    SensorData data;        // Aggregate of the valid samples
+    uint16_t sample_mask;   // Bit i set: sample i was read (CRC, in range) and aggregated
+    uint8_t samples;        // Samples attempted
+    uint8_t valid;          // Samples set in sample_mask
+    uint32_t temp_variance_q4;  // Sample-to-sample variance of the valid samples,
+    uint32_t hum_variance_q4;   // 1/16 centi-unit² (0 if fewer than 2)
+};
+
+/**
+ * @brief Periodic (free-running) acquisition rates
+ * 
+ * MPS = measurements per second. ART is the accelerated response mode
+ * (4 Hz on the SHT3x).
+ */
+enum class PeriodicRate : uint8_t {
+    MPS_0_5 = 0,
+    MPS_1,
+    MPS_2,
+    MPS_4,
+    MPS_10,
+    ART
 };
 
 /**
  * @brief Sensor information (metadata)
+ * 
+ * Literal type: drivers keep theirs as a constexpr table in flash.
  */
 struct SensorInfo {
-    std::string name;
-    std::string manufacturer;
-    float temp_min;
-    float temp_max;
-    float hum_min;
-    float hum_max;
-    float temp_accuracy;
-    float hum_accuracy;
+    const char* name;
+    const char* manufacturer;
+    int16_t temp_min_centi_c;
+    int16_t temp_max_centi_c;
+    uint16_t hum_min_centi_pct;
+    uint16_t hum_max_centi_pct;
+    uint16_t temp_accuracy_centi_c;
+    uint16_t hum_accuracy_centi_pct;
     uint16_t measurement_time_ms;
+    uint16_t startup_time_ms;   // Power applied to first command accepted
+    uint16_t reset_time_ms;     // Soft reset / calibration needed after power-up (0 = none)
+    uint16_t first_conversion_ms;  // Conversion discarded after power-up (0 = first one is valid)
     uint16_t power_active_ua;
-    uint16_t power_sleep_ua;
+    uint16_t power_sleep_na;    // Idle between measurements (nA: well below 1 µA)
 };
 
 /**
@@ -115,6 +189,115 @@ public:
      */
     virtual SensorStatus read(SensorData& data) = 0;
     
+    /**
+     * @brief Start a measurement without blocking the caller
+     * 
+     * The conversion and the bus transfers run in the background so the
+     * caller can do other work meanwhile. Drivers without an asynchronous
+     * path fall back to triggerMeasurement().
+     * 
+     * @return SensorStatus::OK if the measurement was started
+     */
+    virtual SensorStatus triggerMeasurementAsync() { return triggerMeasurement(); }
+    
+    /**
+     * @brief Wait for a measurement started by triggerMeasurementAsync()
+     * @param data Reference to store results
+     * @return SensorStatus::OK on success
+     */
+    virtual SensorStatus awaitMeasurement(SensorData& data) { return read(data); }
+    
+    /**
+     * @brief Put the sensor into free-running periodic acquisition
+     * 
+     * While periodic mode is active, samples are pulled with readLatest();
+     * single-shot triggers are rejected until stopPeriodic().
+     * 
+     * @param rate Measurement rate
+     * @return SensorStatus::ERROR_INVALID_PARAM if the sensor has no periodic mode
+     */
+    virtual SensorStatus startPeriodic(PeriodicRate rate) {
+        (void)rate;
+        return SensorStatus::ERROR_INVALID_PARAM;
+    }
+    
+    /**
+     * @brief Leave periodic acquisition and return to single-shot mode
+     * @return SensorStatus::OK on success
+     */
+    virtual SensorStatus stopPeriodic() { return SensorStatus::OK; }
+    
+    /**
+     * @brief Check whether periodic acquisition is running
+     */
+    virtual bool isPeriodic() const { return false; }
+    
+    /**
+     * @brief Streaming read: pull the newest sample without a conversion wait
+     * 
+     * In periodic mode each sample is returned once; ERROR_NOT_READY means
+     * no new sample has been produced since the previous call. Drivers
+     * without a periodic mode fall back to a blocking single-shot measurement.
+     * 
+     * @param data Reference to store results
+     * @return SensorStatus::OK if a new sample was read
+     */
+    virtual SensorStatus readLatest(SensorData& data) {
+        SensorStatus status = triggerMeasurement();
+        return (status == SensorStatus::OK) ? read(data) : status;
+    }
+    
+    /**
+     * @brief Burst acquisition: N back-to-back samples and a robust aggregate
+     * 
+     * Sample count, per-sample precision and the aggregate come from
+     * SensorConfig. A failed or out-of-range sample only clears its bit in
+     * the quality mask; the burst fails only if half or more samples fail.
+     * Drivers without burst support take a single measurement.
+     * 
+     * @param result Aggregate and per-sample quality mask
+     * @return SensorStatus::OK if a majority of samples was valid
+     */
+    virtual SensorStatus readBurst(BurstResult& result) {
+        return acquireBurst(1, BurstFilter::MEDIAN, result);
+    }
+    
+    /**
+     * @brief Bracket burst samples that the caller runs itself
+     * 
+     * Between the two calls triggerMeasurement() runs at the precision
+     * readBurst() would pick (SensorConfig::burst_precision, or the adaptive
+     * selection). endBurst() restores the single-shot precision and feeds
+     * the aggregate of a successful burst back to the selector. Used by
+     * SensorGroup, which interleaves the samples of its members. Drivers
+     * without a repeatability setting ignore both.
+     * 
+     * @param result This sensor's aggregate, nullptr if the burst failed
+     */
+    virtual void beginBurst() {}
+    virtual void endBurst(const BurstResult* result) { (void)result; }
+    
+    /**
+     * @brief Program threshold limits and let the sensor watch them on its own
+     * 
+     * The sensor keeps measuring at a low rate and drives its ALERT output
+     * while a value is outside the window, so the MCU can sleep until then.
+     * Measurements are unavailable until disarmAlert() or a re-init.
+     * 
+     * @param limits Alert window in calibrated units (offsets are applied)
+     * @return SensorStatus::ERROR_INVALID_PARAM if the sensor has no alert output
+     */
+    virtual SensorStatus armAlert(const SensorAlertLimits& limits) {
+        (void)limits;
+        return SensorStatus::ERROR_INVALID_PARAM;
+    }
+    
+    /**
+     * @brief Stop threshold monitoring and return to single-shot mode
+     * @return SensorStatus::OK on success
+     */
+    virtual SensorStatus disarmAlert() { return SensorStatus::OK; }
+    
     /**
      * @brief Enter low-power sleep mode
      * @return SensorStatus::OK on success
@@ -170,25 +353,112 @@ public:
             default:                               return "Unknown Error";
         }
     }
+    
+protected:
+    /**
+     * @brief Burst engine shared by the drivers
+     * 
+     * Runs samples back to back through triggerMeasurementAsync() /
+     * awaitMeasurement() with the driver's current settings and stops early
+     * once a majority can no longer be reached.
+     */
+    SensorStatus acquireBurst(uint8_t samples, BurstFilter filter, BurstResult& result) {
+        return acquireBurst(*this, samples, filter, result);
+    }
+    
+    /**
+     * @brief Burst engine bound to a concrete (final) driver type
+     * 
+     * With Sensor = the calling driver the per-sample calls are direct and
+     * can be inlined into the loop; with Sensor = ISensor they are virtual.
+     */
+    template <typename Sensor>
+    static SensorStatus acquireBurst(Sensor& sensor, uint8_t samples, BurstFilter filter,
+                                     BurstResult& result) {
+        result.sample_mask = 0;
+        result.samples = samples;
+        result.valid = 0;
+        result.temp_variance_q4 = 0;
+        result.hum_variance_q4 = 0;
+        if (samples == 0 || samples > SENSOR_BURST_MAX_SAMPLES) {
+            return SensorStatus::ERROR_INVALID_PARAM;
+        }
+        
+        const SensorInfo& info = sensor.getInfo();
+        int32_t temperatures[SENSOR_BURST_MAX_SAMPLES];
+        int32_t humidities[SENSOR_BURST_MAX_SAMPLES];
+        SensorStatus last_error = SensorStatus::ERROR_NOT_READY;
+        
+        for (uint8_t i = 0; i < samples; i++) {
+            SensorData sample;
+            SensorStatus status = sensor.triggerMeasurementAsync();
+            if (status == SensorStatus::OK) {
+                status = sensor.awaitMeasurement(sample);
+            }
+            if (status == SensorStatus::OK &&
+                (!sample.isValid() ||
+                 sample.temperature_centi_c < info.temp_min_centi_c ||
+                 sample.temperature_centi_c > info.temp_max_centi_c ||
+                 sample.humidity_centi_pct < info.hum_min_centi_pct ||
+                 sample.humidity_centi_pct > info.hum_max_centi_pct)) {
+                status = SensorStatus::ERROR_OUT_OF_RANGE;
+            }
+            
+            if (status != SensorStatus::OK) {
+                last_error = status;
+                uint8_t failed = static_cast<uint8_t>(i + 1 - result.valid);
+                if (failed * 2 >= samples) break;  // Majority out of reach
+                continue;
+            }
+            
+            temperatures[result.valid] = sample.temperature_centi_c;
+            humidities[result.valid] = sample.humidity_centi_pct;
+            result.data.timestamp = sample.timestamp;
+            result.sample_mask |= static_cast<uint16_t>(1U << i);
+            result.valid++;
+        }
+        
+        if (result.valid * 2 <= samples) {
+            return last_error;
+        }
+        
+        result.temp_variance_q4 = SensorFilter::successiveVarianceQ4(temperatures, result.valid);
+        result.hum_variance_q4 = SensorFilter::successiveVarianceQ4(humidities, result.valid);
+        result.data.temperature_centi_c = static_cast<int16_t>(
+            SensorFilter::apply(filter, temperatures, result.valid));
+        result.data.humidity_centi_pct = static_cast<uint16_t>(
+            SensorFilter::apply(filter, humidities, result.valid));
+        result.data.quality_flags = 0xC0;
+        return SensorStatus::OK;
+    }
 };
 
 /**
  * @brief Sensor factory class
+ * 
+ * Sensors come from a constexpr registry and live in static storage, so
+ * nothing is heap-allocated between create() and the first read().
  */
 class SensorFactory {
 public:
     /**
-     * @brief Create sensor instance by name
+     * @brief Get the sensor instance registered under a name
      * @param name Sensor name (e.g., "SHT31", "AHT20")
-     * @return Unique pointer to sensor, or nullptr if not found
+     * @return Static instance (the same object on every call, never delete it),
+     *         or nullptr if not found
+     */
+    static ISensor* create(const char* name);
+    
+    /**
+     * @brief Number of registered sensors
      */
-    static std::unique_ptr<ISensor> create(const std::string& name);
+    static size_t getSensorCount();
     
     /**
-     * @brief Get list of available sensors
-     * @return Vector of sensor names
+     * @brief Name of the registered sensor at index
+     * @return nullptr if index >= getSensorCount()
      */
-    static std::vector<std::string> getAvailableSensors();
+    static const char* getSensorName(size_t index);
 };
 
 #endif // ISENSOR_HPP
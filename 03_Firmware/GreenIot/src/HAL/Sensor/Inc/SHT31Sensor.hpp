@@ -12,12 +12,17 @@
 #define SHT31_SENSOR_HPP
 
 #include "ISensor.hpp"
+#include "AdaptivePrecision.hpp"
+#include "I2CDriver.hpp"
 #include <cstdint>
 
 /**
  * @brief SHT31 sensor driver class
+ * 
+ * final: calls through SHT31Sensor& (SensorBinding, the burst engine) are
+ * resolved at compile time.
  */
-class SHT31Sensor : public ISensor {
+class SHT31Sensor final : public ISensor {
 public:
     SHT31Sensor();
     ~SHT31Sensor() override;
@@ -27,6 +32,17 @@ public:
     SensorStatus deinit() override;
     SensorStatus triggerMeasurement() override;
     SensorStatus read(SensorData& data) override;
+    SensorStatus triggerMeasurementAsync() override;
+    SensorStatus awaitMeasurement(SensorData& data) override;
+    SensorStatus startPeriodic(PeriodicRate rate) override;
+    SensorStatus stopPeriodic() override;
+    bool isPeriodic() const override { return m_periodic; }
+    SensorStatus readLatest(SensorData& data) override;
+    SensorStatus readBurst(BurstResult& result) override;
+    void beginBurst() override;
+    void endBurst(const BurstResult* result) override;
+    SensorStatus armAlert(const SensorAlertLimits& limits) override;
+    SensorStatus disarmAlert() override;
     SensorStatus sleep() override;
     SensorStatus wakeup() override;
     SensorStatus selfTest() override;
@@ -34,33 +50,141 @@ public:
     SensorStatus configure(const SensorConfig& config) override;
     const SensorInfo& getInfo() const override;
     
+    /**
+     * @brief Datasheet conversions in fixed point, rounded to nearest
+     * 
+     * T = -45 + 175 * raw / 65535 and RH = 100 * raw / 65535, evaluated in
+     * 32-bit integers (hardware multiply/divide on RV32IMC).
+     */
+    static int16_t rawToCentiCelsius(uint16_t raw) {
+        return static_cast<int16_t>(static_cast<int32_t>((17500UL * raw + 32767UL) / 65535UL) - 4500);
+    }
+    
+    static uint16_t rawToCentiPercent(uint16_t raw) {
+        return static_cast<uint16_t>((10000UL * raw + 32767UL) / 65535UL);
+    }
+    
+    /**
+     * @brief Inverse conversions (clamped to the sensor's raw range)
+     */
+    static uint16_t centiCelsiusToRaw(int32_t centi_c) {
+        int32_t offset = centi_c + 4500;
+        if (offset < 0) offset = 0;
+        if (offset > 17500) offset = 17500;
+        return static_cast<uint16_t>(static_cast<uint32_t>(offset) * 65535UL / 17500UL);
+    }
+    
+    static uint16_t centiPercentToRaw(int32_t centi_pct) {
+        if (centi_pct < 0) centi_pct = 0;
+        if (centi_pct > 10000) centi_pct = 10000;
+        return static_cast<uint16_t>(static_cast<uint32_t>(centi_pct) * 65535UL / 10000UL);
+    }
+    
+    /**
+     * @brief Per-sample variance at low / medium / high repeatability
+     * 
+     * Datasheet repeatability is 3 sigma: 0.15 / 0.08 / 0.04 °C and
+     * 0.21 / 0.15 / 0.08 %RH.
+     */
+    static constexpr SensorNoiseProfile NOISE_PROFILE = {
+        {400, 114, 28},
+        {784, 400, 114}
+    };
+    
+    /**
+     * @brief Alert limit register: 7 MSBs of raw RH, 9 MSBs of raw T
+     */
+    static uint16_t alertLimitWord(int32_t temp_centi_c, int32_t hum_centi_pct) {
+        return static_cast<uint16_t>((centiPercentToRaw(hum_centi_pct) & 0xFE00) |
+                                     (centiCelsiusToRaw(temp_centi_c) >> 7));
+    }
+    
 private:
     // SHT31 Hardware Constants
     static constexpr uint8_t I2C_ADDR_DEFAULT = 0x44;
     static constexpr uint8_t I2C_ADDR_ALT = 0x45;
+    static constexpr I2CSpeed I2C_SPEED = I2CSpeed::FAST_PLUS;  // SHT3x supports 1 MHz
     
     static constexpr uint16_t CMD_MEAS_HIGH = 0x2C06;
     static constexpr uint16_t CMD_MEAS_MED  = 0x2C0D;
     static constexpr uint16_t CMD_MEAS_LOW  = 0x2C10;
+    static constexpr uint16_t CMD_MEAS_NOSTRETCH_HIGH = 0x2400;
+    static constexpr uint16_t CMD_MEAS_NOSTRETCH_MED  = 0x240B;
+    static constexpr uint16_t CMD_MEAS_NOSTRETCH_LOW  = 0x2416;
     static constexpr uint16_t CMD_SOFT_RESET = 0x30A2;
     static constexpr uint16_t CMD_HEATER_ON  = 0x306D;
     static constexpr uint16_t CMD_HEATER_OFF = 0x3066;
     static constexpr uint16_t CMD_READ_STATUS = 0xF32D;
+    static constexpr uint16_t CMD_FETCH_DATA = 0xE000;
+    static constexpr uint16_t CMD_BREAK = 0x3093;
+    static constexpr uint16_t CMD_ART = 0x2B32;
+    static constexpr uint16_t CMD_CLEAR_STATUS = 0x3041;
+    static constexpr uint16_t CMD_ALERT_HIGH_SET   = 0x611D;
+    static constexpr uint16_t CMD_ALERT_HIGH_CLEAR = 0x6116;
+    static constexpr uint16_t CMD_ALERT_LOW_CLEAR  = 0x610B;
+    static constexpr uint16_t CMD_ALERT_LOW_SET    = 0x6100;
+    
+    // Alert monitoring: slowest periodic rate at low repeatability (~2 µA average)
+    static constexpr PeriodicRate ALERT_RATE = PeriodicRate::MPS_0_5;
+    static constexpr uint8_t ALERT_PRECISION = 0;
+    
+    // Periodic start commands, [rate][precision] with precision 0=low, 1=medium, 2=high
+    static constexpr uint16_t CMD_PERIODIC[5][3] = {
+        {0x202F, 0x2024, 0x2032},   // 0.5 mps
+        {0x212D, 0x2126, 0x2130},   // 1 mps
+        {0x222B, 0x2220, 0x2236},   // 2 mps
+        {0x2329, 0x2322, 0x2334},   // 4 mps
+        {0x272A, 0x2721, 0x2737}    // 10 mps
+    };
     
     static constexpr uint16_t MEAS_TIME_HIGH_MS = 15;
     static constexpr uint16_t MEAS_TIME_MED_MS  = 6;
     static constexpr uint16_t MEAS_TIME_LOW_MS  = 4;
+    
+    // Readiness polling: first attempt shortly before the typical conversion
+    // time, then every POLL_INTERVAL_US until the worst case has passed
+    static constexpr uint32_t MEAS_TYP_HIGH_US = 12500;
+    static constexpr uint32_t MEAS_TYP_MED_US  = 4500;
+    static constexpr uint32_t MEAS_TYP_LOW_US  = 2500;
+    static constexpr uint32_t POLL_LEAD_US = 1000;
+    static constexpr uint32_t POLL_INTERVAL_US = 500;
     static constexpr uint16_t RESET_TIME_MS = 2;
+    static constexpr uint16_t BREAK_TIME_MS = 1;
+    static constexpr uint16_t FETCH_MARGIN_MS = 2;   // Fetch slightly after the sensor's own schedule
+    static constexpr uint16_t ASYNC_TIMEOUT_MS = 100;
     
     // Private state
     bool m_initialized;
     uint8_t m_i2c_address;
     SensorConfig m_config;
-    uint32_t m_last_meas_time;
+    int64_t m_last_meas_time_us;  // Measurement command sent
+    bool m_in_burst;              // Between beginBurst() and endBurst()
+    uint8_t m_single_precision;   // m_config.precision outside the burst
+    
+    // Periodic acquisition
+    bool m_periodic;
+    PeriodicRate m_periodic_rate;
+    uint32_t m_next_sample_ms;    // Earliest time a new sample can be fetched
+    
+    // Asynchronous acquisition batch (must outlive the queued batch)
+    I2COp m_async_ops[3];
+    uint8_t m_async_cmd[2];
+    uint8_t m_async_buf[6];
+    volatile bool m_async_pending;
+    volatile I2CStatus m_async_status;
+    TaskHandle_t m_async_waiter;
     
     // Private helper methods
     uint8_t calculateCRC8(const uint8_t* data, uint8_t len);
     SensorStatus sendCommand(uint16_t command);
+    uint16_t measurementCommand() const;
+    uint16_t measurementTimeMs() const;
+    uint32_t readyOffsetUs() const;
+    uint32_t deadlineOffsetUs() const;
+    uint16_t periodicCommand(PeriodicRate rate) const;
+    static uint32_t periodicIntervalMs(PeriodicRate rate);
+    SensorStatus decodeMeasurement(const uint8_t* buf, SensorData& data);
+    static void onAsyncComplete(I2CStatus status, void* context);
     void convertRawData(uint16_t temp_raw, uint16_t hum_raw, SensorData& data);
 };
 
@@ -0,0 +1,62 @@
+/**
+ * @file SensorBinding.hpp
+ * @brief Compile-time sensor selection (static binding)
+ * 
+ * Architecture Layer: HAL (Hardware Abstraction Layer)
+ * Used by: SensorFactory, StateMachine
+ * 
+ * Each production image ships with exactly one sensor. Building with
+ * -DSENSOR_STATIC_<NAME> binds that driver at compile time: the application
+ * calls it through its final type, so the acquisition path has no virtual
+ * dispatch. SensorFactory hands out the same instance as an ISensor* for
+ * dynamic use (tests, host tools).
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#ifndef SENSOR_BINDING_HPP
+#define SENSOR_BINDING_HPP
+
+#include <type_traits>
+#include "ISensor.hpp"
+
+/**
+ * @brief Static-storage instance of one sensor driver
+ */
+template <typename Sensor>
+class SensorBinding {
+    static_assert(std::is_base_of<ISensor, Sensor>::value, "Sensor must implement ISensor");
+    static_assert(std::is_final<Sensor>::value, "Sensor must be final to be devirtualised");
+    
+public:
+    /**
+     * @brief The driver instance (constructed on first use, no heap)
+     */
+    static Sensor& instance() {
+        static Sensor sensor;
+        return sensor;
+    }
+    
+    /**
+     * @brief Same instance for dynamic use (SensorFactory registry)
+     */
+    static ISensor* dynamicInstance() {
+        return &instance();
+    }
+};
+
+// Build-time selection (platformio.ini build_flags)
+#if defined(SENSOR_STATIC_SHT31)
+#include "SHT31Sensor.hpp"
+#define SENSOR_STATIC_BINDING 1
+#define SENSOR_STATIC_NAME "SHT31"
+typedef SensorBinding<SHT31Sensor> BoundSensor;
+#elif defined(SENSOR_STATIC_AHT20)
+#include "AHT20Sensor.hpp"
+#define SENSOR_STATIC_BINDING 1
+#define SENSOR_STATIC_NAME "AHT20"
+typedef SensorBinding<AHT20Sensor> BoundSensor;
+#endif
+
+#endif // SENSOR_BINDING_HPP
@@ -0,0 +1,112 @@
+/**
+ * @file SensorFilter.hpp
+ * @brief Robust aggregates for burst acquisition (header-only)
+ * 
+ * Architecture Layer: HAL (Hardware Abstraction Layer)
+ * Used by: ISensor::acquireBurst(), native tests
+ * 
+ * Integer median and trimmed mean over a handful of samples. Sorting is an
+ * in-place insertion sort: bursts are at most SENSOR_BURST_MAX_SAMPLES long,
+ * so it beats anything cleverer and needs no heap.
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifndef SENSOR_FILTER_HPP
+#define SENSOR_FILTER_HPP
+
+#include <cstdint>
+
+#define SENSOR_BURST_MAX_SAMPLES 16
+
+/**
+ * @brief Aggregate used to combine the valid samples of a burst
+ */
+enum class BurstFilter : uint8_t {
+    MEDIAN = 0,       // Middle value (mean of the two middle values for even counts)
+    TRIMMED_MEAN      // Mean after dropping the lowest and highest quarter
+};
+
+class SensorFilter {
+public:
+    /**
+     * @brief Sort values ascending (in place)
+     */
+    static void sort(int32_t* values, uint8_t count) {
+        for (uint8_t i = 1; i < count; i++) {
+            int32_t value = values[i];
+            uint8_t j = i;
+            while (j > 0 && values[j - 1] > value) {
+                values[j] = values[j - 1];
+                j--;
+            }
+            values[j] = value;
+        }
+    }
+    
+    /**
+     * @brief Median of count values; reorders the array
+     * @return 0 if count is 0
+     */
+    static int32_t median(int32_t* values, uint8_t count) {
+        if (count == 0) return 0;
+        sort(values, count);
+        if (count & 1) {
+            return values[count / 2];
+        }
+        return roundedMean(values[count / 2 - 1] + values[count / 2], 2);
+    }
+    
+    /**
+     * @brief Mean after dropping floor(count / 4) values at each end; reorders the array
+     * 
+     * Falls back to the plain mean for fewer than 4 values.
+     * @return 0 if count is 0
+     */
+    static int32_t trimmedMean(int32_t* values, uint8_t count) {
+        if (count == 0) return 0;
+        sort(values, count);
+        uint8_t trim = count / 4;
+        int32_t sum = 0;
+        for (uint8_t i = trim; i < count - trim; i++) {
+            sum += values[i];
+        }
+        return roundedMean(sum, count - 2 * trim);
+    }
+    
+    /**
+     * @brief Sample-to-sample variance in 1/16 unit² (call before sorting)
+     * 
+     * Half the mean squared successive difference: a slow drift across the
+     * burst cancels out, so what remains is the measurement noise.
+     * @return 0 for fewer than 2 values
+     */
+    static uint32_t successiveVarianceQ4(const int32_t* values, uint8_t count) {
+        if (count < 2) return 0;
+        uint32_t sum = 0;
+        for (uint8_t i = 1; i < count; i++) {
+            int32_t diff = values[i] - values[i - 1];
+            uint32_t magnitude = static_cast<uint32_t>(diff < 0 ? -diff : diff);
+            uint32_t square = magnitude * magnitude;
+            sum = (square > UINT32_MAX / 8 - sum) ? UINT32_MAX / 8 : sum + square;  // Saturate
+        }
+        return (sum * 8 + (count - 1) / 2) / (count - 1);
+    }
+    
+    /**
+     * @brief Aggregate selected by BurstFilter; reorders the array
+     */
+    static int32_t apply(BurstFilter filter, int32_t* values, uint8_t count) {
+        return (filter == BurstFilter::TRIMMED_MEAN) ? trimmedMean(values, count)
+                                                      : median(values, count);
+    }
+    
+private:
+    // Round half away from zero
+    static int32_t roundedMean(int32_t sum, int32_t count) {
+        return (sum >= 0) ? (sum + count / 2) / count : (sum - count / 2) / count;
+    }
+};
+
+#endif // SENSOR_FILTER_HPP
@@ -0,0 +1,102 @@
+/**
+ * @file SensorGroup.hpp
+ * @brief Several sensors on one bus acquired as one (composite ISensor)
+ * 
+ * Architecture Layer: HAL (Hardware Abstraction Layer)
+ * Used by: StateMachine
+ * 
+ * Every round triggers all members first and only then collects their
+ * results, so the awake window costs the slowest conversion instead of the
+ * sum of all of them. Members that fail (or read outside their rated range)
+ * are left out of the merged SensorData, which is the median of the valid
+ * members (the mean for two). Bursts run every member at its burst
+ * precision (ISensor::beginBurst()) and aggregate each member on its own.
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#ifndef SENSOR_GROUP_HPP
+#define SENSOR_GROUP_HPP
+
+#include "ISensor.hpp"
+#include <cstdint>
+
+#define SENSOR_GROUP_MAX_MEMBERS 4
+
+/**
+ * @brief Multi-sensor acquisition group
+ */
+class SensorGroup final : public ISensor {
+public:
+    SensorGroup();
+    ~SensorGroup() override = default;
+    
+    /**
+     * @brief Add a member (not owned; factory instances live in static storage)
+     * @return false if the group is full or the sensor is null / already a member
+     */
+    bool add(ISensor* sensor);
+    void clear();
+    
+    uint8_t size() const { return m_count; }
+    ISensor* member(uint8_t index) const { return (index < m_count) ? m_members[index] : nullptr; }
+    
+    /**
+     * @brief Members that initialised (bit i = member i)
+     */
+    uint8_t activeMask() const { return m_active_mask; }
+    
+    /**
+     * @brief Restrict acquisition to a subset of members (bit i = member i)
+     * 
+     * Lets a scheduler acquire only the members that are due; 0xFF (the
+     * default) selects all of them.
+     */
+    void select(uint8_t mask) { m_selected_mask = mask; }
+    uint8_t selectedMask() const { return m_selected_mask; }
+    
+    /**
+     * @brief Members that contributed to the last merged result
+     */
+    uint8_t validMask() const { return m_valid_mask; }
+    
+    /**
+     * @brief Last reading of one member (meaningful if its validMask() bit is set)
+     */
+    const SensorData& memberData(uint8_t index) const { return m_member_data[index]; }
+    
+    // ISensor interface implementation
+    SensorStatus init() override;
+    SensorStatus deinit() override;
+    SensorStatus triggerMeasurement() override;
+    SensorStatus read(SensorData& data) override;
+    SensorStatus readBurst(BurstResult& result) override;
+    SensorStatus armAlert(const SensorAlertLimits& limits) override;
+    SensorStatus disarmAlert() override;
+    SensorStatus sleep() override;
+    SensorStatus wakeup() override;
+    SensorStatus selfTest() override;
+    SensorStatus reset() override;
+    SensorStatus configure(const SensorConfig& config) override;
+    const SensorInfo& getInfo() const override { return m_info; }
+    
+private:
+    ISensor* m_members[SENSOR_GROUP_MAX_MEMBERS];
+    SensorData m_member_data[SENSOR_GROUP_MAX_MEMBERS];
+    uint8_t m_count;
+    uint8_t m_active_mask;
+    uint8_t m_selected_mask;
+    uint8_t m_triggered_mask;
+    uint8_t m_valid_mask;
+    SensorConfig m_config;
+    SensorInfo m_info;  // Intersection of the members' ranges, slowest conversion
+    
+    uint8_t collect(SensorData* samples, SensorStatus& last_error);
+    SensorStatus merge(SensorData& data);
+    void updateInfo();
+    
+    static bool inRange(const SensorData& data, const SensorInfo& info);
+};
+
+#endif // SENSOR_GROUP_HPP
@@ -0,0 +1,252 @@
+/**
+ * @file AHT20Sensor.cpp
+ * @brief AHT20 sensor driver implementation
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#include "AHT20Sensor.hpp"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char* TAG = "AHT20";
+
+constexpr uint8_t AHT20Sensor::CMD_INIT[3];
+constexpr uint8_t AHT20Sensor::CMD_MEASURE[3];
+
+AHT20Sensor::AHT20Sensor()
+    : m_initialized(false)
+    , m_last_meas_time_us(0)
+{
+    m_config.precision = 2;  // Fixed by the sensor
+    m_config.temp_offset_centi_c = 0;
+    m_config.hum_offset_centi_pct = 0;
+    m_config.enable_heater = false;
+    m_config.poll_ready = true;
+}
+
+AHT20Sensor::~AHT20Sensor() {
+    deinit();
+}
+
+SensorStatus AHT20Sensor::init() {
+    ESP_LOGI(TAG, "Initializing AHT20 sensor");
+    
+    // Warm wake: the topology cache already knows the sensor is present and
+    // calibrated (the calibration lives in its OTP, not in volatile state)
+    uint8_t cached_addr = 0;
+    if (I2CDriver::getInstance().lookupDevice(I2CDeviceType::AHT2X, cached_addr)) {
+        m_initialized = true;
+        ESP_LOGI(TAG, "AHT20 at cached address 0x%02X", cached_addr);
+        return SensorStatus::OK;
+    }
+    
+    uint8_t status = 0;
+    if (readStatus(status) != SensorStatus::OK) {
+        ESP_LOGE(TAG, "AHT20 not found on I2C bus");
+        return SensorStatus::ERROR_INIT;
+    }
+    
+    if (!(status & STATUS_CALIBRATED)) {
+        // Load the calibration coefficients
+        if (I2CDriver::getInstance().write(I2C_ADDR, CMD_INIT, sizeof(CMD_INIT)) != I2CStatus::OK) {
+            ESP_LOGE(TAG, "Calibration command failed");
+            return SensorStatus::ERROR_INIT;
+        }
+        vTaskDelay(pdMS_TO_TICKS(INIT_TIME_MS));
+        
+        if (readStatus(status) != SensorStatus::OK || !(status & STATUS_CALIBRATED)) {
+            ESP_LOGE(TAG, "AHT20 not calibrated, status: 0x%02X", status);
+            return SensorStatus::ERROR_INIT;
+        }
+    }
+    
+    I2CDriver::getInstance().setDeviceSpeed(I2C_ADDR, I2C_SPEED);
+    I2CDriver::getInstance().rememberDevice(I2C_ADDR, I2CDeviceType::AHT2X);
+    
+    m_initialized = true;
+    ESP_LOGI(TAG, "AHT20 initialized at address 0x%02X", I2C_ADDR);
+    return SensorStatus::OK;
+}
+
+SensorStatus AHT20Sensor::deinit() {
+    m_initialized = false;
+    ESP_LOGI(TAG, "AHT20 deinitialized");
+    return SensorStatus::OK;
+}
+
+SensorStatus AHT20Sensor::triggerMeasurement() {
+    if (!m_initialized) {
+        return SensorStatus::ERROR_NOT_READY;
+    }
+    
+    if (I2CDriver::getInstance().write(I2C_ADDR, CMD_MEASURE, sizeof(CMD_MEASURE)) != I2CStatus::OK) {
+        return SensorStatus::ERROR_COMM;
+    }
+    m_last_meas_time_us = esp_timer_get_time();
+    return SensorStatus::OK;
+}
+
+SensorStatus AHT20Sensor::read(SensorData& data) {
+    if (!m_initialized) {
+        return SensorStatus::ERROR_NOT_READY;
+    }
+    
+    // Status, 20-bit humidity, 20-bit temperature, CRC
+    int64_t fetch_at_us = m_last_meas_time_us + static_cast<int64_t>(MEAS_TIME_MS) * 1000;
+    int64_t deadline_us = fetch_at_us + POLL_LIMIT_US;
+    uint8_t read_buf[7];
+    
+    while (true) {
+        I2CDriver::waitUntil(fetch_at_us);
+        
+        if (I2CDriver::getInstance().read(I2C_ADDR, read_buf, 7) != I2CStatus::OK) {
+            ESP_LOGE(TAG, "I2C read failed");
+            I2CDriver::getInstance().forgetDevice(I2C_ADDR);
+            return SensorStatus::ERROR_COMM;
+        }
+        if (!(read_buf[0] & STATUS_BUSY)) {
+            break;
+        }
+        
+        fetch_at_us = esp_timer_get_time() + POLL_INTERVAL_US;
+        if (fetch_at_us > deadline_us) {
+            ESP_LOGE(TAG, "Measurement still busy");
+            return SensorStatus::ERROR_TIMEOUT;
+        }
+    }
+    
+    return decodeMeasurement(read_buf, data);
+}
+
+SensorStatus AHT20Sensor::sleep() {
+    // AHT20 sleeps between measurements
+    return SensorStatus::OK;
+}
+
+SensorStatus AHT20Sensor::wakeup() {
+    // AHT20 wakes on the measurement command
+    return SensorStatus::OK;
+}
+
+SensorStatus AHT20Sensor::selfTest() {
+    if (!m_initialized) {
+        return SensorStatus::ERROR_NOT_READY;
+    }
+    
+    uint8_t status = 0;
+    if (readStatus(status) != SensorStatus::OK) {
+        return SensorStatus::ERROR_COMM;
+    }
+    if (!(status & STATUS_CALIBRATED)) {
+        ESP_LOGE(TAG, "Self-test failed, status: 0x%02X", status);
+        return SensorStatus::ERROR_INIT;
+    }
+    
+    ESP_LOGI(TAG, "Self-test passed");
+    return SensorStatus::OK;
+}
+
+SensorStatus AHT20Sensor::reset() {
+    uint8_t cmd = CMD_SOFT_RESET;
+    if (I2CDriver::getInstance().write(I2C_ADDR, &cmd, 1) != I2CStatus::OK) {
+        return SensorStatus::ERROR_COMM;
+    }
+    vTaskDelay(pdMS_TO_TICKS(RESET_TIME_MS));
+    return SensorStatus::OK;
+}
+
+SensorStatus AHT20Sensor::configure(const SensorConfig& config) {
+    // Repeatability and heater are not configurable on the AHT20
+    m_config = config;
+    return SensorStatus::OK;
+}
+
+const SensorInfo& AHT20Sensor::getInfo() const {
+    static constexpr SensorInfo info = {
+        .name = "AHT20",
+        .manufacturer = "Aosong",
+        .temp_min_centi_c = -4000,
+        .temp_max_centi_c = 8500,
+        .hum_min_centi_pct = 0,
+        .hum_max_centi_pct = 10000,
+        .temp_accuracy_centi_c = 30,
+        .hum_accuracy_centi_pct = 200,
+        .measurement_time_ms = MEAS_TIME_MS,
+        .startup_time_ms = 100,     // Datasheet wait after power-on
+        .reset_time_ms = 0,         // Calibration is kept in OTP
+        .first_conversion_ms = 0,
+        .power_active_ua = 980,
+        .power_sleep_na = 250
+    };
+    
+    return info;
+}
+
+// Private helper methods
+
+uint8_t AHT20Sensor::calculateCRC8(const uint8_t* data, uint8_t len) {
+    uint8_t crc = 0xFF;
+    
+    for (uint8_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if (crc & 0x80) {
+                crc = (crc << 1) ^ 0x31;
+            } else {
+                crc = crc << 1;
+            }
+        }
+    }
+    
+    return crc;
+}
+
+SensorStatus AHT20Sensor::readStatus(uint8_t& status) {
+    uint8_t cmd = CMD_STATUS;
+    if (I2CDriver::getInstance().writeRead(I2C_ADDR, &cmd, 1, &status, 1) != I2CStatus::OK) {
+        return SensorStatus::ERROR_COMM;
+    }
+    return SensorStatus::OK;
+}
+
+SensorStatus AHT20Sensor::decodeMeasurement(const uint8_t* buf, SensorData& data) {
+    if (calculateCRC8(buf, 6) != buf[6]) {
+        ESP_LOGE(TAG, "CRC mismatch");
+        return SensorStatus::ERROR_CRC;
+    }
+    
+    uint32_t hum_raw = (static_cast<uint32_t>(buf[1]) << 12) |
+                       (static_cast<uint32_t>(buf[2]) << 4) |
+                       (buf[3] >> 4);
+    uint32_t temp_raw = (static_cast<uint32_t>(buf[3] & 0x0F) << 16) |
+                        (static_cast<uint32_t>(buf[4]) << 8) |
+                        buf[5];
+    
+    convertRawData(temp_raw, hum_raw, data);
+    
+    // Set quality flags
+    data.quality_flags = 0xC0;
+    data.timestamp = static_cast<uint32_t>(esp_timer_get_time() / 1000000);
+    
+    ESP_LOGD(TAG, "Read: " CENTI_FMT "°C, " CENTI_FMT "%% RH",
+             CENTI_ARGS(data.temperature_centi_c), CENTI_ARGS(data.humidity_centi_pct));
+    
+    return SensorStatus::OK;
+}
+
+void AHT20Sensor::convertRawData(uint32_t temp_raw, uint32_t hum_raw, SensorData& data) {
+    // Integer conversion plus calibration offsets (no soft-float)
+    int32_t temperature = rawToCentiCelsius(temp_raw) + m_config.temp_offset_centi_c;
+    int32_t humidity = rawToCentiPercent(hum_raw) + m_config.hum_offset_centi_pct;
+    
+    // Clamp humidity
+    if (humidity < 0) humidity = 0;
+    if (humidity > 10000) humidity = 10000;
+    
+    data.temperature_centi_c = static_cast<int16_t>(temperature);
+    data.humidity_centi_pct = static_cast<uint16_t>(humidity);
+}
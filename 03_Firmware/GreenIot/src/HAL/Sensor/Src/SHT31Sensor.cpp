@@ -7,7 +7,7 @@
  */
 
 #include "SHT31Sensor.hpp"
-#include "I2CDriver.hpp"
+#include "esp_attr.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
@@ -16,15 +16,33 @@
 
 static const char* TAG = "SHT31";
 
+// Alert monitoring keeps the sensor in periodic mode through deep sleep;
+// the next init() must break out of it before single-shot commands work
+RTC_DATA_ATTR static bool s_alert_armed = false;
+
+// Adaptive repeatability: noise estimate and last reading carried across wakes
+RTC_DATA_ATTR static AdaptivePrecisionState s_adaptive = {};
+
 SHT31Sensor::SHT31Sensor()
     : m_initialized(false)
     , m_i2c_address(I2C_ADDR_DEFAULT)
-    , m_last_meas_time(0)
+    , m_last_meas_time_us(0)
+    , m_in_burst(false)
+    , m_single_precision(2)
+    , m_periodic(false)
+    , m_periodic_rate(PeriodicRate::MPS_1)
+    , m_next_sample_ms(0)
+    , m_async_cmd{0, 0}
+    , m_async_buf{0}
+    , m_async_pending(false)
+    , m_async_status(I2CStatus::OK)
+    , m_async_waiter(nullptr)
 {
     m_config.precision = 2;  // High precision
-    m_config.temp_offset_celsius = 0.0f;
-    m_config.hum_offset_percent = 0.0f;
+    m_config.temp_offset_centi_c = 0;
+    m_config.hum_offset_centi_pct = 0;
     m_config.enable_heater = false;
+    m_config.poll_ready = true;
 }
 
 SHT31Sensor::~SHT31Sensor() {
@@ -32,7 +50,28 @@ SHT31Sensor::~SHT31Sensor() {
 }
 
 SensorStatus SHT31Sensor::init() {
-    ESP_LOGI(TAG, "Initializing SHT31 sensor");
+    ESP_LOGD(TAG, "Initializing SHT31 sensor");
+    
+    // Warm wake: address and clock profile come from the RTC topology cache.
+    // The sensor has just been powered up, so no probe or soft reset is needed;
+    // a later communication failure drops the entry and forces full discovery.
+    uint8_t cached_addr = 0;
+    if (I2CDriver::getInstance().lookupDevice(I2CDeviceType::SHT3X, cached_addr)) {
+        m_i2c_address = cached_addr;
+        if (s_alert_armed) {
+            // Still powered and monitoring since before the sleep
+            if (sendCommand(CMD_BREAK) != SensorStatus::OK) {
+                ESP_LOGE(TAG, "Break after alert monitoring failed");
+                I2CDriver::getInstance().forgetDevice(m_i2c_address);
+                return SensorStatus::ERROR_INIT;
+            }
+            s_alert_armed = false;
+            vTaskDelay(pdMS_TO_TICKS(BREAK_TIME_MS));
+        }
+        m_initialized = true;
+        ESP_LOGD(TAG, "SHT31 at cached address 0x%02X", m_i2c_address);
+        return SensorStatus::OK;
+    }
     
     // Try default address
     m_i2c_address = I2C_ADDR_DEFAULT;
@@ -52,85 +91,349 @@ SensorStatus SHT31Sensor::init() {
     
     // Wait for reset
     vTaskDelay(pdMS_TO_TICKS(RESET_TIME_MS));
+    s_alert_armed = false;  // Soft reset also ends periodic mode
+    s_adaptive = {};        // Possibly a different part: learn its noise afresh
+    
+    // Discovery ran at the bus default; measurements use the fastest profile
+    // (the driver steps it down if the wiring cannot keep up)
+    I2CDriver::getInstance().setDeviceSpeed(m_i2c_address, I2C_SPEED);
+    I2CDriver::getInstance().rememberDevice(m_i2c_address, I2CDeviceType::SHT3X);
     
     m_initialized = true;
-    ESP_LOGI(TAG, "SHT31 initialized at address 0x%02X", m_i2c_address);
+    ESP_LOGD(TAG, "SHT31 initialized at address 0x%02X", m_i2c_address);
     return SensorStatus::OK;
 }
 
 SensorStatus SHT31Sensor::deinit() {
+    if (m_periodic) {
+        stopPeriodic();
+    }
     m_initialized = false;
     ESP_LOGI(TAG, "SHT31 deinitialized");
     return SensorStatus::OK;
 }
 
 SensorStatus SHT31Sensor::triggerMeasurement() {
-    if (!m_initialized) {
+    if (!m_initialized || m_periodic) {
         return SensorStatus::ERROR_NOT_READY;
     }
     
-    // Select command based on precision
-    uint16_t cmd;
-    switch (m_config.precision) {
-        case 0:  cmd = CMD_MEAS_LOW; break;
-        case 1:  cmd = CMD_MEAS_MED; break;
-        case 2:  cmd = CMD_MEAS_HIGH; break;
-        default: cmd = CMD_MEAS_HIGH; break;
-    }
-    
-    SensorStatus status = sendCommand(cmd);
+    SensorStatus status = sendCommand(measurementCommand());
     if (status == SensorStatus::OK) {
-        m_last_meas_time = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+        m_last_meas_time_us = esp_timer_get_time();
     }
     return status;
 }
 
 SensorStatus SHT31Sensor::read(SensorData& data) {
-    if (!m_initialized) {
+    if (!m_initialized || m_periodic) {
         return SensorStatus::ERROR_NOT_READY;
     }
     
-    // Wait for measurement if needed
-    uint16_t meas_time = (m_config.precision == 0) ? MEAS_TIME_LOW_MS :
-                         (m_config.precision == 1) ? MEAS_TIME_MED_MS : MEAS_TIME_HIGH_MS;
-    
-    uint32_t elapsed = static_cast<uint32_t>(esp_timer_get_time() / 1000) - m_last_meas_time;
-    if (elapsed < meas_time) {
-        vTaskDelay(pdMS_TO_TICKS(meas_time - elapsed));
-    }
+    // Wait for the conversion with sub-tick resolution: the worst case when
+    // clock stretching, otherwise until polling starts
+    I2CDriver::waitUntil(m_last_meas_time_us + readyOffsetUs());
     
     // Read 6 bytes
     uint8_t read_buf[6];
-    if (I2CDriver::getInstance().read(m_i2c_address, read_buf, 6) != I2CStatus::OK) {
+    I2CStatus i2c_status;
+    if (m_config.poll_ready) {
+        int64_t remaining_us = m_last_meas_time_us + deadlineOffsetUs() - esp_timer_get_time();
+        i2c_status = I2CDriver::getInstance().pollRead(
+            m_i2c_address, read_buf, 6,
+            remaining_us > 0 ? static_cast<uint32_t>(remaining_us) : 0, POLL_INTERVAL_US);
+    } else {
+        i2c_status = I2CDriver::getInstance().read(m_i2c_address, read_buf, 6);
+    }
+    if (i2c_status != I2CStatus::OK) {
         ESP_LOGE(TAG, "I2C read failed");
+        I2CDriver::getInstance().forgetDevice(m_i2c_address);
         return SensorStatus::ERROR_COMM;
     }
     
-    // Verify CRCs
-    if (calculateCRC8(&read_buf[0], 2) != read_buf[2]) {
-        ESP_LOGE(TAG, "Temperature CRC mismatch");
-        return SensorStatus::ERROR_CRC;
+    return decodeMeasurement(read_buf, data);
+}
+
+SensorStatus SHT31Sensor::triggerMeasurementAsync() {
+    if (!m_initialized || m_periodic) {
+        return SensorStatus::ERROR_NOT_READY;
     }
-    if (calculateCRC8(&read_buf[3], 2) != read_buf[5]) {
-        ESP_LOGE(TAG, "Humidity CRC mismatch");
-        return SensorStatus::ERROR_CRC;
+    if (m_async_pending) {
+        return SensorStatus::ERROR_NOT_READY;
     }
     
-    // Convert raw values
-    uint16_t temp_raw = (static_cast<uint16_t>(read_buf[0]) << 8) | read_buf[1];
-    uint16_t hum_raw = (static_cast<uint16_t>(read_buf[3]) << 8) | read_buf[4];
+    uint16_t cmd = measurementCommand();
+    m_async_cmd[0] = static_cast<uint8_t>(cmd >> 8);
+    m_async_cmd[1] = static_cast<uint8_t>(cmd & 0xFF);
     
-    convertRawData(temp_raw, hum_raw, data);
+    // Whole acquisition as one batch: command, conversion wait, 6-byte fetch
+    m_async_ops[0] = I2COp::write(m_i2c_address, m_async_cmd, 2);
+    m_async_ops[1] = I2COp::delayUntil(readyOffsetUs());
+    m_async_ops[2] = m_config.poll_ready
+        ? I2COp::readPoll(m_i2c_address, m_async_buf, 6, deadlineOffsetUs(), POLL_INTERVAL_US)
+        : I2COp::read(m_i2c_address, m_async_buf, 6);
     
-    // Set quality flags
-    data.quality_flags = 0xC0;
-    data.timestamp = static_cast<uint32_t>(esp_timer_get_time() / 1000000);
+    m_async_waiter = xTaskGetCurrentTaskHandle();
+    ulTaskNotifyTake(pdTRUE, 0);  // Drop any stale completion
+    m_async_status = I2CStatus::OK;
+    m_async_pending = true;
+    
+    if (I2CDriver::getInstance().submitBatch(m_async_ops, 3, &SHT31Sensor::onAsyncComplete, this) 
+            != I2CStatus::OK) {
+        m_async_pending = false;
+        return SensorStatus::ERROR_COMM;
+    }
+    
+    m_last_meas_time_us = esp_timer_get_time();
+    return SensorStatus::OK;
+}
+
+SensorStatus SHT31Sensor::awaitMeasurement(SensorData& data) {
+    if (!m_async_pending) {
+        return SensorStatus::ERROR_NOT_READY;
+    }
+    
+    uint32_t timeout_ms = measurementTimeMs() + ASYNC_TIMEOUT_MS;
+    bool completed = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms)) > 0;
+    m_async_pending = false;
+    
+    if (!completed) {
+        ESP_LOGE(TAG, "Async measurement timed out");
+        I2CDriver::getInstance().forgetDevice(m_i2c_address);
+        return SensorStatus::ERROR_TIMEOUT;
+    }
+    
+    if (m_async_status != I2CStatus::OK) {
+        ESP_LOGE(TAG, "Async acquisition failed: command %s, fetch %s",
+                 I2CDriver::statusToString(m_async_ops[0].result),
+                 I2CDriver::statusToString(m_async_ops[2].result));
+        I2CDriver::getInstance().forgetDevice(m_i2c_address);
+        return SensorStatus::ERROR_COMM;
+    }
+    
+    return decodeMeasurement(m_async_buf, data);
+}
+
+SensorStatus SHT31Sensor::startPeriodic(PeriodicRate rate) {
+    if (!m_initialized || m_async_pending) {
+        return SensorStatus::ERROR_NOT_READY;
+    }
+    if (m_periodic) {
+        // The sensor only accepts a new rate from idle
+        SensorStatus status = stopPeriodic();
+        if (status != SensorStatus::OK) {
+            return status;
+        }
+    }
+    
+    SensorStatus status = sendCommand(periodicCommand(rate));
+    if (status != SensorStatus::OK) {
+        ESP_LOGE(TAG, "Failed to start periodic mode");
+        return status;
+    }
+    
+    // First sample completes one conversion after the start command,
+    // the following ones every interval
+    uint32_t now_ms = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+    m_periodic = true;
+    m_periodic_rate = rate;
+    m_next_sample_ms = now_ms + measurementTimeMs() + FETCH_MARGIN_MS;
+    
+    ESP_LOGI(TAG, "Periodic mode started (%u ms interval)", (unsigned)periodicIntervalMs(rate));
+    return SensorStatus::OK;
+}
+
+SensorStatus SHT31Sensor::stopPeriodic() {
+    if (!m_periodic) {
+        return SensorStatus::OK;
+    }
+    
+    SensorStatus status = sendCommand(CMD_BREAK);
+    if (status != SensorStatus::OK) {
+        ESP_LOGE(TAG, "Break command failed");
+        return status;
+    }
+    m_periodic = false;
+    vTaskDelay(pdMS_TO_TICKS(BREAK_TIME_MS));
+    
+    ESP_LOGI(TAG, "Periodic mode stopped");
+    return SensorStatus::OK;
+}
+
+SensorStatus SHT31Sensor::readLatest(SensorData& data) {
+    if (!m_initialized) {
+        return SensorStatus::ERROR_NOT_READY;
+    }
+    if (!m_periodic) {
+        return ISensor::readLatest(data);
+    }
+    
+    // Nothing new before the next scheduled sample: no bus traffic at all
+    uint32_t now_ms = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+    if (static_cast<int32_t>(now_ms - m_next_sample_ms) < 0) {
+        return SensorStatus::ERROR_NOT_READY;
+    }
+    
+    uint8_t cmd_buf[2] = {
+        static_cast<uint8_t>(CMD_FETCH_DATA >> 8),
+        static_cast<uint8_t>(CMD_FETCH_DATA & 0xFF)
+    };
+    uint8_t read_buf[6];
+    I2CStatus i2c_status = I2CDriver::getInstance().pollWriteRead(m_i2c_address, cmd_buf, 2, read_buf, 6);
+    
+    if (i2c_status == I2CStatus::ERROR_NACK_ADDR || i2c_status == I2CStatus::ERROR_NACK_DATA) {
+        // Sample not produced yet (sensor clock runs slightly slow): keep
+        // polling; an early fetch must not step the clock profile down
+        return SensorStatus::ERROR_NOT_READY;
+    }
+    if (i2c_status != I2CStatus::OK) {
+        ESP_LOGE(TAG, "Fetch failed: %s", I2CDriver::statusToString(i2c_status));
+        I2CDriver::getInstance().forgetDevice(m_i2c_address);
+        return SensorStatus::ERROR_COMM;
+    }
+    
+    // Skip any intervals the caller missed; the sensor only keeps the newest sample
+    uint32_t interval_ms = periodicIntervalMs(m_periodic_rate);
+    while (static_cast<int32_t>(now_ms - m_next_sample_ms) >= 0) {
+        m_next_sample_ms += interval_ms;
+    }
+    m_last_meas_time_us = esp_timer_get_time();
+    
+    return decodeMeasurement(read_buf, data);
+}
+
+SensorStatus SHT31Sensor::readBurst(BurstResult& result) {
+    if (!m_initialized || m_periodic) {
+        return SensorStatus::ERROR_NOT_READY;
+    }
+    
+    beginBurst();
+    SensorStatus status = acquireBurst(*this, m_config.burst_samples, m_config.burst_filter, result);
+    endBurst(status == SensorStatus::OK ? &result : nullptr);
     
-    ESP_LOGD(TAG, "Read: %.2f°C, %.1f%% RH", data.temperature_celsius, data.humidity_percent);
+    if (status == SensorStatus::OK && result.valid < result.samples) {
+        ESP_LOGW(TAG, "Burst: %u/%u samples valid (mask 0x%04X)",
+                 result.valid, result.samples, result.sample_mask);
+    }
+    return status;
+}
+
+void SHT31Sensor::beginBurst() {
+    if (m_in_burst) {
+        return;
+    }
+    
+    // Each burst sample runs at the burst repeatability (low by default:
+    // 2.5 ms typical instead of 12.5 ms); the aggregate makes up the noise
+    uint8_t burst_precision = m_config.burst_precision;
+    if (m_config.adaptive_precision) {
+        burst_precision = AdaptivePrecision::select(s_adaptive, NOISE_PROFILE, m_config);
+        if (s_adaptive.observations != 0 && burst_precision != s_adaptive.precision) {
+            ESP_LOGI(TAG, "Burst repeatability %u -> %u", s_adaptive.precision, burst_precision);
+        }
+    }
+    
+    m_single_precision = m_config.precision;
+    m_config.precision = burst_precision;
+    m_in_burst = true;
+}
+
+void SHT31Sensor::endBurst(const BurstResult* result) {
+    if (!m_in_burst) {
+        return;
+    }
+    
+    uint8_t burst_precision = m_config.precision;
+    m_config.precision = m_single_precision;
+    m_in_burst = false;
+    
+    if (result != nullptr && m_config.adaptive_precision) {
+        AdaptivePrecision::observe(s_adaptive, NOISE_PROFILE, burst_precision, *result);
+    }
+}
+
+SensorStatus SHT31Sensor::armAlert(const SensorAlertLimits& limits) {
+    if (!m_initialized || m_async_pending) {
+        return SensorStatus::ERROR_NOT_READY;
+    }
+    if (limits.temp_low_centi_c >= limits.temp_high_centi_c ||
+        limits.hum_low_centi_pct >= limits.hum_high_centi_pct) {
+        return SensorStatus::ERROR_INVALID_PARAM;
+    }
+    
+    // Limit registers are only written from idle
+    SensorStatus status = stopPeriodic();
+    if (status != SensorStatus::OK) {
+        return status;
+    }
+    
+    // The sensor compares uncompensated values: remove the calibration offsets
+    int32_t t_low = limits.temp_low_centi_c - m_config.temp_offset_centi_c;
+    int32_t t_high = limits.temp_high_centi_c - m_config.temp_offset_centi_c;
+    int32_t h_low = static_cast<int32_t>(limits.hum_low_centi_pct) - m_config.hum_offset_centi_pct;
+    int32_t h_high = static_cast<int32_t>(limits.hum_high_centi_pct) - m_config.hum_offset_centi_pct;
     
+    const uint16_t commands[4] = {
+        CMD_ALERT_HIGH_SET, CMD_ALERT_HIGH_CLEAR, CMD_ALERT_LOW_CLEAR, CMD_ALERT_LOW_SET
+    };
+    const uint16_t words[4] = {
+        alertLimitWord(t_high, h_high),
+        alertLimitWord(t_high - limits.temp_hysteresis_centi_c, h_high - limits.hum_hysteresis_centi_pct),
+        alertLimitWord(t_low + limits.temp_hysteresis_centi_c, h_low + limits.hum_hysteresis_centi_pct),
+        alertLimitWord(t_low, h_low)
+    };
+    
+    // All four limits and a status clear in one bus window
+    uint8_t clear_cmd[2] = {
+        static_cast<uint8_t>(CMD_CLEAR_STATUS >> 8),
+        static_cast<uint8_t>(CMD_CLEAR_STATUS & 0xFF)
+    };
+    uint8_t frames[4][5];  // Command, limit word, CRC
+    I2COp ops[5];
+    for (uint8_t i = 0; i < 4; i++) {
+        uint8_t* frame = frames[i];
+        frame[0] = static_cast<uint8_t>(commands[i] >> 8);
+        frame[1] = static_cast<uint8_t>(commands[i] & 0xFF);
+        frame[2] = static_cast<uint8_t>(words[i] >> 8);
+        frame[3] = static_cast<uint8_t>(words[i] & 0xFF);
+        frame[4] = calculateCRC8(&frame[2], 2);
+        ops[i] = I2COp::write(m_i2c_address, frame, 5);
+    }
+    ops[4] = I2COp::write(m_i2c_address, clear_cmd, 2);
+    
+    if (I2CDriver::getInstance().executeBatch(ops, 5) != I2CStatus::OK) {
+        ESP_LOGE(TAG, "Writing alert limits failed");
+        return SensorStatus::ERROR_COMM;
+    }
+    
+    // The ALERT output is only evaluated in periodic mode
+    uint8_t precision = m_config.precision;
+    m_config.precision = ALERT_PRECISION;
+    status = startPeriodic(ALERT_RATE);
+    m_config.precision = precision;
+    if (status != SensorStatus::OK) {
+        return status;
+    }
+    
+    s_alert_armed = true;
+    ESP_LOGI(TAG, "Alert armed: T " CENTI_FMT ".." CENTI_FMT " °C, RH " CENTI_FMT ".." CENTI_FMT " %%",
+             CENTI_ARGS(limits.temp_low_centi_c), CENTI_ARGS(limits.temp_high_centi_c),
+             CENTI_ARGS(limits.hum_low_centi_pct), CENTI_ARGS(limits.hum_high_centi_pct));
     return SensorStatus::OK;
 }
 
+SensorStatus SHT31Sensor::disarmAlert() {
+    if (!s_alert_armed) {
+        return SensorStatus::OK;
+    }
+    
+    SensorStatus status = stopPeriodic();
+    if (status == SensorStatus::OK) {
+        s_alert_armed = false;
+    }
+    return status;
+}
+
 SensorStatus SHT31Sensor::sleep() {
     // SHT31 auto-sleeps
     return SensorStatus::OK;
@@ -146,12 +449,16 @@ SensorStatus SHT31Sensor::selfTest() {
         return SensorStatus::ERROR_NOT_READY;
     }
     
-    if (sendCommand(CMD_READ_STATUS) != SensorStatus::OK) {
-        return SensorStatus::ERROR_COMM;
-    }
-    
+    uint8_t cmd_buf[2] = {
+        static_cast<uint8_t>(CMD_READ_STATUS >> 8),
+        static_cast<uint8_t>(CMD_READ_STATUS & 0xFF)
+    };
     uint8_t status_buf[3];
-    if (I2CDriver::getInstance().read(m_i2c_address, status_buf, 3) != I2CStatus::OK) {
+    I2COp ops[] = {
+        I2COp::write(m_i2c_address, cmd_buf, 2),
+        I2COp::read(m_i2c_address, status_buf, 3)
+    };
+    if (I2CDriver::getInstance().executeBatch(ops, 2) != I2CStatus::OK) {
         return SensorStatus::ERROR_COMM;
     }
     
@@ -166,6 +473,10 @@ SensorStatus SHT31Sensor::selfTest() {
 }
 
 SensorStatus SHT31Sensor::reset() {
+    if (m_periodic) {
+        stopPeriodic();
+    }
+    
     SensorStatus status = sendCommand(CMD_SOFT_RESET);
     if (status == SensorStatus::OK) {
         vTaskDelay(pdMS_TO_TICKS(RESET_TIME_MS));
@@ -185,18 +496,21 @@ SensorStatus SHT31Sensor::configure(const SensorConfig& config) {
 }
 
 const SensorInfo& SHT31Sensor::getInfo() const {
-    static const SensorInfo info = {
+    static constexpr SensorInfo info = {
         .name = "SHT31",
         .manufacturer = "Sensirion",
-        .temp_min = -40.0f,
-        .temp_max = 125.0f,
-        .hum_min = 0.0f,
-        .hum_max = 100.0f,
-        .temp_accuracy = 0.3f,
-        .hum_accuracy = 2.0f,
+        .temp_min_centi_c = -4000,
+        .temp_max_centi_c = 12500,
+        .hum_min_centi_pct = 0,
+        .hum_max_centi_pct = 10000,
+        .temp_accuracy_centi_c = 30,
+        .hum_accuracy_centi_pct = 200,
         .measurement_time_ms = 15,
+        .startup_time_ms = 2,       // tPU 1.5 ms max
+        .reset_time_ms = 0,         // Powers up idle in single-shot mode
+        .first_conversion_ms = 0,
         .power_active_ua = 800,
-        .power_sleep_ua = 0
+        .power_sleep_na = 200       // Idle, single-shot mode (typ.)
     };
     
     return info;
@@ -234,19 +548,107 @@ SensorStatus SHT31Sensor::sendCommand(uint16_t command) {
     return SensorStatus::OK;
 }
 
-void SHT31Sensor::convertRawData(uint16_t temp_raw, uint16_t hum_raw, SensorData& data) {
-    // Temperature conversion
-    data.temperature_celsius = -45.0f + 175.0f * (static_cast<float>(temp_raw) / 65535.0f);
+uint16_t SHT31Sensor::measurementCommand() const {
+    // Select command based on precision; polling needs the no-stretch family
+    if (m_config.poll_ready) {
+        switch (m_config.precision) {
+            case 0:  return CMD_MEAS_NOSTRETCH_LOW;
+            case 1:  return CMD_MEAS_NOSTRETCH_MED;
+            default: return CMD_MEAS_NOSTRETCH_HIGH;
+        }
+    }
+    switch (m_config.precision) {
+        case 0:  return CMD_MEAS_LOW;
+        case 1:  return CMD_MEAS_MED;
+        case 2:  return CMD_MEAS_HIGH;
+        default: return CMD_MEAS_HIGH;
+    }
+}
+
+uint16_t SHT31Sensor::measurementTimeMs() const {
+    return (m_config.precision == 0) ? MEAS_TIME_LOW_MS :
+           (m_config.precision == 1) ? MEAS_TIME_MED_MS : MEAS_TIME_HIGH_MS;
+}
+
+uint32_t SHT31Sensor::readyOffsetUs() const {
+    if (!m_config.poll_ready) {
+        return static_cast<uint32_t>(measurementTimeMs()) * 1000;
+    }
+    uint32_t typical_us = (m_config.precision == 0) ? MEAS_TYP_LOW_US :
+                          (m_config.precision == 1) ? MEAS_TYP_MED_US : MEAS_TYP_HIGH_US;
+    return typical_us - POLL_LEAD_US;
+}
+
+uint32_t SHT31Sensor::deadlineOffsetUs() const {
+    return static_cast<uint32_t>(measurementTimeMs()) * 1000 + POLL_INTERVAL_US;
+}
+
+uint16_t SHT31Sensor::periodicCommand(PeriodicRate rate) const {
+    if (rate == PeriodicRate::ART) {
+        return CMD_ART;
+    }
+    uint8_t precision = (m_config.precision <= 2) ? m_config.precision : 2;
+    return CMD_PERIODIC[static_cast<uint8_t>(rate)][precision];
+}
+
+uint32_t SHT31Sensor::periodicIntervalMs(PeriodicRate rate) {
+    switch (rate) {
+        case PeriodicRate::MPS_0_5: return 2000;
+        case PeriodicRate::MPS_1:   return 1000;
+        case PeriodicRate::MPS_2:   return 500;
+        case PeriodicRate::MPS_4:   return 250;
+        case PeriodicRate::MPS_10:  return 100;
+        case PeriodicRate::ART:     return 250;
+        default:                    return 1000;
+    }
+}
+
+SensorStatus SHT31Sensor::decodeMeasurement(const uint8_t* buf, SensorData& data) {
+    // Verify CRCs
+    if (calculateCRC8(&buf[0], 2) != buf[2]) {
+        ESP_LOGE(TAG, "Temperature CRC mismatch");
+        return SensorStatus::ERROR_CRC;
+    }
+    if (calculateCRC8(&buf[3], 2) != buf[5]) {
+        ESP_LOGE(TAG, "Humidity CRC mismatch");
+        return SensorStatus::ERROR_CRC;
+    }
     
-    // Humidity conversion
-    data.humidity_percent = 100.0f * (static_cast<float>(hum_raw) / 65535.0f);
+    // Convert raw values
+    uint16_t temp_raw = (static_cast<uint16_t>(buf[0]) << 8) | buf[1];
+    uint16_t hum_raw = (static_cast<uint16_t>(buf[3]) << 8) | buf[4];
     
-    // Apply calibration offsets
-    data.temperature_celsius += m_config.temp_offset_celsius;
-    data.humidity_percent += m_config.hum_offset_percent;
+    convertRawData(temp_raw, hum_raw, data);
+    
+    // Set quality flags
+    data.quality_flags = 0xC0;
+    data.timestamp = static_cast<uint32_t>(esp_timer_get_time() / 1000000);
+    
+    ESP_LOGD(TAG, "Read: " CENTI_FMT "°C, " CENTI_FMT "%% RH",
+             CENTI_ARGS(data.temperature_centi_c), CENTI_ARGS(data.humidity_centi_pct));
+    
+    return SensorStatus::OK;
+}
+
+void SHT31Sensor::onAsyncComplete(I2CStatus status, void* context) {
+    // Runs in the I2C worker task
+    SHT31Sensor* self = static_cast<SHT31Sensor*>(context);
+    self->m_async_status = status;
+    if (self->m_async_waiter != nullptr) {
+        xTaskNotifyGive(self->m_async_waiter);
+    }
+}
+
+void SHT31Sensor::convertRawData(uint16_t temp_raw, uint16_t hum_raw, SensorData& data) {
+    // Integer conversion plus calibration offsets (no soft-float)
+    int32_t temperature = rawToCentiCelsius(temp_raw) + m_config.temp_offset_centi_c;
+    int32_t humidity = rawToCentiPercent(hum_raw) + m_config.hum_offset_centi_pct;
     
     // Clamp humidity
-    if (data.humidity_percent < 0.0f) data.humidity_percent = 0.0f;
-    if (data.humidity_percent > 100.0f) data.humidity_percent = 100.0f;
+    if (humidity < 0) humidity = 0;
+    if (humidity > 10000) humidity = 10000;
+    
+    data.temperature_centi_c = static_cast<int16_t>(temperature);
+    data.humidity_centi_pct = static_cast<uint16_t>(humidity);
 }
 
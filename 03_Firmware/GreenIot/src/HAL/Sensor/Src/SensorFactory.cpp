@@ -7,30 +7,42 @@
  */
 
 #include "ISensor.hpp"
+#include "SensorBinding.hpp"
 #include "SHT31Sensor.hpp"
-// #include "AHT20Sensor.hpp"  // Add when implemented
+#include "AHT20Sensor.hpp"
 
-#include <map>
-#include <functional>
-#include <memory>
+#include <cstring>
 
-std::unique_ptr<ISensor> SensorFactory::create(const std::string& name) {
-    // Simple factory implementation (compatible with C++11)
-    if (name == "SHT31") {
-        return std::unique_ptr<ISensor>(new SHT31Sensor());
+struct SensorRegistryEntry {
+    const char* name;
+    ISensor* (*instance)();
+};
+
+static constexpr SensorRegistryEntry SENSOR_REGISTRY[] = {
+    {"SHT31", &SensorBinding<SHT31Sensor>::dynamicInstance},
+    {"AHT20", &SensorBinding<AHT20Sensor>::dynamicInstance},
+};
+
+static constexpr size_t SENSOR_COUNT = sizeof(SENSOR_REGISTRY) / sizeof(SENSOR_REGISTRY[0]);
+
+ISensor* SensorFactory::create(const char* name) {
+    if (name == nullptr) {
+        return nullptr;
+    }
+    
+    for (size_t i = 0; i < SENSOR_COUNT; i++) {
+        if (strcmp(name, SENSOR_REGISTRY[i].name) == 0) {
+            return SENSOR_REGISTRY[i].instance();
+        }
     }
-    // Add more sensors here when implemented
-    // if (name == "AHT20") {
-    //     return std::unique_ptr<ISensor>(new AHT20Sensor());
-    // }
     
     return nullptr;
 }
 
-std::vector<std::string> SensorFactory::getAvailableSensors() {
-    return {
-        "SHT31",
-        // "AHT20",  // Add when implemented
-    };
+size_t SensorFactory::getSensorCount() {
+    return SENSOR_COUNT;
 }
 
+const char* SensorFactory::getSensorName(size_t index) {
+    return (index < SENSOR_COUNT) ? SENSOR_REGISTRY[index].name : nullptr;
+}
@@ -0,0 +1,336 @@
+/**
+ * @file SensorGroup.cpp
+ * @brief Multi-sensor acquisition group implementation
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#include "SensorGroup.hpp"
+#include "esp_log.h"
+
+static const char* TAG = "SENSOR_GROUP";
+
+SensorGroup::SensorGroup()
+    : m_members{}
+    , m_member_data{}
+    , m_count(0)
+    , m_active_mask(0)
+    , m_selected_mask(0xFF)
+    , m_triggered_mask(0)
+    , m_valid_mask(0)
+    , m_info()
+{
+    updateInfo();
+}
+
+bool SensorGroup::add(ISensor* sensor) {
+    if (sensor == nullptr || sensor == this || m_count >= SENSOR_GROUP_MAX_MEMBERS) {
+        return false;
+    }
+    for (uint8_t i = 0; i < m_count; i++) {
+        if (m_members[i] == sensor) return false;
+    }
+    
+    m_members[m_count++] = sensor;
+    updateInfo();
+    return true;
+}
+
+void SensorGroup::clear() {
+    m_count = 0;
+    m_active_mask = 0;
+    m_selected_mask = 0xFF;
+    m_triggered_mask = 0;
+    m_valid_mask = 0;
+    updateInfo();
+}
+
+SensorStatus SensorGroup::init() {
+    m_active_mask = 0;
+    for (uint8_t i = 0; i < m_count; i++) {
+        if (m_members[i]->init() == SensorStatus::OK) {
+            m_active_mask |= static_cast<uint8_t>(1U << i);
+        } else {
+            ESP_LOGW(TAG, "Member %s failed to initialise, continuing without it",
+                     m_members[i]->getInfo().name);
+        }
+    }
+    
+    if (m_active_mask == 0) {
+        return SensorStatus::ERROR_INIT;
+    }
+    ESP_LOGI(TAG, "Sensor group: %u of %u members active (mask 0x%02X)",
+             __builtin_popcount(m_active_mask), m_count, m_active_mask);
+    return SensorStatus::OK;
+}
+
+SensorStatus SensorGroup::deinit() {
+    for (uint8_t i = 0; i < m_count; i++) {
+        m_members[i]->deinit();
+    }
+    m_active_mask = 0;
+    return SensorStatus::OK;
+}
+
+SensorStatus SensorGroup::triggerMeasurement() {
+    // Start every conversion before waiting for any of them
+    SensorStatus last_error = SensorStatus::ERROR_NOT_READY;
+    m_triggered_mask = 0;
+    for (uint8_t i = 0; i < m_count; i++) {
+        uint8_t bit = static_cast<uint8_t>(1U << i);
+        if (!(m_active_mask & m_selected_mask & bit)) continue;
+        
+        SensorStatus status = m_members[i]->triggerMeasurement();
+        if (status == SensorStatus::OK) {
+            m_triggered_mask |= bit;
+        } else {
+            last_error = status;
+        }
+    }
+    return (m_triggered_mask != 0) ? SensorStatus::OK : last_error;
+}
+
+SensorStatus SensorGroup::read(SensorData& data) {
+    SensorStatus last_error = SensorStatus::ERROR_NOT_READY;
+    m_valid_mask = collect(m_member_data, last_error);
+    if (m_valid_mask == 0) {
+        return last_error;
+    }
+    return merge(data);
+}
+
+SensorStatus SensorGroup::readBurst(BurstResult& result) {
+    uint8_t rounds = m_config.burst_samples;
+    result.sample_mask = 0;
+    result.samples = rounds;
+    result.valid = 0;
+    result.temp_variance_q4 = 0;  // Members are aggregated separately
+    result.hum_variance_q4 = 0;
+    if (rounds == 0 || rounds > SENSOR_BURST_MAX_SAMPLES) {
+        return SensorStatus::ERROR_INVALID_PARAM;
+    }
+    
+    int32_t temperatures[SENSOR_GROUP_MAX_MEMBERS][SENSOR_BURST_MAX_SAMPLES];
+    int32_t humidities[SENSOR_GROUP_MAX_MEMBERS][SENSOR_BURST_MAX_SAMPLES];
+    uint8_t counts[SENSOR_GROUP_MAX_MEMBERS] = {0};
+    uint16_t masks[SENSOR_GROUP_MAX_MEMBERS] = {0};
+    SensorData samples[SENSOR_GROUP_MAX_MEMBERS];
+    SensorStatus last_error = SensorStatus::ERROR_NOT_READY;
+    
+    // Each round overlaps the members' conversions, each at its burst precision
+    for (uint8_t i = 0; i < m_count; i++) {
+        if (m_active_mask & m_selected_mask & (1U << i)) {
+            m_members[i]->beginBurst();
+        }
+    }
+    for (uint8_t round = 0; round < rounds; round++) {
+        uint8_t valid = 0;
+        if (triggerMeasurement() == SensorStatus::OK) {
+            valid = collect(samples, last_error);
+        }
+        for (uint8_t i = 0; i < m_count; i++) {
+            if (!(valid & (1U << i))) continue;
+            temperatures[i][counts[i]] = samples[i].temperature_centi_c;
+            humidities[i][counts[i]] = samples[i].humidity_centi_pct;
+            m_member_data[i].timestamp = samples[i].timestamp;
+            masks[i] |= static_cast<uint16_t>(1U << round);
+            counts[i]++;
+        }
+        if (valid != 0) {
+            result.sample_mask |= static_cast<uint16_t>(1U << round);
+            result.valid++;
+        }
+    }
+    
+    // A member counts if a majority of its own samples was valid; each
+    // member's own aggregate goes back to its precision selector
+    m_valid_mask = 0;
+    for (uint8_t i = 0; i < m_count; i++) {
+        if (!(m_active_mask & m_selected_mask & (1U << i))) continue;
+        if (counts[i] * 2 <= rounds) {
+            m_members[i]->endBurst(nullptr);
+            continue;
+        }
+        
+        BurstResult member;
+        member.sample_mask = masks[i];
+        member.samples = rounds;
+        member.valid = counts[i];
+        member.temp_variance_q4 = SensorFilter::successiveVarianceQ4(temperatures[i], counts[i]);
+        member.hum_variance_q4 = SensorFilter::successiveVarianceQ4(humidities[i], counts[i]);
+        member.data = m_member_data[i];
+        member.data.temperature_centi_c = static_cast<int16_t>(
+            SensorFilter::apply(m_config.burst_filter, temperatures[i], counts[i]));
+        member.data.humidity_centi_pct = static_cast<uint16_t>(
+            SensorFilter::apply(m_config.burst_filter, humidities[i], counts[i]));
+        member.data.quality_flags = 0xC0;
+        m_members[i]->endBurst(&member);
+        
+        m_member_data[i] = member.data;
+        m_valid_mask |= static_cast<uint8_t>(1U << i);
+    }
+    
+    if (m_valid_mask == 0) {
+        return last_error;
+    }
+    if (m_valid_mask != (m_active_mask & m_selected_mask)) {
+        ESP_LOGW(TAG, "Burst: members 0x%02X of 0x%02X valid", m_valid_mask,
+                 m_active_mask & m_selected_mask);
+    }
+    return merge(result.data);
+}
+
+SensorStatus SensorGroup::armAlert(const SensorAlertLimits& limits) {
+    // Any member with an alert output can wake the node
+    bool armed = false;
+    for (uint8_t i = 0; i < m_count; i++) {
+        if ((m_active_mask & (1U << i)) && m_members[i]->armAlert(limits) == SensorStatus::OK) {
+            armed = true;
+        }
+    }
+    return armed ? SensorStatus::OK : SensorStatus::ERROR_INVALID_PARAM;
+}
+
+SensorStatus SensorGroup::disarmAlert() {
+    SensorStatus result = SensorStatus::OK;
+    for (uint8_t i = 0; i < m_count; i++) {
+        SensorStatus status = m_members[i]->disarmAlert();
+        if (status != SensorStatus::OK) result = status;
+    }
+    return result;
+}
+
+SensorStatus SensorGroup::sleep() {
+    SensorStatus result = SensorStatus::OK;
+    for (uint8_t i = 0; i < m_count; i++) {
+        SensorStatus status = m_members[i]->sleep();
+        if (status != SensorStatus::OK) result = status;
+    }
+    return result;
+}
+
+SensorStatus SensorGroup::wakeup() {
+    SensorStatus result = SensorStatus::OK;
+    for (uint8_t i = 0; i < m_count; i++) {
+        SensorStatus status = m_members[i]->wakeup();
+        if (status != SensorStatus::OK) result = status;
+    }
+    return result;
+}
+
+SensorStatus SensorGroup::selfTest() {
+    SensorStatus result = SensorStatus::OK;
+    for (uint8_t i = 0; i < m_count; i++) {
+        if (!(m_active_mask & (1U << i))) continue;
+        SensorStatus status = m_members[i]->selfTest();
+        if (status != SensorStatus::OK) result = status;
+    }
+    return result;
+}
+
+SensorStatus SensorGroup::reset() {
+    SensorStatus result = SensorStatus::OK;
+    for (uint8_t i = 0; i < m_count; i++) {
+        SensorStatus status = m_members[i]->reset();
+        if (status != SensorStatus::OK) result = status;
+    }
+    return result;
+}
+
+SensorStatus SensorGroup::configure(const SensorConfig& config) {
+    m_config = config;
+    SensorStatus result = SensorStatus::OK;
+    for (uint8_t i = 0; i < m_count; i++) {
+        SensorStatus status = m_members[i]->configure(config);
+        if (status != SensorStatus::OK) result = status;
+    }
+    return result;
+}
+
+// Private helper methods
+
+uint8_t SensorGroup::collect(SensorData* samples, SensorStatus& last_error) {
+    // Members finish in any order; read() waits for each one's own conversion
+    uint8_t valid = 0;
+    for (uint8_t i = 0; i < m_count; i++) {
+        uint8_t bit = static_cast<uint8_t>(1U << i);
+        if (!(m_triggered_mask & bit)) continue;
+        
+        SensorStatus status = m_members[i]->read(samples[i]);
+        if (status == SensorStatus::OK && !inRange(samples[i], m_members[i]->getInfo())) {
+            status = SensorStatus::ERROR_OUT_OF_RANGE;
+        }
+        if (status == SensorStatus::OK) {
+            valid |= bit;
+        } else {
+            last_error = status;
+            ESP_LOGW(TAG, "Member %s: %s", m_members[i]->getInfo().name, ISensor::statusToString(status));
+        }
+    }
+    m_triggered_mask = 0;
+    return valid;
+}
+
+SensorStatus SensorGroup::merge(SensorData& data) {
+    int32_t temperatures[SENSOR_GROUP_MAX_MEMBERS];
+    int32_t humidities[SENSOR_GROUP_MAX_MEMBERS];
+    uint8_t count = 0;
+    uint32_t timestamp = 0;
+    
+    for (uint8_t i = 0; i < m_count; i++) {
+        if (!(m_valid_mask & (1U << i))) continue;
+        temperatures[count] = m_member_data[i].temperature_centi_c;
+        humidities[count] = m_member_data[i].humidity_centi_pct;
+        if (m_member_data[i].timestamp > timestamp) timestamp = m_member_data[i].timestamp;
+        count++;
+    }
+    
+    data.temperature_centi_c = static_cast<int16_t>(SensorFilter::median(temperatures, count));
+    data.humidity_centi_pct = static_cast<uint16_t>(SensorFilter::median(humidities, count));
+    data.timestamp = timestamp;
+    data.quality_flags = 0xC0;
+    return SensorStatus::OK;
+}
+
+void SensorGroup::updateInfo() {
+    m_info.name = "SensorGroup";
+    m_info.manufacturer = (m_count > 0) ? m_members[0]->getInfo().manufacturer : "";
+    m_info.temp_min_centi_c = INT16_MIN;
+    m_info.temp_max_centi_c = INT16_MAX;
+    m_info.hum_min_centi_pct = 0;
+    m_info.hum_max_centi_pct = 10000;
+    m_info.temp_accuracy_centi_c = 0;
+    m_info.hum_accuracy_centi_pct = 0;
+    m_info.measurement_time_ms = 0;
+    m_info.startup_time_ms = 0;
+    m_info.reset_time_ms = 0;
+    m_info.first_conversion_ms = 0;
+    m_info.power_active_ua = 0;
+    m_info.power_sleep_na = 0;
+    
+    for (uint8_t i = 0; i < m_count; i++) {
+        const SensorInfo& info = m_members[i]->getInfo();
+        if (info.temp_min_centi_c > m_info.temp_min_centi_c) m_info.temp_min_centi_c = info.temp_min_centi_c;
+        if (info.temp_max_centi_c < m_info.temp_max_centi_c) m_info.temp_max_centi_c = info.temp_max_centi_c;
+        if (info.hum_min_centi_pct > m_info.hum_min_centi_pct) m_info.hum_min_centi_pct = info.hum_min_centi_pct;
+        if (info.hum_max_centi_pct < m_info.hum_max_centi_pct) m_info.hum_max_centi_pct = info.hum_max_centi_pct;
+        if (info.temp_accuracy_centi_c > m_info.temp_accuracy_centi_c) m_info.temp_accuracy_centi_c = info.temp_accuracy_centi_c;
+        if (info.hum_accuracy_centi_pct > m_info.hum_accuracy_centi_pct) m_info.hum_accuracy_centi_pct = info.hum_accuracy_centi_pct;
+        // Conversions and power-up overlap: the windows are the slowest member's, the currents the sum
+        if (info.measurement_time_ms > m_info.measurement_time_ms) m_info.measurement_time_ms = info.measurement_time_ms;
+        if (info.startup_time_ms > m_info.startup_time_ms) m_info.startup_time_ms = info.startup_time_ms;
+        if (info.reset_time_ms > m_info.reset_time_ms) m_info.reset_time_ms = info.reset_time_ms;
+        if (info.first_conversion_ms > m_info.first_conversion_ms) m_info.first_conversion_ms = info.first_conversion_ms;
+        m_info.power_active_ua += info.power_active_ua;
+        m_info.power_sleep_na += info.power_sleep_na;
+    }
+}
+
+bool SensorGroup::inRange(const SensorData& data, const SensorInfo& info) {
+    return data.isValid() &&
+           data.temperature_centi_c >= info.temp_min_centi_c &&
+           data.temperature_centi_c <= info.temp_max_centi_c &&
+           data.humidity_centi_pct >= info.hum_min_centi_pct &&
+           data.humidity_centi_pct <= info.hum_max_centi_pct;
+}
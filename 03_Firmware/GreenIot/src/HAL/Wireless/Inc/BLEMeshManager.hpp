@@ -23,9 +23,17 @@ enum class BLEMeshStatus {
     ERROR_PROVISION,
     ERROR_SEND,
     ERROR_NOT_PROVISIONED,
-    ERROR_INVALID_PARAM
+    ERROR_INVALID_PARAM,
+    ERROR_NOT_SUPPORTED
 };
 
+/**
+ * @brief Called once a publication has been handed to the radio
+ * 
+ * Runs in the mesh stack's context: keep it short (e.g. notify a task).
+ */
+typedef void (*BLEMeshPublishCallback)(BLEMeshStatus status, void* arg);
+
 /**
  * @brief Provisioning methods
  */
@@ -50,16 +58,6 @@ struct BLEMeshConfig {
         , enable_lpn(true) {}
 };
 
-/**
- * @brief Sensor data packet for BLE Mesh
- */
-struct MeshSensorData {
-    float temperature;
-    float humidity;
-    uint32_t timestamp;
-    uint8_t battery_percent;
-};
-
 /**
  * @brief BLE Mesh Manager (Singleton)
  */
@@ -103,11 +101,28 @@ public:
     uint16_t getUnicastAddress() const { return m_unicast_addr; }
     
     /**
-     * @brief Send sensor data via BLE Mesh
-     * @param data Sensor data to send
+     * @brief Publish a Sensor Status message via BLE Mesh
+     * @param payload Marshalled sensor properties (MeshEncodeStage)
+     * @param length Payload length in bytes
      * @return Status code
      */
-    BLEMeshStatus sendSensorData(const MeshSensorData& data);
+    BLEMeshStatus publishSensorStatus(const uint8_t* payload, uint8_t length);
+    
+    /**
+     * @brief Publish kept readings in one message (segmented as needed)
+     * @param payload Batch payload (MeasurementBatch::encode())
+     * @param length Payload length in bytes
+     * @return ERROR_NOT_SUPPORTED until the vendor model carrying it exists
+     *         (no publish callback, so the readings stay in the batch)
+     */
+    BLEMeshStatus publishSensorBatch(const uint8_t* payload, uint16_t length);
+    
+    /**
+     * @brief Register the publish-complete callback (nullptr to clear)
+     * 
+     * Not called if publishSensorStatus() itself returns an error.
+     */
+    void setPublishCallback(BLEMeshPublishCallback callback, void* arg);
     
     /**
      * @brief Get mesh status as string
@@ -118,12 +133,16 @@ private:
     BLEMeshManager() 
         : m_initialized(false)
         , m_is_provisioned(false)
-        , m_unicast_addr(0) {}
+        , m_unicast_addr(0)
+        , m_publish_callback(nullptr)
+        , m_publish_callback_arg(nullptr) {}
     ~BLEMeshManager() = default;
     
     bool m_initialized;
     bool m_is_provisioned;
     uint16_t m_unicast_addr;
+    BLEMeshPublishCallback m_publish_callback;
+    void* m_publish_callback_arg;
     BLEMeshConfig m_config;
     uint8_t m_node_uuid[16];
     
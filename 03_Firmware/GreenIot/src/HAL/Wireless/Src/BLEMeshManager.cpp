@@ -7,7 +7,9 @@
  */
 
 #include "BLEMeshManager.hpp"
+#include "WakeTrace.hpp"
 #include "esp_log.h"
+#include "fixed_point.h"
 #include "esp_bt.h"
 #include "esp_bt_main.h"
 #include "esp_ble_mesh_defs.h"
@@ -18,6 +20,7 @@
 #include "esp_ble_mesh_sensor_model_api.h"
 #include "esp_ble_mesh_local_data_operation_api.h"
 #include "esp_mac.h"
+#include "nvs_flash.h"
 #include <cstring>
 
 static const char* TAG = "BLE_MESH";
@@ -117,34 +120,67 @@ void BLEMeshManager::getNodeUUID(uint8_t* uuid) const {
     }
 }
 
-BLEMeshStatus BLEMeshManager::sendSensorData(const MeshSensorData& data) {
+BLEMeshStatus BLEMeshManager::publishSensorStatus(const uint8_t* payload, uint8_t length) {
     if (!m_initialized) {
         ESP_LOGE(TAG, "BLE Mesh not initialized");
         return BLEMeshStatus::ERROR_INIT;
     }
     
+    if (payload == nullptr || length == 0) {
+        return BLEMeshStatus::ERROR_INVALID_PARAM;
+    }
+    
     if (!m_is_provisioned) {
         ESP_LOGW(TAG, "Node not provisioned yet - cannot send data");
         return BLEMeshStatus::ERROR_NOT_PROVISIONED;
     }
     
-    ESP_LOGI(TAG, "Sending sensor data via BLE Mesh:");
-    ESP_LOGI(TAG, "  Temperature: %.2f °C", data.temperature);
-    ESP_LOGI(TAG, "  Humidity: %.1f %%", data.humidity);
-    ESP_LOGI(TAG, "  Battery: %d %%", data.battery_percent);
-    ESP_LOGI(TAG, "  Timestamp: %u", (unsigned)data.timestamp);
+    ESP_LOGI(TAG, "Publishing Sensor Status (%u bytes)", length);
+    ESP_LOG_BUFFER_HEX_LEVEL(TAG, payload, length, ESP_LOG_DEBUG);
     
     // TODO: Implement actual BLE Mesh sensor model publication
     // This would involve:
-    // 1. Packing data into BLE Mesh sensor format
-    // 2. Publishing to configured group/address
-    // 3. Handling retries and acknowledgments
+    // 1. Publishing the payload as SENSOR_STATUS to the configured group/address
+    // 2. Handling retries and acknowledgments
+    // 3. Calling m_publish_callback from the model's publish-complete event
+    //    instead of here
     
     ESP_LOGI(TAG, "Data sent successfully (unicast: 0x%04X)", m_unicast_addr);
     
+    if (m_publish_callback != nullptr) {
+        m_publish_callback(BLEMeshStatus::OK, m_publish_callback_arg);
+    }
+    
     return BLEMeshStatus::OK;
 }
 
+BLEMeshStatus BLEMeshManager::publishSensorBatch(const uint8_t* payload, uint16_t length) {
+    if (!m_initialized) {
+        ESP_LOGE(TAG, "BLE Mesh not initialized");
+        return BLEMeshStatus::ERROR_INIT;
+    }
+    
+    // Largest access payload of a segmented message
+    if (payload == nullptr || length == 0 || length > 380) {
+        return BLEMeshStatus::ERROR_INVALID_PARAM;
+    }
+    
+    if (!m_is_provisioned) {
+        ESP_LOGW(TAG, "Node not provisioned yet - batch kept");
+        return BLEMeshStatus::ERROR_NOT_PROVISIONED;
+    }
+    
+    // No vendor model to carry the batch yet: report it unsent rather than
+    // complete, so the caller falls back to a Sensor Status
+    ESP_LOGD(TAG, "Batch publication not supported (%u bytes)", length);
+    return BLEMeshStatus::ERROR_NOT_SUPPORTED;
+}
+
+void BLEMeshManager::setPublishCallback(BLEMeshPublishCallback callback, void* arg) {
+    m_publish_callback = callback;
+    m_publish_callback_arg = arg;
+}
+
 const char* BLEMeshManager::statusToString(BLEMeshStatus status) {
     switch (status) {
         case BLEMeshStatus::OK: return "OK";
@@ -153,6 +189,7 @@ const char* BLEMeshManager::statusToString(BLEMeshStatus status) {
         case BLEMeshStatus::ERROR_SEND: return "Send Error";
         case BLEMeshStatus::ERROR_NOT_PROVISIONED: return "Not Provisioned";
         case BLEMeshStatus::ERROR_INVALID_PARAM: return "Invalid Parameter";
+        case BLEMeshStatus::ERROR_NOT_SUPPORTED: return "Not Supported";
         default: return "Unknown Error";
     }
 }
@@ -182,10 +219,26 @@ void BLEMeshManager::generateNodeUUID() {
 }
 
 BLEMeshStatus BLEMeshManager::initBLEStack() {
+    // NVS holds the controller calibration and the mesh credentials; only
+    // the radio needs it, so measure-only wakes never touch the flash
+    TRACE_BEGIN(TracePoint::NVS_INIT);
+    esp_err_t err = nvs_flash_init();
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        ESP_LOGW(TAG, "Erasing NVS...");
+        err = nvs_flash_erase();
+        if (err == ESP_OK) err = nvs_flash_init();
+    }
+    TRACE_END(TracePoint::NVS_INIT);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "NVS init failed: %d", err);
+        return BLEMeshStatus::ERROR_INIT;
+    }
+    
     ESP_LOGI(TAG, "Initializing BLE controller...");
+    TRACE_SCOPE(TracePoint::BLE_STACK);
     
     // Release classic BT memory (we only need BLE)
-    esp_err_t err = esp_bt_controller_mem_release(ESP_BT_MODE_CLASSIC_BT);
+    err = esp_bt_controller_mem_release(ESP_BT_MODE_CLASSIC_BT);
     if (err != ESP_OK) {
         ESP_LOGW(TAG, "BT memory release failed: %d (may be already released)", err);
     }
@@ -206,6 +259,7 @@ BLEMeshStatus BLEMeshManager::initBLEStack() {
     }
     
     // Initialize Bluedroid
+    TRACE_INSTANT(TracePoint::BLUEDROID, 0);
     err = esp_bluedroid_init();
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Bluedroid init failed: %d", err);
@@ -224,6 +278,7 @@ BLEMeshStatus BLEMeshManager::initBLEStack() {
 
 BLEMeshStatus BLEMeshManager::initMeshStack() {
     ESP_LOGI(TAG, "Initializing BLE Mesh stack...");
+    TRACE_SCOPE(TracePoint::MESH_INIT);
     
     // Initialize BLE Mesh
     esp_err_t err = esp_ble_mesh_init(nullptr, nullptr);
@@ -14,6 +14,7 @@
  */
 
 #include "HAL/Wireless/ble_mesh_interface.h"
+#include "fixed_point.h"
 #include "esp_log.h"
 #include "esp_system.h"
 #include "esp_timer.h"
@@ -45,10 +46,10 @@ static uint32_t g_last_publish_time = 0;
 // ============================================================================
 
 static void generate_uuid_from_mac(uint8_t *uuid);
-static void encode_temperature(float temp_celsius, uint8_t *buffer, uint8_t *len);
-static void encode_humidity(float humidity_percent, uint8_t *buffer, uint8_t *len);
-static float decode_temperature(const uint8_t *buffer);
-static float decode_humidity(const uint8_t *buffer);
+static void encode_temperature(int16_t temp_centi_c, uint8_t *buffer, uint8_t *len);
+static void encode_humidity(uint16_t humidity_centi_pct, uint8_t *buffer, uint8_t *len);
+static int16_t decode_temperature(const uint8_t *buffer);
+static uint16_t decode_humidity(const uint8_t *buffer);
 static void log_mesh_configuration(void);
 
 // ============================================================================
@@ -186,26 +187,28 @@ ble_mesh_err_t ble_mesh_publish_sensor_data(const mesh_sensor_data_t *data) {
     // Encode temperature (Property ID 0x004F: Temperature 8)
     uint8_t temp_buffer[4];
     uint8_t temp_len;
-    encode_temperature(data->temperature_celsius, temp_buffer, &temp_len);
+    encode_temperature(data->temperature_centi_c, temp_buffer, &temp_len);
+    int16_t temp_decoded = decode_temperature(temp_buffer);
     
     ESP_LOGI(TAG, "Temperature Property:");
     ESP_LOGI(TAG, "  Property ID: 0x%04X (Temperature 8)", BLE_MESH_PROP_ID_TEMPERATURE);
-    ESP_LOGI(TAG, "  Value: %.2f°C", data->temperature_celsius);
-    ESP_LOGI(TAG, "  Encoded: 0x%02X%02X (%.2f°C)", 
+    ESP_LOGI(TAG, "  Value: " CENTI_FMT "°C", CENTI_ARGS(data->temperature_centi_c));
+    ESP_LOGI(TAG, "  Encoded: 0x%02X%02X (" CENTI_FMT "°C)", 
              temp_buffer[0], temp_buffer[1], 
-             decode_temperature(temp_buffer));
+             CENTI_ARGS(temp_decoded));
     
     // Encode humidity (Property ID 0x0076: Humidity)
     uint8_t hum_buffer[4];
     uint8_t hum_len;
-    encode_humidity(data->humidity_percent, hum_buffer, &hum_len);
+    encode_humidity(data->humidity_centi_pct, hum_buffer, &hum_len);
+    uint16_t hum_decoded = decode_humidity(hum_buffer);
     
     ESP_LOGI(TAG, "Humidity Property:");
     ESP_LOGI(TAG, "  Property ID: 0x%04X (Humidity)", BLE_MESH_PROP_ID_HUMIDITY);
-    ESP_LOGI(TAG, "  Value: %.1f%%", data->humidity_percent);
-    ESP_LOGI(TAG, "  Encoded: 0x%02X%02X (%.1f%%)", 
+    ESP_LOGI(TAG, "  Value: " CENTI_FMT "%%", CENTI_ARGS(data->humidity_centi_pct));
+    ESP_LOGI(TAG, "  Encoded: 0x%02X%02X (" CENTI_FMT "%%)", 
              hum_buffer[0], hum_buffer[1], 
-             decode_humidity(hum_buffer));
+             CENTI_ARGS(hum_decoded));
     
     // Battery level (Property ID 0x006E: Percentage 8)
     ESP_LOGI(TAG, "Battery Property:");
@@ -355,10 +358,10 @@ static void generate_uuid_from_mac(uint8_t *uuid) {
     uuid[15] = 0x01;  // Product 1 (Sensor Node)
 }
 
-static void encode_temperature(float temp_celsius, uint8_t *buffer, uint8_t *len) {
+static void encode_temperature(int16_t temp_centi_c, uint8_t *buffer, uint8_t *len) {
     // Temperature 8: 0.5°C resolution, range -64°C to 63.5°C
-    // Encoded as: value = (temp_celsius / 0.5)
-    int16_t encoded = (int16_t)(temp_celsius / 0.5f);
+    // Encoded as: value = temp / 0.5°C = centi / 50 (truncated toward zero)
+    int16_t encoded = (int16_t)(temp_centi_c / 50);
     
     // Clamp to 8-bit signed range
     if (encoded < -128) encoded = -128;
@@ -369,10 +372,10 @@ static void encode_temperature(float temp_celsius, uint8_t *buffer, uint8_t *len
     *len = 2;
 }
 
-static void encode_humidity(float humidity_percent, uint8_t *buffer, uint8_t *len) {
+static void encode_humidity(uint16_t humidity_centi_pct, uint8_t *buffer, uint8_t *len) {
     // Humidity: 0.5% resolution, range 0% to 100%
-    // Encoded as: value = (humidity_percent / 0.5)
-    uint16_t encoded = (uint16_t)(humidity_percent / 0.5f);
+    // Encoded as: value = humidity / 0.5% = centi / 50
+    uint16_t encoded = (uint16_t)(humidity_centi_pct / 50);
     
     // Clamp to valid range
     if (encoded > 200) encoded = 200;  // Max 100%
@@ -382,14 +385,14 @@ static void encode_humidity(float humidity_percent, uint8_t *buffer, uint8_t *le
     *len = 2;
 }
 
-static float decode_temperature(const uint8_t *buffer) {
+static int16_t decode_temperature(const uint8_t *buffer) {
     int16_t encoded = (int16_t)(buffer[0] | (buffer[1] << 8));
-    return (float)encoded * 0.5f;
+    return (int16_t)(encoded * 50);
 }
 
-static float decode_humidity(const uint8_t *buffer) {
+static uint16_t decode_humidity(const uint8_t *buffer) {
     uint16_t encoded = (uint16_t)(buffer[0] | (buffer[1] << 8));
-    return (float)encoded * 0.5f;
+    return (uint16_t)(encoded * 50);
 }
 
 static void log_mesh_configuration(void) {
@@ -433,9 +436,10 @@ static void log_mesh_configuration(void) {
         ESP_LOGI(TAG, "");
         ESP_LOGI(TAG, "Low Power Node Configuration:");
         ESP_LOGI(TAG, "────────────────────────────────────────────────────");
-        ESP_LOGI(TAG, "  Poll Interval: %lu ms (%.1f seconds)", 
+        ESP_LOGI(TAG, "  Poll Interval: %lu ms (%lu.%lu seconds)", 
                  g_mesh_config.lpn_poll_interval_ms,
-                 g_mesh_config.lpn_poll_interval_ms / 1000.0f);
+                 g_mesh_config.lpn_poll_interval_ms / 1000,
+                 (g_mesh_config.lpn_poll_interval_ms % 1000) / 100);
         ESP_LOGI(TAG, "  Expected Power Savings: 90-95%%");
     }
     
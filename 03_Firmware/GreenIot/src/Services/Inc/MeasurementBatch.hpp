@@ -0,0 +1,120 @@
+/**
+ * @file MeasurementBatch.hpp
+ * @brief Measurements kept across deep sleep until the next transmission
+ * 
+ * Architecture Layer: SERVICES LAYER
+ * Used by: StateMachine
+ * 
+ * A ring of compact samples in a caller-provided MeasurementBatchState (RTC
+ * slow memory on the target): every reading is kept, and the radio comes up
+ * only to publish the whole batch in one session. Each sample is three
+ * 16-bit words, the calibrated readings and the seconds since the previous
+ * sample; only the oldest sample's time is stored in full. A CRC over the
+ * state guards against a brown-out or a new firmware image leaving garbage
+ * in RTC memory. When the ring is full the oldest sample is dropped.
+ * 
+ * Batch payload (encode(), little endian):
+ * 
+ *   u8  version (MEASUREMENT_BATCH_VERSION)
+ *   u8  sample count n
+ *   u8  battery level (%)
+ *   u16 age of the newest sample (s)
+ *   n x { u16 seconds since the previous sample (0 for the oldest),
+ *         s16 temperature (0.01 °C), u16 humidity (0.01 %RH) }
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#ifndef MEASUREMENT_BATCH_HPP
+#define MEASUREMENT_BATCH_HPP
+
+#include "ISensor.hpp"
+#include <cstddef>
+#include <cstdint>
+
+#define MEASUREMENT_BATCH_CAPACITY 32
+#define MEASUREMENT_BATCH_VERSION 1
+#define MEASUREMENT_BATCH_HEADER_LEN 5
+#define MEASUREMENT_BATCH_SAMPLE_LEN 6
+#define MEASUREMENT_BATCH_PAYLOAD_MAX \
+    (MEASUREMENT_BATCH_HEADER_LEN + MEASUREMENT_BATCH_CAPACITY * MEASUREMENT_BATCH_SAMPLE_LEN)
+
+/**
+ * @brief One kept reading (6 bytes)
+ */
+struct BatchSample {
+    uint16_t delta_s;              // Seconds since the previous sample (saturates)
+    int16_t temperature_centi_c;
+    uint16_t humidity_centi_pct;
+};
+
+/**
+ * @brief Batch kept across deep sleep (sealed with a CRC)
+ */
+struct MeasurementBatchState {
+    uint32_t magic;
+    uint32_t oldest_time_s;   // Clock time of the oldest sample
+    uint32_t newest_time_s;   // Clock time of the newest sample
+    uint8_t head;             // Index of the oldest sample
+    uint8_t count;
+    uint16_t dropped;         // Samples lost to a full ring since the last flush
+    BatchSample samples[MEASUREMENT_BATCH_CAPACITY];
+    uint32_t crc;
+};
+
+/**
+ * @brief Ring of readings waiting for transmission
+ */
+class MeasurementBatch {
+public:
+    explicit MeasurementBatch(MeasurementBatchState& state) : m_state(state) {}
+    
+    /**
+     * @brief Check the kept state after a boot; an invalid one is cleared
+     * @return true if the kept samples are valid (possibly none)
+     */
+    bool restore();
+    
+    void clear();
+    
+    /**
+     * @brief Append a reading; drops the oldest one if the ring is full
+     * @param time_s Clock time of the reading (s, keeps counting through sleep)
+     */
+    void push(uint32_t time_s, const SensorData& data);
+    
+    /**
+     * @brief Remove the count oldest samples (e.g. after they were published)
+     */
+    void consume(uint8_t count);
+    
+    uint8_t size() const { return m_state.count; }
+    bool full() const { return m_state.count == MEASUREMENT_BATCH_CAPACITY; }
+    uint16_t dropped() const { return m_state.dropped; }
+    
+    /**
+     * @brief Sample by age (0 = oldest)
+     * @return false if index is out of range
+     */
+    bool sample(uint8_t index, uint32_t& time_s, SensorData& data) const;
+    
+    /**
+     * @brief Encode every kept sample as a batch payload
+     * @param out Buffer of at least MEASUREMENT_BATCH_PAYLOAD_MAX bytes
+     * @param now_s Current clock time (for the age of the newest sample)
+     * @return Payload length (0 if the batch is empty)
+     */
+    size_t encode(uint8_t* out, uint32_t now_s, uint8_t battery_percent) const;
+    
+private:
+    MeasurementBatchState& m_state;
+    
+    void seal();
+    uint32_t crc() const;
+    const BatchSample& at(uint8_t index) const {
+        return m_state.samples[(m_state.head + index) % MEASUREMENT_BATCH_CAPACITY];
+    }
+};
+
+#endif // MEASUREMENT_BATCH_HPP
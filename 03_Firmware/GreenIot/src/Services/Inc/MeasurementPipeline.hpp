@@ -0,0 +1,121 @@
+/**
+ * @file MeasurementPipeline.hpp
+ * @brief Compile-time measurement pipeline (header-only)
+ * 
+ * Architecture Layer: SERVICES LAYER
+ * Used by: StateMachine, native tests
+ * 
+ * A pipeline is a fixed list of stages, each a plain class with
+ * 
+ *   PipelineStatus process(MeasurementSample& sample);
+ * 
+ * run() calls them in order on one MeasurementSample, passed by reference,
+ * and stops at the first stage that does not return OK. The stage list is
+ * a template parameter pack: there is no stage interface, no function
+ * pointer and no heap, so the compiler sees the whole chain and can inline
+ * it into the caller. Stages go in the type:
+ * 
+ *   MeasurementPipeline pipeline(AcquireStage<SHT31Sensor>(sensor), AlertCheckStage(limits));
+ *   PipelineStatus status = pipeline.run(sample);
+ * 
+ * The stages shipped with the firmware are in MeasurementStages.hpp.
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#ifndef MEASUREMENT_PIPELINE_HPP
+#define MEASUREMENT_PIPELINE_HPP
+
+#include "ISensor.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+#define MEASUREMENT_PAYLOAD_MAX 16
+
+/**
+ * @brief Pipeline status codes
+ */
+enum class PipelineStatus : uint8_t {
+    OK = 0,
+    ERROR_ACQUIRE,      // Sensor read failed (MeasurementSample::sensor_status)
+    ERROR_RANGE,        // Reading outside the sensor's physical range
+    ERROR_ENCODE,       // Payload does not fit MEASUREMENT_PAYLOAD_MAX
+    ERROR_OFFLINE,      // No link to publish on (e.g. mesh not provisioned)
+    ERROR_PUBLISH       // Link refused or lost the payload
+};
+
+inline const char* pipelineStatusToString(PipelineStatus status) {
+    switch (status) {
+        case PipelineStatus::OK: return "OK";
+        case PipelineStatus::ERROR_ACQUIRE: return "Acquisition Error";
+        case PipelineStatus::ERROR_RANGE: return "Out of Range";
+        case PipelineStatus::ERROR_ENCODE: return "Encode Error";
+        case PipelineStatus::ERROR_OFFLINE: return "Link Offline";
+        case PipelineStatus::ERROR_PUBLISH: return "Publish Error";
+        default: return "Unknown Error";
+    }
+}
+
+/**
+ * @brief The one buffer a measurement passes through, from burst to payload
+ * 
+ * Stages read and write it in place; nothing is copied between stages.
+ */
+struct MeasurementSample {
+    BurstResult burst;             // Acquisition: aggregate and burst statistics
+    SensorStatus sensor_status;    // Result of the last acquisition
+    uint8_t battery_percent;       // Sampled before the burst
+    bool alert;                    // A stage found the reading outside its limits
+    uint8_t payload_len;           // Encoded bytes in payload
+    uint8_t payload[MEASUREMENT_PAYLOAD_MAX];
+    
+    const SensorData& data() const { return burst.data; }
+};
+
+/**
+ * @brief Fixed chain of stages run on one MeasurementSample
+ */
+template <typename... Stages>
+class MeasurementPipeline {
+public:
+    static constexpr size_t STAGES = sizeof...(Stages);
+    
+    explicit MeasurementPipeline(Stages... stages)
+        : m_stages(std::move(stages)...) {}
+    
+    /**
+     * @brief Run the stages in order; stops at the first failure
+     * @param failed_stage If not null, receives the index of the failing
+     *        stage (STAGES if all of them returned OK)
+     */
+    PipelineStatus run(MeasurementSample& sample, size_t* failed_stage = nullptr) {
+        PipelineStatus status = PipelineStatus::OK;
+        size_t stage = runStages(sample, status, std::index_sequence_for<Stages...>());
+        if (failed_stage != nullptr) *failed_stage = stage;
+        return status;
+    }
+    
+    /**
+     * @brief Access a stage (e.g. to retune it between runs)
+     */
+    template <size_t I>
+    typename std::tuple_element<I, std::tuple<Stages...>>::type& stage() {
+        return std::get<I>(m_stages);
+    }
+    
+private:
+    std::tuple<Stages...> m_stages;
+    
+    template <size_t... I>
+    size_t runStages(MeasurementSample& sample, PipelineStatus& status, std::index_sequence<I...>) {
+        // && short-circuits: the stages after a failure are not called
+        size_t completed = 0;
+        (void)((((status = std::get<I>(m_stages).process(sample)) == PipelineStatus::OK && ++completed) && ...));
+        return completed;
+    }
+};
+
+#endif // MEASUREMENT_PIPELINE_HPP
@@ -0,0 +1,201 @@
+/**
+ * @file MeasurementStages.hpp
+ * @brief Stages for MeasurementPipeline (header-only)
+ * 
+ * Architecture Layer: SERVICES LAYER
+ * Used by: StateMachine, native tests
+ * 
+ *   AcquireStage      burst acquisition (conversion, calibration offsets and
+ *                     the burst filter run in the driver)
+ *   RangeCheckStage   rejects an aggregate outside the sensor's range
+ *   AlertCheckStage   flags a reading outside an alert window
+ *   MeshEncodeStage   BLE Mesh Sensor Status payload
+ *   MeshPublishStage  publishes the payload through BLEMeshManager
+ *   MeshTransmitStage publishes the kept readings as one batch, or the
+ *                     newest one as a Sensor Status
+ * 
+ * Calibration offsets stay in the drivers: the ALERT thresholds are
+ * programmed into the sensor, which compares uncalibrated values.
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#ifndef MEASUREMENT_STAGES_HPP
+#define MEASUREMENT_STAGES_HPP
+
+#include "MeasurementPipeline.hpp"
+#include "MeasurementBatch.hpp"
+#include "BLEMeshManager.hpp"
+#include "HAL/Wireless/ble_mesh_interface.h"
+
+/**
+ * @brief Burst acquisition through the sensor's final type
+ * 
+ * With a final driver class (or SensorGroup) the readBurst() call is
+ * direct; with ISensor it is the usual virtual call.
+ */
+template <typename Sensor>
+class AcquireStage {
+public:
+    explicit AcquireStage(Sensor& sensor) : m_sensor(sensor) {}
+    
+    PipelineStatus process(MeasurementSample& sample) {
+        sample.alert = false;
+        sample.payload_len = 0;
+        sample.sensor_status = m_sensor.readBurst(sample.burst);
+        return (sample.sensor_status == SensorStatus::OK) ? PipelineStatus::OK : PipelineStatus::ERROR_ACQUIRE;
+    }
+    
+private:
+    Sensor& m_sensor;
+};
+
+/**
+ * @brief Rejects an aggregate outside the sensor's specified range
+ */
+class RangeCheckStage {
+public:
+    explicit RangeCheckStage(const SensorInfo& info) : m_info(info) {}
+    
+    PipelineStatus process(MeasurementSample& sample) {
+        const SensorData& data = sample.burst.data;
+        if (data.temperature_centi_c < m_info.temp_min_centi_c ||
+            data.temperature_centi_c > m_info.temp_max_centi_c ||
+            data.humidity_centi_pct < m_info.hum_min_centi_pct ||
+            data.humidity_centi_pct > m_info.hum_max_centi_pct) {
+            return PipelineStatus::ERROR_RANGE;
+        }
+        return PipelineStatus::OK;
+    }
+    
+private:
+    const SensorInfo& m_info;
+};
+
+/**
+ * @brief Flags a reading outside the alert window (hysteresis fields unused)
+ * 
+ * Never fails: the caller decides what an alert means (e.g. publish now).
+ */
+class AlertCheckStage {
+public:
+    explicit AlertCheckStage(const SensorAlertLimits& limits) : m_limits(limits) {}
+    
+    PipelineStatus process(MeasurementSample& sample) {
+        const SensorData& data = sample.burst.data;
+        if (data.temperature_centi_c < m_limits.temp_low_centi_c ||
+            data.temperature_centi_c > m_limits.temp_high_centi_c ||
+            data.humidity_centi_pct < m_limits.hum_low_centi_pct ||
+            data.humidity_centi_pct > m_limits.hum_high_centi_pct) {
+            sample.alert = true;
+        }
+        return PipelineStatus::OK;
+    }
+    
+private:
+    const SensorAlertLimits& m_limits;
+};
+
+/**
+ * @brief BLE Mesh Sensor Status payload (marshalled properties, format A)
+ * 
+ * Each property is a 2-byte MPID (format 0, length - 1, property ID; little
+ * endian) followed by its value:
+ *   Temperature 8  sint8   0.5 °C   (rounded, clamped to -64..63 °C; 0x7F = unknown)
+ *   Humidity       uint16  0.01 %RH
+ *   Percentage 8   uint8   0.5 %    (battery)
+ */
+class MeshEncodeStage {
+public:
+    static constexpr uint8_t PAYLOAD_LEN = 3 + 4 + 3;
+    static constexpr int8_t TEMPERATURE8_MAX = 126;   // 0x7F means "not known"
+    
+    PipelineStatus process(MeasurementSample& sample) {
+        static_assert(PAYLOAD_LEN <= MEASUREMENT_PAYLOAD_MAX, "Sensor Status does not fit the payload");
+        const SensorData& data = sample.burst.data;
+        uint8_t* out = sample.payload;
+        
+        out = property(out, BLE_MESH_PROP_ID_TEMPERATURE, 1);
+        *out++ = static_cast<uint8_t>(temperature8(data.temperature_centi_c));
+        out = property(out, BLE_MESH_PROP_ID_HUMIDITY, 2);
+        *out++ = static_cast<uint8_t>(data.humidity_centi_pct & 0xFF);
+        *out++ = static_cast<uint8_t>(data.humidity_centi_pct >> 8);
+        out = property(out, BLE_MESH_PROP_ID_BATTERY_LEVEL, 1);
+        *out++ = static_cast<uint8_t>((sample.battery_percent > 100) ? 200 : sample.battery_percent * 2);
+        
+        sample.payload_len = static_cast<uint8_t>(out - sample.payload);
+        return PipelineStatus::OK;
+    }
+    
+    static int8_t temperature8(int16_t temp_centi_c) {
+        int32_t half_degrees = (temp_centi_c >= 0) ? (temp_centi_c + 25) / 50 : (temp_centi_c - 25) / 50;
+        if (half_degrees < INT8_MIN) half_degrees = INT8_MIN;
+        if (half_degrees > TEMPERATURE8_MAX) half_degrees = TEMPERATURE8_MAX;
+        return static_cast<int8_t>(half_degrees);
+    }
+    
+private:
+    static uint8_t* property(uint8_t* out, uint16_t property_id, uint8_t length) {
+        uint16_t mpid = static_cast<uint16_t>((property_id << 5) | ((length - 1) << 1));
+        *out++ = static_cast<uint8_t>(mpid & 0xFF);
+        *out++ = static_cast<uint8_t>(mpid >> 8);
+        return out;
+    }
+};
+
+/**
+ * @brief Publishes the encoded payload on the mesh
+ */
+class MeshPublishStage {
+public:
+    PipelineStatus process(MeasurementSample& sample) {
+        return toPipelineStatus(BLEMeshManager::getInstance().publishSensorStatus(sample.payload, sample.payload_len));
+    }
+    
+    static PipelineStatus toPipelineStatus(BLEMeshStatus status) {
+        switch (status) {
+            case BLEMeshStatus::OK: return PipelineStatus::OK;
+            case BLEMeshStatus::ERROR_NOT_PROVISIONED: return PipelineStatus::ERROR_OFFLINE;
+            case BLEMeshStatus::ERROR_NOT_SUPPORTED: return PipelineStatus::ERROR_OFFLINE;
+            case BLEMeshStatus::ERROR_INVALID_PARAM: return PipelineStatus::ERROR_ENCODE;
+            default: return PipelineStatus::ERROR_PUBLISH;
+        }
+    }
+};
+
+/**
+ * @brief Publishes the kept readings through the mesh's final type
+ * 
+ * Several kept readings go out as one batch message. While the mesh cannot
+ * carry a batch (ERROR_NOT_SUPPORTED), or with a single reading kept, the
+ * newest reading is encoded and published as a Sensor Status instead. On
+ * success the published message stands for every kept reading.
+ */
+template <typename Mesh>
+class MeshTransmitStage {
+public:
+    MeshTransmitStage(Mesh& mesh, const MeasurementBatch& batch, uint8_t* buffer, uint32_t now_s)
+        : m_mesh(mesh), m_batch(batch), m_buffer(buffer), m_now_s(now_s) {}
+    
+    PipelineStatus process(MeasurementSample& sample) {
+        if (m_batch.size() > 1) {
+            size_t length = m_batch.encode(m_buffer, m_now_s, sample.battery_percent);
+            BLEMeshStatus status = m_mesh.publishSensorBatch(m_buffer, static_cast<uint16_t>(length));
+            if (status != BLEMeshStatus::ERROR_NOT_SUPPORTED) {
+                return MeshPublishStage::toPipelineStatus(status);
+            }
+        }
+        
+        MeshEncodeStage().process(sample);
+        return MeshPublishStage::toPipelineStatus(m_mesh.publishSensorStatus(sample.payload, sample.payload_len));
+    }
+    
+private:
+    Mesh& m_mesh;
+    const MeasurementBatch& m_batch;
+    uint8_t* m_buffer;   // MEASUREMENT_BATCH_PAYLOAD_MAX bytes
+    uint32_t m_now_s;
+};
+
+#endif // MEASUREMENT_STAGES_HPP
@@ -6,7 +6,8 @@
  * 
  * Features:
  * - Deep sleep with periodic wake-up timer
- * - GPIO control for sensor power pin
+ * - Automatic light sleep while the application task is blocked (tickless idle)
+ * - GPIO control for sensor power pin, gated only when that saves charge
  * - Current consumption measurement
  * - Battery voltage monitoring
  * - RTC memory for state preservation
@@ -18,8 +19,11 @@
 #ifndef POWER_MANAGER_HPP
 #define POWER_MANAGER_HPP
 
+#include "SensorPowerPolicy.hpp"
 #include <cstdint>
 
+struct SensorInfo;
+
 enum class SleepMode {
     LIGHT_SLEEP,
     DEEP_SLEEP
@@ -28,6 +32,7 @@ enum class SleepMode {
 enum class WakeupSource {
     TIMER,
     BUTTON,
+    SENSOR_ALERT,  // Sensor ALERT output (climate left the alert window)
     UNKNOWN,
     POWER_ON  // First boot
 };
@@ -36,39 +41,49 @@ struct PowerConfig {
     uint32_t deep_sleep_duration_sec;
     uint32_t light_sleep_duration_ms;
     bool enable_auto_sleep;
+    bool enable_auto_light_sleep;  // Idle task may light-sleep between events (needs tickless idle)
     uint16_t battery_adc_pin;
     uint8_t sensor_power_pin;      // GPIO pin for sensor power control
     bool enable_sensor_power_control;  // Enable GPIO power control
+    uint8_t sensor_alert_pin;      // GPIO wired to the sensor ALERT output (deep-sleep wake: GPIO 0-5)
+    bool enable_sensor_alert_wake; // Allow waking from deep sleep on ALERT
+    uint32_t sensor_wait_current_ua;  // MCU current while it waits for the sensor to power up
+    uint32_t sensor_rail_charge_nc;   // Sensor rail capacitance x supply voltage
     
     PowerConfig()
         : deep_sleep_duration_sec(300)   // 5 minutes
         , light_sleep_duration_ms(100)
         , enable_auto_sleep(false)
+        , enable_auto_light_sleep(false)
         , battery_adc_pin(0)
         , sensor_power_pin(10)           // GPIO 10 for sensor power
-        , enable_sensor_power_control(true) {}
+        , enable_sensor_power_control(true)
+        , sensor_alert_pin(3)            // GPIO 3 (RTC-capable)
+        , enable_sensor_alert_wake(false)
+        , sensor_wait_current_ua(20000)  // CPU awake, radio off
+        , sensor_rail_charge_nc(3300) {} // 1 µF at 3.3 V
 };
 
 /**
  * @brief Power consumption statistics
  */
 struct PowerStats {
-    float avg_current_ua;        // Average current consumption (µA)
-    float active_current_ma;      // Active mode current (mA)
-    float sleep_current_ua;       // Sleep mode current (µA)
+    uint32_t avg_current_ua;        // Average current consumption (µA)
+    uint32_t active_current_ua;     // Active mode current (µA)
+    uint32_t sleep_current_ua;      // Sleep mode current (µA)
     uint32_t total_active_time_ms;  // Total active time
     uint32_t total_sleep_time_ms;   // Total sleep time
     uint32_t wakeup_count;         // Number of wake-ups
-    float estimated_battery_life_days;  // Estimated battery life
+    uint32_t estimated_battery_life_days;  // Estimated battery life
     
     PowerStats()
-        : avg_current_ua(0.0f)
-        , active_current_ma(0.0f)
-        , sleep_current_ua(0.0f)
+        : avg_current_ua(0)
+        , active_current_ua(0)
+        , sleep_current_ua(0)
         , total_active_time_ms(0)
         , total_sleep_time_ms(0)
         , wakeup_count(0)
-        , estimated_battery_life_days(0.0f) {}
+        , estimated_battery_life_days(0) {}
 };
 
 /**
@@ -84,27 +99,105 @@ public:
     
     void init(const PowerConfig& config);
     void enterLightSleep(uint32_t duration_ms);
-    void enterDeepSleep(uint32_t duration_sec);
+    void enterDeepSleep(uint32_t duration_sec) { enterDeepSleepMs(duration_sec * 1000); }
+    void enterDeepSleepMs(uint32_t duration_ms);
     WakeupSource getWakeupCause();
     
     // Sensor power control
-    void sensorPowerOn();
+    void sensorPowerOn();   // Returns at once; see waitSensorStartup()
     void sensorPowerOff();
     bool isSensorPowered() const { return m_sensor_powered; }
     
+    /**
+     * @brief Sensor figures for the rail policy
+     * @param info Startup, power-up reset/conversion times and currents
+     */
+    void configureSensorPower(const SensorInfo& info);
+    
+    /**
+     * @brief Wait for whatever is left of the sensor's startup time
+     * 
+     * No wait if the rail stayed up through the last sleep or has been up
+     * long enough already (e.g. while the radio initialised).
+     */
+    void waitSensorStartup();
+    
+    /**
+     * @brief What is left of the sensor's startup time (0 = ready)
+     * 
+     * For callers that block on something else meanwhile instead of
+     * waitSensorStartup(); they still call waitSensorStartup() once it is 0.
+     */
+    uint32_t sensorStartupRemainingMs() const;
+    
+    /**
+     * @brief Keep the rail up through a sleep of sleep_ms (break-even model)?
+     */
+    bool keepSensorPowered(uint32_t sleep_ms) const;
+    
+    /**
+     * @brief Arm or disarm the ALERT wake for the next deep sleep
+     * 
+     * Call after the sensor has been told to monitor its limits. While armed,
+     * the sensor stays powered (power pin held) through deep sleep. If ALERT
+     * is already asserted at sleep time only the timer wake is used, so a
+     * persisting excursion does not wake the node again immediately.
+     */
+    void armSensorAlertWake(bool armed);
+    bool isSensorAlertWakeArmed() const { return m_alert_wake_armed; }
+    
+    /**
+     * @brief Handler for ALERT while awake (called from the GPIO ISR)
+     * 
+     * The interrupt is one-shot: it is disabled when it fires and re-enabled
+     * by enableSensorAlertInterrupt(true). Needs enable_sensor_alert_wake.
+     */
+    void setSensorAlertHandler(void (*handler)(void* arg), void* arg);
+    
+    /**
+     * @brief Enable or disable the ALERT interrupt and light-sleep wake
+     */
+    void enableSensorAlertInterrupt(bool enable);
+    
+    /**
+     * @brief RTC slow clock: counter (runs through deep sleep) and its
+     *        period measured at this boot (µs, Q13.19), for RtcTimebase
+     */
+    uint64_t slowClockTicks() const;
+    uint32_t slowClockPeriod() const;
+    
     // Periodic wake-up timer
     void configureWakeupTimer(uint32_t duration_sec);
     uint32_t getWakeupTimerDuration() const { return m_config.deep_sleep_duration_sec; }
     
-    // Battery monitoring
-    float getBatteryVoltage();
+    // Battery monitoring (integer mV, no soft-float)
+    uint16_t getBatteryMillivolts();   // 0 = invalid reading
     uint8_t getBatteryPercent();
     
+    /**
+     * @brief Battery voltage from a 12-bit ADC code
+     * 
+     * 0-3.3 V full scale behind a 1:2 divider (Vbat -> 100k -> ADC -> 100k -> GND).
+     */
+    static uint16_t adcToMillivolts(uint16_t adc_value) {
+        return static_cast<uint16_t>((static_cast<uint32_t>(adc_value) * 6600 + 2047) / 4095);
+    }
+    
+    /**
+     * @brief Li-Ion state of charge, linear between 3.0 V (empty) and 4.2 V (full)
+     */
+    static uint8_t millivoltsToPercent(uint16_t battery_mv) {
+        if (battery_mv >= BATTERY_FULL_MV) return 100;
+        if (battery_mv <= BATTERY_EMPTY_MV) return 0;
+        return static_cast<uint8_t>((battery_mv - BATTERY_EMPTY_MV) * 100U /
+                                    (BATTERY_FULL_MV - BATTERY_EMPTY_MV));
+    }
+    
     // Current consumption measurement
-    float measureCurrentConsumption();  // Returns current in µA
+    uint32_t measureCurrentConsumption();  // Returns current in µA
     PowerStats getPowerStats() const { return m_stats; }
     void updatePowerStats(uint32_t active_time_ms, uint32_t sleep_time_ms);
-    float calculateBatteryLife(uint32_t battery_capacity_mah) const;
+    uint32_t calculateBatteryLife(uint32_t battery_capacity_mah) const;  // Days
     
     // Auto-sleep
     void enableAutoSleep(bool enable);
@@ -115,18 +208,38 @@ public:
     void restoreStateFromRTC();
     
 private:
+    static constexpr uint16_t BATTERY_EMPTY_MV = 3000;
+    static constexpr uint16_t BATTERY_FULL_MV = 4200;
+    static constexpr int CPU_FREQ_MAX_MHZ = 160;
+    static constexpr int CPU_FREQ_MIN_MHZ = 40;   // XTAL, lowest for BLE
+    
     PowerManager() 
         : m_initialized(false)
-        , m_sensor_powered(false) {}
+        , m_sensor_powered(false)
+        , m_sensor_ready(false)
+        , m_alert_wake_armed(false)
+        , m_sensor_power_on_us(0)
+        , m_sensor_model{0, 0, 0, 0, 0, 0, 0}
+        , m_alert_handler(nullptr)
+        , m_alert_handler_arg(nullptr) {}
     ~PowerManager() = default;
     
     bool m_initialized;
     bool m_sensor_powered;
+    bool m_sensor_ready;       // Startup time has elapsed since the rail came up
+    bool m_alert_wake_armed;
+    int64_t m_sensor_power_on_us;
+    SensorPowerModel m_sensor_model;
+    void (*m_alert_handler)(void* arg);
+    void* m_alert_handler_arg;
     PowerConfig m_config;
     PowerStats m_stats;
     
     void initADC();
     void initGPIO();
+    void initAlertGPIO();
+    void initAutoLightSleep();
+    static void sensorAlertIsr(void* arg);
     uint16_t readBatteryADC();
     void updateCurrentConsumption();
 };
@@ -0,0 +1,107 @@
+/**
+ * @file RtcTimebase.hpp
+ * @brief Monotonic clock kept across deep sleep on the RTC slow clock
+ * 
+ * Architecture Layer: SERVICES LAYER
+ * Used by: StateMachine
+ * 
+ * The RTC counter keeps running through deep sleep, but its RC oscillator
+ * (~136 kHz on the ESP32-C3) drifts by percent with temperature and
+ * supply. Time is kept as an epoch in a caller-provided RtcTimebaseState
+ * (RTC memory on the target): clock time and counter value at the last
+ * rebase, plus the counter period measured at that wake's boot. A sleep is
+ * converted with the mean of the periods measured before and after it,
+ * which follows a slow temperature change through the sleep better than
+ * the period at sleep entry alone. The clock never steps back and does not
+ * follow settimeofday().
+ * 
+ * The time from the wake timer firing to the application running (boot,
+ * plus what the last wake did after choosing its sleep) is learned on
+ * every timer wake, and sleepUs() subtracts it, so work starts at the
+ * deadline instead of a boot time later. The period change across each
+ * sleep gives a drift estimate for guard times (guardUs()).
+ * 
+ * Counter periods are in µs as Q13.19 fixed point (esp_clk_slowclk_cal_get()).
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#ifndef RTC_TIMEBASE_HPP
+#define RTC_TIMEBASE_HPP
+
+#include <cstdint>
+
+#define RTC_TIMEBASE_PERIOD_SHIFT 19
+#define RTC_TIMEBASE_LATENCY_MAX_US 2000000  // Longer means not a plain timer wake
+
+/**
+ * @brief Timebase kept across deep sleep
+ */
+struct RtcTimebaseState {
+    uint32_t magic;
+    uint32_t period_q19;        // Counter period at the base (µs, Q13.19)
+    uint64_t base_us;           // Clock time at base_ticks
+    uint64_t base_ticks;        // RTC counter at the base
+    uint64_t wake_at_us;        // When the wake timer should fire (0 = not set)
+    uint32_t wake_latency_us;   // Timer firing to start() (running mean)
+    uint32_t drift_ppm;         // Period change across a sleep (running mean)
+    uint32_t sleeps;            // Sleeps bridged since the clock started
+};
+
+/**
+ * @brief Clock on the RTC counter (readings come from the caller)
+ */
+class RtcTimebase {
+public:
+    explicit RtcTimebase(RtcTimebaseState& state) : m_state(state) {}
+    
+    /**
+     * @brief Bridge the last sleep at boot and rebase on this wake's period
+     * @param ticks RTC counter now
+     * @param period_q19 Counter period measured at this boot
+     * @param timer_wake The wake timer woke the chip (latency is learned)
+     * @return true if the clock continued, false if it started at the counter
+     */
+    bool start(uint64_t ticks, uint32_t period_q19, bool timer_wake);
+    
+    /**
+     * @brief Clock time (µs) at counter value ticks
+     */
+    uint64_t nowUs(uint64_t ticks) const;
+    
+    /**
+     * @brief Timer setting to be running at deadline_us
+     * @return 0 if the deadline is closer than the wake latency
+     */
+    uint64_t sleepUs(uint64_t now_us, uint64_t deadline_us) const;
+    
+    /**
+     * @brief Note the sleep about to start (for the latency at the next start())
+     */
+    void prepareSleep(uint64_t now_us, uint64_t sleep_us);
+    
+    /**
+     * @brief Worst clock error expected after a sleep of sleep_us
+     */
+    uint32_t guardUs(uint64_t sleep_us) const;
+    
+    uint32_t wakeLatencyUs() const { return m_state.wake_latency_us; }
+    uint32_t driftPpm() const { return m_state.drift_ppm; }
+    uint32_t sleeps() const { return m_state.sleeps; }
+    
+    /**
+     * @brief Counter ticks to µs (exact to the µs for any 48-bit tick count)
+     */
+    static uint64_t ticksToUs(uint64_t ticks, uint32_t period_q19) {
+        return (ticks >> RTC_TIMEBASE_PERIOD_SHIFT) * period_q19 +
+               (((ticks & ((1ULL << RTC_TIMEBASE_PERIOD_SHIFT) - 1)) * period_q19) >> RTC_TIMEBASE_PERIOD_SHIFT);
+    }
+    
+private:
+    RtcTimebaseState& m_state;
+    
+    bool valid() const;
+};
+
+#endif // RTC_TIMEBASE_HPP
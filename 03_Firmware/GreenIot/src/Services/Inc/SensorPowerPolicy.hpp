@@ -0,0 +1,77 @@
+/**
+ * @file SensorPowerPolicy.hpp
+ * @brief Break-even model for gating the sensor rail (header-only)
+ * 
+ * Architecture Layer: SERVICES LAYER
+ * Used by: PowerManager, native tests
+ * 
+ * Keeping the rail up through a sleep costs the sensor's idle current for
+ * the whole sleep. Gating it costs, at the next wake, the charge to bring
+ * the rail back up, the MCU staying awake for the sensor's power-up time
+ * before the first command, and any soft reset or discarded first
+ * conversion the sensor needs after power-up (MCU waiting, sensor active).
+ * The rail is gated only when the idle charge is the larger of the two; the
+ * sleep length where both are equal is the break-even time.
+ * 
+ * Charges are in nC (µA x ms), integer arithmetic only.
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#ifndef SENSOR_POWER_POLICY_HPP
+#define SENSOR_POWER_POLICY_HPP
+
+#include <cstdint>
+
+/**
+ * @brief What one power cycle of the sensor rail costs
+ */
+struct SensorPowerModel {
+    uint32_t sensor_idle_na;     // Sensor idle current with the rail up
+    uint16_t startup_time_ms;    // Rail up to first command (datasheet)
+    uint32_t wait_current_ua;    // MCU current while it waits for the sensor
+    uint32_t rail_charge_nc;     // Rail capacitance x supply voltage
+    uint32_t sensor_active_ua;   // Sensor current during reset and conversion
+    uint16_t reset_time_ms;      // Soft reset / calibration after power-up
+    uint16_t first_conversion_ms;  // Conversion discarded after power-up
+};
+
+class SensorPowerPolicy {
+public:
+    /**
+     * @brief Charge drawn by the idle sensor over a sleep of sleep_ms
+     */
+    static uint64_t keepChargeNc(const SensorPowerModel& model, uint32_t sleep_ms) {
+        return (static_cast<uint64_t>(model.sensor_idle_na) * sleep_ms + 500) / 1000;
+    }
+    
+    /**
+     * @brief Charge spent bringing the rail back up at the next wake
+     */
+    static uint64_t gateChargeNc(const SensorPowerModel& model) {
+        uint32_t powerup_ms = static_cast<uint32_t>(model.reset_time_ms) + model.first_conversion_ms;
+        return static_cast<uint64_t>(model.wait_current_ua) * model.startup_time_ms +
+               (static_cast<uint64_t>(model.wait_current_ua) + model.sensor_active_ua) * powerup_ms +
+               model.rail_charge_nc;
+    }
+    
+    /**
+     * @brief Sleep length above which gating the rail saves charge
+     * @return UINT32_MAX if the sensor draws nothing when idle
+     */
+    static uint32_t breakEvenMs(const SensorPowerModel& model) {
+        if (model.sensor_idle_na == 0) return UINT32_MAX;
+        uint64_t ms = gateChargeNc(model) * 1000 / model.sensor_idle_na;
+        return (ms > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(ms);
+    }
+    
+    /**
+     * @brief Keep the rail up through a sleep of sleep_ms?
+     */
+    static bool keepPowered(const SensorPowerModel& model, uint32_t sleep_ms) {
+        return keepChargeNc(model, sleep_ms) <= gateChargeNc(model);
+    }
+};
+
+#endif // SENSOR_POWER_POLICY_HPP
@@ -0,0 +1,119 @@
+/**
+ * @file SensorScheduler.hpp
+ * @brief Multi-rate acquisition scheduler (one wake serves every due sensor)
+ * 
+ * Architecture Layer: SERVICES LAYER
+ * Used by: StateMachine
+ * 
+ * Each entry has a period and a slack: it may run up to slack_ms before its
+ * deadline. The next wake is the earliest deadline, and that wake runs every
+ * entry whose window has opened by then. Placing each wake as late as the
+ * earliest deadline allows is the greedy interval-stabbing rule, which gives
+ * the fewest wakes for the given windows. Deadlines advance by whole periods
+ * from the previous deadline, so early or late wakes never shift an entry's
+ * phase.
+ * 
+ * The deadlines live in a caller-provided SensorScheduleState (RTC memory
+ * on the target) and survive deep sleep; times are milliseconds on a clock
+ * that keeps running through sleep.
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#ifndef SENSOR_SCHEDULER_HPP
+#define SENSOR_SCHEDULER_HPP
+
+#include <cstdint>
+
+#define SENSOR_SCHEDULER_MAX_ENTRIES 8
+
+/**
+ * @brief Scheduler state kept across deep sleep
+ * 
+ * Plain data: all-zero (cold boot) means not started.
+ */
+struct SensorScheduleState {
+    uint64_t deadline_ms[SENSOR_SCHEDULER_MAX_ENTRIES];
+    uint32_t signature;   // Entry set the deadlines belong to (0 = none)
+    uint32_t wakes;       // Wakes that completed at least one entry
+};
+
+/**
+ * @brief Multi-rate scheduler (entries are registered again on every boot)
+ */
+class SensorScheduler {
+public:
+    explicit SensorScheduler(SensorScheduleState& state);
+    
+    /**
+     * @brief Register an entry; call in the same order on every boot
+     * @param name Label for logs (static string)
+     * @param period_ms Acquisition period (> 0)
+     * @param slack_ms How early the entry may run (capped at half the period)
+     * @return Entry index, or -1 if the table is full or the period is 0
+     */
+    int8_t add(const char* name, uint32_t period_ms, uint32_t slack_ms);
+    void clear();
+    
+    uint8_t size() const { return m_count; }
+    const char* name(uint8_t index) const { return (index < m_count) ? m_entries[index].name : nullptr; }
+    uint64_t deadline(uint8_t index) const { return (index < m_count) ? m_state.deadline_ms[index] : 0; }
+    uint32_t wakes() const { return m_state.wakes; }
+    
+    /**
+     * @brief Resume the deadlines kept in the state, or start afresh
+     * 
+     * A fresh start (cold boot, changed entries, or a clock that went
+     * backwards) makes every entry due at now_ms.
+     * @return true if the kept deadlines were resumed
+     */
+    bool start(uint64_t now_ms);
+    
+    /**
+     * @brief Entries whose window has opened (bit i = entry i)
+     */
+    uint32_t dueMask(uint64_t now_ms) const;
+    
+    /**
+     * @brief Mark entries as served and move their deadlines past now_ms
+     */
+    void complete(uint32_t mask, uint64_t now_ms);
+    
+    /**
+     * @brief Earliest deadline (UINT64_MAX without entries)
+     */
+    uint64_t nextWakeMs() const;
+    
+    /**
+     * @brief Time until the next wake (0 if it is already due)
+     */
+    uint32_t sleepMs(uint64_t now_ms) const;
+    
+    /**
+     * @brief Wakes the schedule needs from now_ms over horizon_ms
+     * 
+     * Dry run on a copy of the deadlines, for logging and tests.
+     * @param uncoalesced If not null, receives the wakes without coalescing
+     *        (every entry waking on its own deadlines)
+     */
+    uint32_t plannedWakes(uint64_t now_ms, uint64_t horizon_ms, uint32_t* uncoalesced = nullptr) const;
+    
+private:
+    struct Entry {
+        const char* name;
+        uint32_t period_ms;
+        uint32_t slack_ms;
+    };
+    
+    SensorScheduleState& m_state;
+    Entry m_entries[SENSOR_SCHEDULER_MAX_ENTRIES];
+    uint8_t m_count;
+    
+    uint32_t signature() const;
+    static uint32_t dueMask(const Entry* entries, const uint64_t* deadlines, uint8_t count, uint64_t now_ms);
+    static void advance(const Entry* entries, uint64_t* deadlines, uint32_t mask, uint8_t count, uint64_t now_ms);
+    static uint64_t earliest(const uint64_t* deadlines, uint8_t count);
+};
+
+#endif // SENSOR_SCHEDULER_HPP
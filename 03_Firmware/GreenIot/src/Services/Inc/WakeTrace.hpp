@@ -0,0 +1,211 @@
+/**
+ * @file WakeTrace.hpp
+ * @brief Wake-cycle tracepoints kept across deep sleep
+ * 
+ * Architecture Layer: SERVICES LAYER
+ * Used by: main, StateMachine, PowerManager, BLEMeshManager
+ * 
+ * Tracepoints (span begin/end, instants) are 8-byte records in a ring in
+ * RTC slow memory, stamped with esp_timer microseconds since boot. Each
+ * wake opens with a CYCLE record and a CLOCK record that holds the clock
+ * time (which keeps running through deep sleep), so a host can put the
+ * cycles of many wakes on one timeline. The ring is printed over serial
+ * when it runs short of room for another cycle and is then cleared;
+ * tools/trace_to_chrome.py turns the printed records into Chrome trace
+ * JSON (chrome://tracing, ui.perfetto.dev).
+ * 
+ * Tracepoints are compiled in only with WAKE_TRACE_ENABLE (the
+ * esp32-c3-trace env); otherwise the TRACE_* macros expand to nothing.
+ * Recording is for task context only: no locking, not from an ISR.
+ * 
+ * Dump format (one log line per record, tag TRACE):
+ * 
+ *   <type> <point> <time_us> <arg>
+ * 
+ *   B/E/I  span begin, span end, instant (arg is point specific)
+ *   C      cycle start: arg = wake counter
+ *   K      clock at cycle start: time_us = clock seconds, arg = milliseconds
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#ifndef WAKE_TRACE_HPP
+#define WAKE_TRACE_HPP
+
+#include <cstdint>
+
+#ifndef WAKE_TRACE_CAPACITY
+#define WAKE_TRACE_CAPACITY 128      // 1 KB of RTC memory
+#endif
+#define WAKE_TRACE_CYCLE_RESERVE 48  // Room kept for one more wake before a dump
+
+/**
+ * @brief Record types
+ */
+enum class TraceType : uint8_t {
+    BEGIN = 0,
+    END,
+    INSTANT,
+    CYCLE,
+    CLOCK
+};
+
+/**
+ * @brief Tracepoints (append only: the host tool reads the printed names)
+ */
+enum class TracePoint : uint8_t {
+    NONE = 0,
+    SETUP,            // Arduino setup()
+    I2C_INIT,
+    POWER_INIT,       // PowerManager: ADC, GPIO, light sleep
+    SENSOR_STARTUP,   // Waiting for the rail to settle
+    SENSOR_INIT,
+    RADIO_START,      // StateMachine::startRadio()
+    NVS_INIT,
+    BLE_STACK,        // BT controller and Bluedroid
+    BLUEDROID,        // Instant: controller up, Bluedroid starting
+    MESH_INIT,
+    STATE_INIT,       // One span per state (SystemState order)
+    STATE_IDLE,
+    STATE_MEASURE,
+    STATE_TRANSMIT,
+    STATE_SLEEP,
+    STATE_ERROR,
+    MEASURE_ONLY,     // Instant: radio stays off this wake
+    RADIO_DONE,       // Instant: arg = BLEMeshStatus
+    DEEP_SLEEP,       // Instant: arg = sleep (s)
+    TRACE_DUMP,       // Instant: arg = records printed before this cycle
+    COUNT
+};
+
+inline const char* tracePointName(TracePoint point) {
+    switch (point) {
+        case TracePoint::SETUP: return "SETUP";
+        case TracePoint::I2C_INIT: return "I2C_INIT";
+        case TracePoint::POWER_INIT: return "POWER_INIT";
+        case TracePoint::SENSOR_STARTUP: return "SENSOR_STARTUP";
+        case TracePoint::SENSOR_INIT: return "SENSOR_INIT";
+        case TracePoint::RADIO_START: return "RADIO_START";
+        case TracePoint::NVS_INIT: return "NVS_INIT";
+        case TracePoint::BLE_STACK: return "BLE_STACK";
+        case TracePoint::BLUEDROID: return "BLUEDROID";
+        case TracePoint::MESH_INIT: return "MESH_INIT";
+        case TracePoint::STATE_INIT: return "INIT";
+        case TracePoint::STATE_IDLE: return "IDLE";
+        case TracePoint::STATE_MEASURE: return "MEASURE";
+        case TracePoint::STATE_TRANSMIT: return "TRANSMIT";
+        case TracePoint::STATE_SLEEP: return "SLEEP";
+        case TracePoint::STATE_ERROR: return "ERROR";
+        case TracePoint::MEASURE_ONLY: return "MEASURE_ONLY";
+        case TracePoint::RADIO_DONE: return "RADIO_DONE";
+        case TracePoint::DEEP_SLEEP: return "DEEP_SLEEP";
+        case TracePoint::TRACE_DUMP: return "TRACE_DUMP";
+        default: return "-";
+    }
+}
+
+/**
+ * @brief One record (8 bytes)
+ */
+struct TraceEvent {
+    uint32_t time_us;     // esp_timer since boot (CLOCK: clock seconds)
+    uint16_t arg;
+    TraceType type;
+    TracePoint point;
+};
+
+/**
+ * @brief Trace ring kept across deep sleep
+ */
+struct WakeTraceState {
+    uint32_t magic;
+    uint16_t head;        // Index of the oldest record
+    uint16_t count;
+    uint16_t cycle;       // Wakes since the trace was started
+    uint16_t lost;        // Records overwritten before they were printed
+    TraceEvent events[WAKE_TRACE_CAPACITY];
+};
+
+/**
+ * @brief Ring of tracepoint records
+ */
+class WakeTrace {
+public:
+    explicit WakeTrace(WakeTraceState& state) : m_state(state) {}
+    
+    /**
+     * @brief The firmware's trace (ring in RTC memory)
+     */
+    static WakeTrace& getInstance();
+    
+    /**
+     * @brief Open a wake: check the kept ring, print and clear it if another
+     *        cycle might not fit, then record CYCLE and CLOCK
+     * @param clock_ms Clock time (keeps counting through deep sleep)
+     */
+    void startCycle(uint64_t clock_ms);
+    
+    /**
+     * @brief Append a record (dropped until the first startCycle())
+     */
+    void record(TraceType type, TracePoint point, uint16_t arg = 0);
+    
+    /**
+     * @brief Print every record (TRACE log lines, see file header)
+     */
+    void dump() const;
+    
+    void clear();
+    
+    uint16_t size() const { return m_state.count; }
+    uint16_t lost() const { return m_state.lost; }
+    uint16_t cycle() const { return m_state.cycle; }
+    bool dumpDue() const { return m_state.count > WAKE_TRACE_CAPACITY - WAKE_TRACE_CYCLE_RESERVE; }
+    
+    /**
+     * @brief Record by age (0 = oldest)
+     * @return false if index is out of range
+     */
+    bool event(uint16_t index, TraceEvent& out) const;
+    
+private:
+    WakeTraceState& m_state;
+    
+    bool valid() const;
+    void append(const TraceEvent& ev);
+};
+
+/**
+ * @brief Records the end of a span when it goes out of scope
+ */
+class WakeTraceScope {
+public:
+    explicit WakeTraceScope(TracePoint point) : m_point(point) {
+        WakeTrace::getInstance().record(TraceType::BEGIN, point);
+    }
+    ~WakeTraceScope() { WakeTrace::getInstance().record(TraceType::END, m_point); }
+    
+    WakeTraceScope(const WakeTraceScope&) = delete;
+    WakeTraceScope& operator=(const WakeTraceScope&) = delete;
+    
+private:
+    TracePoint m_point;
+};
+
+#ifdef WAKE_TRACE_ENABLE
+#define TRACE_START_CYCLE(clock_ms) WakeTrace::getInstance().startCycle(clock_ms)
+#define TRACE_BEGIN(point) WakeTrace::getInstance().record(TraceType::BEGIN, (point))
+#define TRACE_END(point) WakeTrace::getInstance().record(TraceType::END, (point))
+#define TRACE_INSTANT(point, arg) \
+    WakeTrace::getInstance().record(TraceType::INSTANT, (point), static_cast<uint16_t>(arg))
+#define TRACE_SCOPE(point) WakeTraceScope trace_scope_(point)
+#else
+#define TRACE_START_CYCLE(clock_ms) do {} while (0)
+#define TRACE_BEGIN(point) do {} while (0)
+#define TRACE_END(point) do {} while (0)
+#define TRACE_INSTANT(point, arg) do {} while (0)
+#define TRACE_SCOPE(point) do {} while (0)
+#endif
+
+#endif // WAKE_TRACE_HPP
@@ -0,0 +1,138 @@
+/**
+ * @file MeasurementBatch.cpp
+ * @brief RTC measurement batch implementation
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#include "MeasurementBatch.hpp"
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+
+static const char* TAG = "BATCH";
+
+#define BATCH_MAGIC 0x42415431  // "BAT1"
+
+bool MeasurementBatch::restore() {
+    if (m_state.magic == BATCH_MAGIC && m_state.crc == crc() &&
+        m_state.count <= MEASUREMENT_BATCH_CAPACITY && m_state.head < MEASUREMENT_BATCH_CAPACITY) {
+        return true;
+    }
+    
+    // Cold boot (all zero) is not worth a warning
+    if (m_state.magic != 0) {
+        ESP_LOGW(TAG, "Kept batch corrupt, discarded");
+    }
+    clear();
+    return false;
+}
+
+void MeasurementBatch::clear() {
+    m_state.oldest_time_s = 0;
+    m_state.newest_time_s = 0;
+    m_state.head = 0;
+    m_state.count = 0;
+    m_state.dropped = 0;
+    seal();
+}
+
+void MeasurementBatch::push(uint32_t time_s, const SensorData& data) {
+    if (full()) {
+        // The second oldest becomes the oldest: its delta moves into the base time
+        m_state.head = (m_state.head + 1) % MEASUREMENT_BATCH_CAPACITY;
+        m_state.count--;
+        m_state.oldest_time_s += at(0).delta_s;
+        m_state.dropped++;
+    }
+    
+    uint32_t delta_s = 0;
+    if (m_state.count == 0) {
+        m_state.oldest_time_s = time_s;
+    } else if (time_s > m_state.newest_time_s) {
+        delta_s = time_s - m_state.newest_time_s;
+        if (delta_s > UINT16_MAX) delta_s = UINT16_MAX;
+    }
+    
+    BatchSample& slot = m_state.samples[(m_state.head + m_state.count) % MEASUREMENT_BATCH_CAPACITY];
+    slot.delta_s = static_cast<uint16_t>(delta_s);
+    slot.temperature_centi_c = data.temperature_centi_c;
+    slot.humidity_centi_pct = data.humidity_centi_pct;
+    m_state.count++;
+    m_state.newest_time_s = (m_state.count == 1) ? time_s : m_state.newest_time_s + delta_s;
+    seal();
+}
+
+void MeasurementBatch::consume(uint8_t count) {
+    if (count >= m_state.count) {
+        clear();
+        return;
+    }
+    
+    for (uint8_t i = 0; i < count; i++) {
+        m_state.head = (m_state.head + 1) % MEASUREMENT_BATCH_CAPACITY;
+        m_state.count--;
+        m_state.oldest_time_s += at(0).delta_s;
+    }
+    m_state.dropped = 0;
+    seal();
+}
+
+bool MeasurementBatch::sample(uint8_t index, uint32_t& time_s, SensorData& data) const {
+    if (index >= m_state.count) {
+        return false;
+    }
+    
+    time_s = m_state.oldest_time_s;
+    for (uint8_t i = 1; i <= index; i++) {
+        time_s += at(i).delta_s;
+    }
+    const BatchSample& kept = at(index);
+    data = SensorData();
+    data.temperature_centi_c = kept.temperature_centi_c;
+    data.humidity_centi_pct = kept.humidity_centi_pct;
+    data.quality_flags = 0xC0;  // Only valid readings are kept
+    return true;
+}
+
+size_t MeasurementBatch::encode(uint8_t* out, uint32_t now_s, uint8_t battery_percent) const {
+    if (m_state.count == 0) {
+        return 0;
+    }
+    
+    uint32_t age_s = (now_s > m_state.newest_time_s) ? now_s - m_state.newest_time_s : 0;
+    if (age_s > UINT16_MAX) age_s = UINT16_MAX;
+    
+    uint8_t* p = out;
+    *p++ = MEASUREMENT_BATCH_VERSION;
+    *p++ = m_state.count;
+    *p++ = (battery_percent > 100) ? 100 : battery_percent;
+    *p++ = static_cast<uint8_t>(age_s & 0xFF);
+    *p++ = static_cast<uint8_t>(age_s >> 8);
+    
+    for (uint8_t i = 0; i < m_state.count; i++) {
+        const BatchSample& kept = at(i);
+        const uint16_t words[3] = {
+            static_cast<uint16_t>((i == 0) ? 0 : kept.delta_s),
+            static_cast<uint16_t>(kept.temperature_centi_c),
+            kept.humidity_centi_pct
+        };
+        for (uint16_t word : words) {
+            *p++ = static_cast<uint8_t>(word & 0xFF);
+            *p++ = static_cast<uint8_t>(word >> 8);
+        }
+    }
+    return static_cast<size_t>(p - out);
+}
+
+// Private helper methods
+
+void MeasurementBatch::seal() {
+    m_state.magic = BATCH_MAGIC;
+    m_state.crc = crc();
+}
+
+uint32_t MeasurementBatch::crc() const {
+    return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&m_state),
+                            offsetof(MeasurementBatchState, crc));
+}
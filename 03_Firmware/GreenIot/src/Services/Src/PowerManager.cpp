@@ -13,15 +13,20 @@
  */
 
 #include "PowerManager.hpp"
+#include "ISensor.hpp"
+#include "WakeTrace.hpp"
+#include "esp_attr.h"
 #include "esp_log.h"
 #include "esp_sleep.h"
 #include "esp_pm.h"
+#include "esp_timer.h"
 #include "driver/gpio.h"
 #include "driver/adc.h"
 #include "esp_adc_cal.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "soc/rtc.h"
+#include "esp_private/esp_clk.h"
 
 static const char* TAG = "POWER";
 
@@ -30,6 +35,7 @@ RTC_DATA_ATTR static uint32_t s_boot_count = 0;
 RTC_DATA_ATTR static uint32_t s_total_wakeups = 0;
 RTC_DATA_ATTR static uint32_t s_total_active_time_ms = 0;
 RTC_DATA_ATTR static uint32_t s_total_sleep_time_ms = 0;
+RTC_DATA_ATTR static bool s_sensor_power_held = false;  // Sensor rail held up through deep sleep
 
 PowerManager& PowerManager::getInstance() {
     static PowerManager instance;
@@ -38,11 +44,36 @@ PowerManager& PowerManager::getInstance() {
 
 void PowerManager::init(const PowerConfig& config) {
     m_config = config;
+    m_sensor_model.wait_current_ua = config.sensor_wait_current_ua;
+    m_sensor_model.rail_charge_nc = config.sensor_rail_charge_nc;
     
     // Initialize GPIO for sensor power control
     if (config.enable_sensor_power_control) {
         initGPIO();
-        sensorPowerOff();  // Start with sensor off (will be turned on when needed)
+        gpio_num_t power_pin = static_cast<gpio_num_t>(config.sensor_power_pin);
+        if (s_sensor_power_held) {
+            // Sensor stayed powered through deep sleep: keep it on, release
+            // the hold; it is past its startup time already
+            gpio_set_level(power_pin, 1);
+            gpio_hold_dis(power_pin);
+            m_sensor_powered = true;
+            m_sensor_ready = true;
+            s_sensor_power_held = false;
+        } else {
+            // Rail was gated through the sleep; powered up when needed
+            gpio_set_level(power_pin, 0);
+            m_sensor_powered = false;
+        }
+    } else {
+        m_sensor_ready = true;  // Always powered
+    }
+    
+    if (config.enable_sensor_alert_wake) {
+        initAlertGPIO();
+    }
+    
+    if (config.enable_auto_light_sleep) {
+        initAutoLightSleep();
     }
     
     // Initialize ADC for battery monitoring
@@ -54,11 +85,11 @@ void PowerManager::init(const PowerConfig& config) {
     // Increment boot count
     s_boot_count++;
     
-    ESP_LOGI(TAG, "PowerManager initialized");
-    ESP_LOGI(TAG, "  Boot count: %u", (unsigned int)s_boot_count);
-    ESP_LOGI(TAG, "  Deep sleep interval: %d sec", (int)config.deep_sleep_duration_sec);
-    ESP_LOGI(TAG, "  Light sleep: %d ms", (int)config.light_sleep_duration_ms);
-    ESP_LOGI(TAG, "  Sensor power pin: GPIO %d (%s)", 
+    ESP_LOGD(TAG, "PowerManager initialized");
+    ESP_LOGD(TAG, "  Boot count: %u", (unsigned int)s_boot_count);
+    ESP_LOGD(TAG, "  Deep sleep interval: %d sec", (int)config.deep_sleep_duration_sec);
+    ESP_LOGD(TAG, "  Light sleep: %d ms", (int)config.light_sleep_duration_ms);
+    ESP_LOGD(TAG, "  Sensor power pin: GPIO %d (%s)", 
              config.sensor_power_pin,
              config.enable_sensor_power_control ? "enabled" : "disabled");
     
@@ -74,21 +105,105 @@ void PowerManager::initGPIO() {
     io_conf.intr_type = GPIO_INTR_DISABLE;
     
     gpio_config(&io_conf);
-    ESP_LOGI(TAG, "Sensor power GPIO %d configured", m_config.sensor_power_pin);
+    ESP_LOGD(TAG, "Sensor power GPIO %d configured", m_config.sensor_power_pin);
+}
+
+void PowerManager::initAlertGPIO() {
+    gpio_config_t io_conf = {};
+    io_conf.pin_bit_mask = (1ULL << m_config.sensor_alert_pin);
+    io_conf.mode = GPIO_MODE_INPUT;
+    io_conf.pull_up_en = GPIO_PULLUP_DISABLE;
+    io_conf.pull_down_en = GPIO_PULLDOWN_ENABLE;  // ALERT is active-high; idle low when unpowered
+    io_conf.intr_type = GPIO_INTR_DISABLE;
+    
+    gpio_config(&io_conf);
+    ESP_LOGD(TAG, "Sensor ALERT GPIO %d configured", m_config.sensor_alert_pin);
+}
+
+void PowerManager::initAutoLightSleep() {
+    // With tickless idle the idle task light-sleeps until the next timer or
+    // task timeout whenever every task is blocked
+    esp_pm_config_t pm_config = {};
+    pm_config.max_freq_mhz = CPU_FREQ_MAX_MHZ;
+    pm_config.min_freq_mhz = CPU_FREQ_MIN_MHZ;
+    pm_config.light_sleep_enable = true;
+    
+    esp_err_t err = esp_pm_configure(&pm_config);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Automatic light sleep not available (%d), CPU stays clocked when idle", err);
+        return;
+    }
+    ESP_LOGD(TAG, "Automatic light sleep enabled (%d-%d MHz)", CPU_FREQ_MIN_MHZ, CPU_FREQ_MAX_MHZ);
+}
+
+void PowerManager::setSensorAlertHandler(void (*handler)(void* arg), void* arg) {
+    if (!m_config.enable_sensor_alert_wake) {
+        return;
+    }
+    
+    gpio_num_t alert_pin = static_cast<gpio_num_t>(m_config.sensor_alert_pin);
+    gpio_intr_disable(alert_pin);
+    m_alert_handler = handler;
+    m_alert_handler_arg = arg;
+    
+    // ESP_ERR_INVALID_STATE: the service is already installed
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "GPIO ISR service install failed: %d", err);
+        m_alert_handler = nullptr;
+        return;
+    }
+    gpio_isr_handler_add(alert_pin, sensorAlertIsr, this);
+    gpio_intr_disable(alert_pin);
+}
+
+void PowerManager::enableSensorAlertInterrupt(bool enable) {
+    if (m_alert_handler == nullptr) {
+        return;
+    }
+    
+    gpio_num_t alert_pin = static_cast<gpio_num_t>(m_config.sensor_alert_pin);
+    if (enable) {
+        if (gpio_get_level(alert_pin) != 0) {
+            // Excursion still going on: it would fire at once, again and again
+            ESP_LOGW(TAG, "ALERT already active, no alert interrupt");
+            return;
+        }
+        
+        // High level: the only trigger that also wakes the chip from light sleep
+        gpio_wakeup_enable(alert_pin, GPIO_INTR_HIGH_LEVEL);
+        esp_sleep_enable_gpio_wakeup();
+        gpio_intr_enable(alert_pin);
+    } else {
+        gpio_intr_disable(alert_pin);
+        gpio_wakeup_disable(alert_pin);
+    }
+}
+
+void IRAM_ATTR PowerManager::sensorAlertIsr(void* arg) {
+    PowerManager* self = static_cast<PowerManager*>(arg);
+    
+    // Level-triggered: off until re-armed, or it fires for as long as ALERT is high
+    gpio_intr_disable(static_cast<gpio_num_t>(self->m_config.sensor_alert_pin));
+    self->m_alert_handler(self->m_alert_handler_arg);
+}
+
+void PowerManager::armSensorAlertWake(bool armed) {
+    m_alert_wake_armed = armed && m_config.enable_sensor_alert_wake;
+    ESP_LOGI(TAG, "Sensor ALERT wake %s", m_alert_wake_armed ? "armed" : "disarmed");
 }
 
 void PowerManager::sensorPowerOn() {
-    if (!m_config.enable_sensor_power_control) {
-        return;  // Power control disabled
+    if (!m_config.enable_sensor_power_control || m_sensor_powered) {
+        return;  // Power control disabled or already on
     }
     
     gpio_set_level(static_cast<gpio_num_t>(m_config.sensor_power_pin), 1);
     m_sensor_powered = true;
+    m_sensor_ready = false;
+    m_sensor_power_on_us = esp_timer_get_time();
     
-    // Wait for sensor to stabilize (typically 10-50ms for SHT31)
-    vTaskDelay(pdMS_TO_TICKS(50));
-    
-    ESP_LOGI(TAG, "Sensor power ON (GPIO %d)", m_config.sensor_power_pin);
+    ESP_LOGD(TAG, "Sensor power ON (GPIO %d)", m_config.sensor_power_pin);
 }
 
 void PowerManager::sensorPowerOff() {
@@ -98,8 +213,60 @@ void PowerManager::sensorPowerOff() {
     
     gpio_set_level(static_cast<gpio_num_t>(m_config.sensor_power_pin), 0);
     m_sensor_powered = false;
+    m_sensor_ready = false;
     
-    ESP_LOGI(TAG, "Sensor power OFF (GPIO %d)", m_config.sensor_power_pin);
+    ESP_LOGD(TAG, "Sensor power OFF (GPIO %d)", m_config.sensor_power_pin);
+}
+
+void PowerManager::configureSensorPower(const SensorInfo& info) {
+    m_sensor_model.startup_time_ms = info.startup_time_ms;
+    m_sensor_model.sensor_idle_na = info.power_sleep_na;
+    m_sensor_model.sensor_active_ua = info.power_active_ua;
+    m_sensor_model.reset_time_ms = info.reset_time_ms;
+    m_sensor_model.first_conversion_ms = info.first_conversion_ms;
+    
+    ESP_LOGD(TAG, "Sensor rail: %u ms startup, %u nA idle, gated for sleeps over %u s",
+             info.startup_time_ms, (unsigned int)info.power_sleep_na,
+             (unsigned int)(SensorPowerPolicy::breakEvenMs(m_sensor_model) / 1000));
+}
+
+void PowerManager::waitSensorStartup() {
+    if (m_sensor_ready || !m_sensor_powered) {
+        return;
+    }
+    
+    uint32_t remaining_ms = sensorStartupRemainingMs();
+    if (remaining_ms > 0) {
+        TRACE_SCOPE(TracePoint::SENSOR_STARTUP);
+        vTaskDelay(pdMS_TO_TICKS(remaining_ms));
+    }
+    m_sensor_ready = true;
+}
+
+uint32_t PowerManager::sensorStartupRemainingMs() const {
+    if (m_sensor_ready || !m_sensor_powered) {
+        return 0;
+    }
+    
+    int64_t ready_us = m_sensor_power_on_us + static_cast<int64_t>(m_sensor_model.startup_time_ms) * 1000;
+    int64_t remaining_us = ready_us - esp_timer_get_time();
+    return (remaining_us > 0) ? static_cast<uint32_t>((remaining_us + 999) / 1000) : 0;
+}
+
+bool PowerManager::keepSensorPowered(uint32_t sleep_ms) const {
+    if (!m_config.enable_sensor_power_control) {
+        return true;
+    }
+    return SensorPowerPolicy::keepPowered(m_sensor_model, sleep_ms);
+}
+
+uint64_t PowerManager::slowClockTicks() const {
+    return rtc_time_get();
+}
+
+uint32_t PowerManager::slowClockPeriod() const {
+    // Measured by the startup code on every boot, deep sleep wakes included
+    return esp_clk_slowclk_cal_get();
 }
 
 void PowerManager::configureWakeupTimer(uint32_t duration_sec) {
@@ -110,8 +277,11 @@ void PowerManager::configureWakeupTimer(uint32_t duration_sec) {
 void PowerManager::enterLightSleep(uint32_t duration_ms) {
     ESP_LOGI(TAG, "Entering light sleep for %d ms", (int)duration_ms);
     
-    // Turn off sensor to save power
-    sensorPowerOff();
+    // Gate the sensor only if the sleep is past break-even; it is powered
+    // up again when the next measurement needs it
+    if (!keepSensorPowered(duration_ms)) {
+        sensorPowerOff();
+    }
     
     // Configure wake-up timer
     esp_sleep_enable_timer_wakeup(duration_ms * 1000ULL);
@@ -119,26 +289,52 @@ void PowerManager::enterLightSleep(uint32_t duration_ms) {
     // Enter light sleep (BLE Mesh connection maintained)
     esp_light_sleep_start();
     
-    // Turn sensor back on after wake-up
-    sensorPowerOn();
-    
     ESP_LOGI(TAG, "Woke from light sleep");
 }
 
-void PowerManager::enterDeepSleep(uint32_t duration_sec) {
-    ESP_LOGI(TAG, "Preparing for deep sleep (%d seconds)...", (int)duration_sec);
+void PowerManager::enterDeepSleepMs(uint32_t duration_ms) {
+    ESP_LOGI(TAG, "Preparing for deep sleep (%u ms)...", (unsigned int)duration_ms);
     
     // Save state to RTC memory before sleep
     saveStateToRTC();
     
-    // Turn off sensor to save power
-    sensorPowerOff();
-    
     // Configure wake-up timer
-    esp_sleep_enable_timer_wakeup(duration_sec * 1000000ULL);
+    esp_sleep_enable_timer_wakeup(duration_ms * 1000ULL);
+    
+    bool keep_for_alert = false;
+    if (m_alert_wake_armed) {
+        gpio_num_t alert_pin = static_cast<gpio_num_t>(m_config.sensor_alert_pin);
+        if (gpio_get_level(alert_pin) != 0) {
+            // Level-triggered wake would fire at once; rely on the timer instead
+            ESP_LOGW(TAG, "ALERT already active, timer wake only");
+        } else {
+            esp_deep_sleep_enable_gpio_wakeup(1ULL << m_config.sensor_alert_pin,
+                                              ESP_GPIO_WAKEUP_GPIO_HIGH);
+            keep_for_alert = true;
+        }
+    }
     
-    // Optional: Enable GPIO wake-up (e.g., button press)
-    // esp_sleep_enable_ext0_wakeup(GPIO_NUM_9, 0);  // Wake on LOW
+    // Otherwise the rail stays up only below break-even: the idle sensor then
+    // costs less than powering it up again at the next wake
+    bool keep_sensor_powered = keep_for_alert ||
+        (m_sensor_powered && keepSensorPowered(duration_ms));
+    
+    if (keep_sensor_powered && m_config.enable_sensor_power_control) {
+        // Hold the power pin high through deep sleep
+        gpio_num_t power_pin = static_cast<gpio_num_t>(m_config.sensor_power_pin);
+        gpio_set_level(power_pin, 1);
+        gpio_hold_en(power_pin);
+        gpio_deep_sleep_hold_en();
+        s_sensor_power_held = true;
+        if (keep_for_alert) {
+            ESP_LOGI(TAG, "Sensor kept powered for ALERT wake (GPIO %d)", m_config.sensor_alert_pin);
+        } else {
+            ESP_LOGI(TAG, "Sensor kept powered, sleep below break-even (GPIO %d)", m_config.sensor_power_pin);
+        }
+    } else if (!keep_sensor_powered) {
+        // Turn off sensor to save power
+        sensorPowerOff();
+    }
     
     // Configure which domains to power down in deep sleep
     // Keep RTC peripherals powered for timer wake-up
@@ -147,6 +343,7 @@ void PowerManager::enterDeepSleep(uint32_t duration_sec) {
     esp_sleep_pd_config(ESP_PD_DOMAIN_RTC_FAST_MEM, ESP_PD_OPTION_ON);
     
     ESP_LOGI(TAG, "Entering deep sleep...");
+    TRACE_INSTANT(TracePoint::DEEP_SLEEP, duration_ms / 1000);
     esp_deep_sleep_start();
     
     // NOTE: Execution NEVER reaches here (device resets on wakeup)
@@ -163,6 +360,9 @@ WakeupSource PowerManager::getWakeupCause() {
         case ESP_SLEEP_WAKEUP_TIMER:
             s_total_wakeups++;
             return WakeupSource::TIMER;
+        case ESP_SLEEP_WAKEUP_GPIO:
+            s_total_wakeups++;
+            return WakeupSource::SENSOR_ALERT;
         case ESP_SLEEP_WAKEUP_EXT0:
         case ESP_SLEEP_WAKEUP_EXT1:
             return WakeupSource::BUTTON;
@@ -202,40 +402,31 @@ uint16_t PowerManager::readBatteryADC() {
     return static_cast<uint16_t>(sum / samples);
 }
 
-float PowerManager::getBatteryVoltage() {
+uint16_t PowerManager::getBatteryMillivolts() {
     uint16_t adc_value = readBatteryADC();
     
     if (adc_value == 0) {
-        return 0.0f;  // Invalid reading
+        return 0;  // Invalid reading
     }
     
     // ESP32-C3 ADC: 0-3.3V @ 12-bit (0-4095)
     // Assuming voltage divider: Vbat -> R1=100k -> ADC_PIN -> R2=100k -> GND
     // ADC reads Vbat/2, so multiply by 2
-    float voltage = (adc_value / 4095.0f) * 3.3f * 2.0f;
-    
-    return voltage;
+    return adcToMillivolts(adc_value);
 }
 
 uint8_t PowerManager::getBatteryPercent() {
-    float voltage = getBatteryVoltage();
+    uint16_t battery_mv = getBatteryMillivolts();
     
-    if (voltage == 0.0f) {
+    if (battery_mv == 0) {
         return 0;  // Invalid reading
     }
     
     // Li-Ion battery voltage range: 3.0V (empty) to 4.2V (full)
-    const float V_MIN = 3.0f;
-    const float V_MAX = 4.2f;
-    
-    if (voltage >= V_MAX) return 100;
-    if (voltage <= V_MIN) return 0;
-    
-    uint8_t percent = static_cast<uint8_t>(((voltage - V_MIN) / (V_MAX - V_MIN)) * 100.0f);
-    return percent;
+    return millivoltsToPercent(battery_mv);
 }
 
-float PowerManager::measureCurrentConsumption() {
+uint32_t PowerManager::measureCurrentConsumption() {
     // Note: ESP32-C3 doesn't have built-in current measurement
     // This is a placeholder that calculates based on power states
     // For actual measurement, use external current sensor (e.g., INA219)
@@ -243,10 +434,10 @@ float PowerManager::measureCurrentConsumption() {
     // Estimated consumption based on mode
     if (m_sensor_powered) {
         // Active mode: ESP32-C3 (~50mA) + Sensor (~1mA) = ~51mA
-        return 51000.0f;  // µA
+        return 51000;  // µA
     } else {
         // Sleep mode: Deep sleep ~10µA
-        return 10.0f;  // µA
+        return 10;  // µA
     }
 }
 
@@ -254,46 +445,39 @@ void PowerManager::updatePowerStats(uint32_t active_time_ms, uint32_t sleep_time
     s_total_active_time_ms += active_time_ms;
     s_total_sleep_time_ms += sleep_time_ms;
     
-    // Calculate average current consumption
-    float active_current_ua = measureCurrentConsumption();
-    float sleep_current_ua = 10.0f;  // Deep sleep current
+    // Calculate average current consumption (64-bit charge: µA x ms)
+    uint32_t active_current_ua = measureCurrentConsumption();
+    uint32_t sleep_current_ua = 10;  // Deep sleep current
     
-    uint32_t total_time_ms = active_time_ms + sleep_time_ms;
+    uint64_t total_time_ms = static_cast<uint64_t>(active_time_ms) + sleep_time_ms;
     if (total_time_ms > 0) {
-        m_stats.avg_current_ua = ((active_current_ua * active_time_ms) + 
-                                  (sleep_current_ua * sleep_time_ms)) / total_time_ms;
+        uint64_t charge = static_cast<uint64_t>(active_current_ua) * active_time_ms +
+                          static_cast<uint64_t>(sleep_current_ua) * sleep_time_ms;
+        m_stats.avg_current_ua = static_cast<uint32_t>(charge / total_time_ms);
     }
     
-    m_stats.active_current_ma = active_current_ua / 1000.0f;
+    m_stats.active_current_ua = active_current_ua;
     m_stats.sleep_current_ua = sleep_current_ua;
     m_stats.total_active_time_ms = s_total_active_time_ms;
     m_stats.total_sleep_time_ms = s_total_sleep_time_ms;
     m_stats.wakeup_count = s_total_wakeups;
     
     // Calculate estimated battery life
-    float battery_voltage = getBatteryVoltage();
-    if (battery_voltage > 0.0f && m_stats.avg_current_ua > 0.0f) {
+    if (getBatteryMillivolts() > 0 && m_stats.avg_current_ua > 0) {
         // Battery capacity estimate (assuming 2000mAh)
-        float battery_capacity_mah = 2000.0f;
-        float daily_consumption_mah = (m_stats.avg_current_ua / 1000.0f) * 24.0f;
-        m_stats.estimated_battery_life_days = battery_capacity_mah / daily_consumption_mah;
+        m_stats.estimated_battery_life_days = calculateBatteryLife(2000);
     }
 }
 
-float PowerManager::calculateBatteryLife(uint32_t battery_capacity_mah) const {
-    if (m_stats.avg_current_ua <= 0.0f) {
-        return 0.0f;
-    }
-    
-    // Calculate daily consumption
-    float daily_consumption_mah = (m_stats.avg_current_ua / 1000.0f) * 24.0f;
-    
-    if (daily_consumption_mah <= 0.0f) {
-        return 0.0f;
+uint32_t PowerManager::calculateBatteryLife(uint32_t battery_capacity_mah) const {
+    if (m_stats.avg_current_ua == 0) {
+        return 0;
     }
     
-    // Return battery life in days
-    return battery_capacity_mah / daily_consumption_mah;
+    // days = capacity / daily consumption = capacity_mAh * 1000 / (avg_µA * 24 h)
+    uint64_t daily_consumption_uah = static_cast<uint64_t>(m_stats.avg_current_ua) * 24;
+    return static_cast<uint32_t>(static_cast<uint64_t>(battery_capacity_mah) * 1000 /
+                                 daily_consumption_uah);
 }
 
 void PowerManager::enableAutoSleep(bool enable) {
@@ -313,9 +497,9 @@ void PowerManager::restoreStateFromRTC() {
     m_stats.total_active_time_ms = s_total_active_time_ms;
     m_stats.total_sleep_time_ms = s_total_sleep_time_ms;
     
-    ESP_LOGI(TAG, "State restored from RTC:");
-    ESP_LOGI(TAG, "  Total wake-ups: %u", (unsigned int)s_total_wakeups);
-    ESP_LOGI(TAG, "  Total active time: %u ms", (unsigned int)s_total_active_time_ms);
-    ESP_LOGI(TAG, "  Total sleep time: %u ms", (unsigned int)s_total_sleep_time_ms);
+    ESP_LOGD(TAG, "State restored from RTC:");
+    ESP_LOGD(TAG, "  Total wake-ups: %u", (unsigned int)s_total_wakeups);
+    ESP_LOGD(TAG, "  Total active time: %u ms", (unsigned int)s_total_active_time_ms);
+    ESP_LOGD(TAG, "  Total sleep time: %u ms", (unsigned int)s_total_sleep_time_ms);
 }
 
@@ -0,0 +1,92 @@
+/**
+ * @file RtcTimebase.cpp
+ * @brief RTC slow-clock timebase implementation
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#include "RtcTimebase.hpp"
+#include "esp_log.h"
+
+static const char* TAG = "TIMEBASE";
+
+#define TIMEBASE_MAGIC 0x54494D31  // "TIM1"
+
+// Period of a 136 kHz RC clock is ~7.35 µs; anything far off is not a calibration
+#define PERIOD_MIN_Q19 (1UL << RTC_TIMEBASE_PERIOD_SHIFT)          // 1 µs (1 MHz)
+#define PERIOD_MAX_Q19 (100UL << RTC_TIMEBASE_PERIOD_SHIFT)        // 100 µs (10 kHz)
+
+bool RtcTimebase::start(uint64_t ticks, uint32_t period_q19, bool timer_wake) {
+    if (!valid()) {
+        // Cold boot: the clock starts where the counter is (time since power-on)
+        m_state.magic = TIMEBASE_MAGIC;
+        m_state.base_us = ticksToUs(ticks, period_q19);
+        m_state.base_ticks = ticks;
+        m_state.period_q19 = period_q19;
+        m_state.wake_at_us = 0;
+        m_state.wake_latency_us = 0;
+        m_state.drift_ppm = 0;
+        m_state.sleeps = 0;
+        return false;
+    }
+    
+    if (ticks < m_state.base_ticks) {
+        // Counter reset with RTC memory kept: the gap is unknown, stay monotonic
+        ESP_LOGW(TAG, "RTC counter restarted, sleep time lost");
+        m_state.base_us += ticksToUs(ticks, period_q19);
+    } else {
+        // Mean of the periods at both ends of the sleep
+        uint32_t sleep_period = static_cast<uint32_t>((static_cast<uint64_t>(m_state.period_q19) + period_q19) / 2);
+        m_state.base_us += ticksToUs(ticks - m_state.base_ticks, sleep_period);
+        
+        uint32_t change = (period_q19 > m_state.period_q19) ? period_q19 - m_state.period_q19
+                                                            : m_state.period_q19 - period_q19;
+        uint32_t ppm = static_cast<uint32_t>(static_cast<uint64_t>(change) * 1000000 / m_state.period_q19);
+        m_state.drift_ppm = (m_state.sleeps == 0) ? ppm : m_state.drift_ppm - m_state.drift_ppm / 4 + ppm / 4;
+        m_state.sleeps++;
+    }
+    m_state.base_ticks = ticks;
+    m_state.period_q19 = period_q19;
+    
+    // Timer wakes only: a GPIO wake comes before the timer would have fired
+    if (timer_wake && m_state.wake_at_us != 0 && m_state.base_us >= m_state.wake_at_us &&
+        m_state.base_us - m_state.wake_at_us < RTC_TIMEBASE_LATENCY_MAX_US) {
+        uint32_t latency = static_cast<uint32_t>(m_state.base_us - m_state.wake_at_us);
+        m_state.wake_latency_us = (m_state.wake_latency_us == 0)
+                                      ? latency
+                                      : m_state.wake_latency_us - m_state.wake_latency_us / 4 + latency / 4;
+    }
+    m_state.wake_at_us = 0;
+    return true;
+}
+
+uint64_t RtcTimebase::nowUs(uint64_t ticks) const {
+    if (ticks < m_state.base_ticks) {
+        return m_state.base_us;
+    }
+    return m_state.base_us + ticksToUs(ticks - m_state.base_ticks, m_state.period_q19);
+}
+
+uint64_t RtcTimebase::sleepUs(uint64_t now_us, uint64_t deadline_us) const {
+    uint64_t wake_us = now_us + m_state.wake_latency_us;
+    return (deadline_us > wake_us) ? deadline_us - wake_us : 0;
+}
+
+void RtcTimebase::prepareSleep(uint64_t now_us, uint64_t sleep_us) {
+    m_state.wake_at_us = now_us + sleep_us;
+}
+
+uint32_t RtcTimebase::guardUs(uint64_t sleep_us) const {
+    // Period error over the sleep plus a quarter of the latency for its jitter
+    uint64_t drift_us = sleep_us * m_state.drift_ppm / 1000000;
+    uint64_t guard_us = drift_us + m_state.wake_latency_us / 4;
+    return (guard_us > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(guard_us);
+}
+
+// Private helper methods
+
+bool RtcTimebase::valid() const {
+    return m_state.magic == TIMEBASE_MAGIC &&
+           m_state.period_q19 >= PERIOD_MIN_Q19 && m_state.period_q19 <= PERIOD_MAX_Q19;
+}
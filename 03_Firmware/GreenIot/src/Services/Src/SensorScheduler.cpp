@@ -0,0 +1,159 @@
+/**
+ * @file SensorScheduler.cpp
+ * @brief Multi-rate acquisition scheduler implementation
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#include "SensorScheduler.hpp"
+#include "esp_log.h"
+
+static const char* TAG = "SCHEDULER";
+
+SensorScheduler::SensorScheduler(SensorScheduleState& state)
+    : m_state(state)
+    , m_entries{}
+    , m_count(0) {}
+
+int8_t SensorScheduler::add(const char* name, uint32_t period_ms, uint32_t slack_ms) {
+    if (period_ms == 0 || m_count >= SENSOR_SCHEDULER_MAX_ENTRIES) {
+        return -1;
+    }
+    
+    // Slack beyond half a period would let one wake serve two periods
+    if (slack_ms > period_ms / 2) slack_ms = period_ms / 2;
+    m_entries[m_count] = {name, period_ms, slack_ms};
+    return static_cast<int8_t>(m_count++);
+}
+
+void SensorScheduler::clear() {
+    m_count = 0;
+}
+
+bool SensorScheduler::start(uint64_t now_ms) {
+    uint32_t expected = signature();
+    bool resume = (m_state.signature == expected);
+    
+    // A deadline more than a period ahead means the clock restarted
+    for (uint8_t i = 0; resume && i < m_count; i++) {
+        if (m_state.deadline_ms[i] > now_ms + m_entries[i].period_ms) resume = false;
+    }
+    if (resume) {
+        return true;
+    }
+    
+    ESP_LOGI(TAG, "Schedule started: %u entries, all due now", m_count);
+    for (uint8_t i = 0; i < SENSOR_SCHEDULER_MAX_ENTRIES; i++) {
+        m_state.deadline_ms[i] = now_ms;
+    }
+    m_state.signature = expected;
+    m_state.wakes = 0;
+    return false;
+}
+
+uint32_t SensorScheduler::dueMask(uint64_t now_ms) const {
+    return dueMask(m_entries, m_state.deadline_ms, m_count, now_ms);
+}
+
+void SensorScheduler::complete(uint32_t mask, uint64_t now_ms) {
+    mask &= (1UL << m_count) - 1;
+    if (mask == 0) return;
+    
+    advance(m_entries, m_state.deadline_ms, mask, m_count, now_ms);
+    m_state.wakes++;
+}
+
+uint64_t SensorScheduler::nextWakeMs() const {
+    return earliest(m_state.deadline_ms, m_count);
+}
+
+uint32_t SensorScheduler::sleepMs(uint64_t now_ms) const {
+    uint64_t next = nextWakeMs();
+    if (next <= now_ms) return 0;
+    uint64_t sleep_ms = next - now_ms;
+    return (sleep_ms > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(sleep_ms);
+}
+
+uint32_t SensorScheduler::plannedWakes(uint64_t now_ms, uint64_t horizon_ms, uint32_t* uncoalesced) const {
+    uint64_t end_ms = now_ms + horizon_ms;
+    
+    if (uncoalesced != nullptr) {
+        *uncoalesced = 0;
+        for (uint8_t i = 0; i < m_count; i++) {
+            uint64_t deadline = m_state.deadline_ms[i];
+            if (deadline < now_ms) deadline = now_ms;
+            if (deadline < end_ms) {
+                *uncoalesced += static_cast<uint32_t>((end_ms - 1 - deadline) / m_entries[i].period_ms + 1);
+            }
+        }
+    }
+    
+    uint64_t deadlines[SENSOR_SCHEDULER_MAX_ENTRIES];
+    for (uint8_t i = 0; i < m_count; i++) {
+        deadlines[i] = m_state.deadline_ms[i];
+    }
+    
+    uint32_t wakes = 0;
+    uint64_t t = now_ms;
+    while (m_count > 0) {
+        uint64_t next = earliest(deadlines, m_count);
+        if (next > t) t = next;
+        if (t >= end_ms) break;
+        advance(m_entries, deadlines, dueMask(m_entries, deadlines, m_count, t), m_count, t);
+        wakes++;
+    }
+    return wakes;
+}
+
+// Private helper methods
+
+uint32_t SensorScheduler::signature() const {
+    if (m_count == 0) return 0;
+    
+    // FNV-1a over the periods and slacks; 0 is reserved for "not started"
+    uint32_t hash = 2166136261UL;
+    for (uint8_t i = 0; i < m_count; i++) {
+        const uint32_t words[2] = {m_entries[i].period_ms, m_entries[i].slack_ms};
+        for (uint32_t word : words) {
+            for (uint8_t shift = 0; shift < 32; shift += 8) {
+                hash ^= (word >> shift) & 0xFF;
+                hash *= 16777619UL;
+            }
+        }
+    }
+    return (hash != 0) ? hash : 1;
+}
+
+uint32_t SensorScheduler::dueMask(const Entry* entries, const uint64_t* deadlines, uint8_t count,
+                                  uint64_t now_ms) {
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (deadlines[i] <= now_ms + entries[i].slack_ms) {
+            mask |= 1UL << i;
+        }
+    }
+    return mask;
+}
+
+void SensorScheduler::advance(const Entry* entries, uint64_t* deadlines, uint32_t mask, uint8_t count,
+                              uint64_t now_ms) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (!(mask & (1UL << i))) continue;
+        
+        // Whole periods from the old deadline: missed periods are skipped, the phase is kept
+        const Entry& entry = entries[i];
+        if (deadlines[i] <= now_ms + entry.slack_ms) {
+            uint64_t behind = now_ms + entry.slack_ms - deadlines[i];
+            deadlines[i] += (behind / entry.period_ms + 1) * entry.period_ms;
+        }
+    }
+}
+
+uint64_t SensorScheduler::earliest(const uint64_t* deadlines, uint8_t count) {
+    uint64_t next = UINT64_MAX;
+    for (uint8_t i = 0; i < count; i++) {
+        if (deadlines[i] < next) next = deadlines[i];
+    }
+    return next;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file WakeTrace.cpp
+ * @brief Wake-cycle trace ring implementation
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#include "WakeTrace.hpp"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char* TAG = "TRACE";
+
+#define TRACE_MAGIC 0x54524331  // "TRC1"
+
+// Records of the last wakes, kept through deep sleep
+RTC_DATA_ATTR static WakeTraceState s_trace;
+
+WakeTrace& WakeTrace::getInstance() {
+    static WakeTrace instance(s_trace);
+    return instance;
+}
+
+void WakeTrace::startCycle(uint64_t clock_ms) {
+    if (!valid()) {
+        clear();
+        m_state.cycle = 0;
+    }
+    
+    // Print before this wake's records go in, so every dump holds whole cycles
+    uint16_t dumped = 0;
+    if (dumpDue()) {
+        dumped = m_state.count;
+        dump();
+        clear();
+    }
+    
+    m_state.cycle++;
+    record(TraceType::CYCLE, TracePoint::NONE, m_state.cycle);
+    
+    // The clock record carries no esp_timer stamp; CYCLE just before it has one
+    append({static_cast<uint32_t>(clock_ms / 1000), static_cast<uint16_t>(clock_ms % 1000),
+            TraceType::CLOCK, TracePoint::NONE});
+    
+    if (dumped > 0) {
+        record(TraceType::INSTANT, TracePoint::TRACE_DUMP, dumped);
+    }
+}
+
+void WakeTrace::record(TraceType type, TracePoint point, uint16_t arg) {
+    if (m_state.magic != TRACE_MAGIC) {
+        return;
+    }
+    append({static_cast<uint32_t>(esp_timer_get_time()), arg, type, point});
+}
+
+void WakeTrace::dump() const {
+    static const char TYPE_CHARS[] = {'B', 'E', 'I', 'C', 'K'};
+    
+    ESP_LOGI(TAG, "dump %u records, %u lost", m_state.count, m_state.lost);
+    TraceEvent ev;
+    for (uint16_t i = 0; event(i, ev); i++) {
+        uint8_t type = static_cast<uint8_t>(ev.type);
+        ESP_LOGI(TAG, "%c %s %u %u", (type < sizeof(TYPE_CHARS)) ? TYPE_CHARS[type] : '?',
+                 tracePointName(ev.point), (unsigned int)ev.time_us, (unsigned int)ev.arg);
+    }
+    ESP_LOGI(TAG, "dump end");
+}
+
+void WakeTrace::clear() {
+    m_state.magic = TRACE_MAGIC;
+    m_state.head = 0;
+    m_state.count = 0;
+    m_state.lost = 0;
+}
+
+bool WakeTrace::event(uint16_t index, TraceEvent& out) const {
+    if (index >= m_state.count) {
+        return false;
+    }
+    out = m_state.events[(m_state.head + index) % WAKE_TRACE_CAPACITY];
+    return true;
+}
+
+// Private helper methods
+
+void WakeTrace::append(const TraceEvent& ev) {
+    if (m_state.count == WAKE_TRACE_CAPACITY) {
+        m_state.head = (m_state.head + 1) % WAKE_TRACE_CAPACITY;
+        m_state.count--;
+        m_state.lost++;
+    }
+    m_state.events[(m_state.head + m_state.count) % WAKE_TRACE_CAPACITY] = ev;
+    m_state.count++;
+}
+
+bool WakeTrace::valid() const {
+    // No CRC: a record per tracepoint would have to reseal it. The bounds keep
+    // a garbage ring (power-on, new image) from being indexed
+    return m_state.magic == TRACE_MAGIC && m_state.head < WAKE_TRACE_CAPACITY &&
+           m_state.count <= WAKE_TRACE_CAPACITY;
+}
@@ -33,58 +33,145 @@ fi
 echo "Using PlatformIO: $PIO"
 echo ""
 
-# Function to run a test suite
+# Results per suite, for the summary
+SUITE_NAMES=()
+SUITE_PASSED=()
+SUITE_TOTAL=()
+FAILED=0
+
+# Function to run a test suite: every other test_*.cpp is moved aside, since
+# each file has its own main()
 run_test() {
     local test_name=$1
     local active_file=$2
-    local backup_files=("${@:3}")
+    local backup_files=()
     
     echo "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"
     echo "🧪 Running: $test_name"
     echo "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"
     
     # Backup other test files
-    for file in "${backup_files[@]}"; do
-        if [ -f "test/$file" ]; then
+    for path in test/test_*.cpp; do
+        local file=$(basename "$path")
+        if [ "$file" != "$active_file" ]; then
             mv "test/$file" "test/$file.tmp"
+            backup_files+=("$file")
         fi
     done
     
-    # Run test
-    $PIO test -e native
+    # Run test (a failing suite must not leave the other files moved aside)
+    local output
+    local status=0
+    output=$($PIO test -e native -v 2>&1) || status=$?
+    echo "$output"
     
     # Restore backed up files
     for file in "${backup_files[@]}"; do
-        if [ -f "test/$file.tmp" ]; then
-            mv "test/$file.tmp" "test/$file"
-        fi
+        mv "test/$file.tmp" "test/$file"
     done
     
+    # Unity's own tally: "N Tests M Failures K Ignored"
+    local tally=$(echo "$output" | grep -Eo '[0-9]+ Tests [0-9]+ Failures' | tail -1)
+    local total=$(echo "$tally" | awk '{print $1}')
+    local failures=$(echo "$tally" | awk '{print $3}')
+    if [ -z "$tally" ]; then
+        total=0
+        failures=0
+        status=1  # Did not build or did not run
+    fi
+    if [ $status -ne 0 ] || [ "$failures" -ne 0 ]; then
+        FAILED=1
+    fi
+    
+    SUITE_NAMES+=("$test_name")
+    SUITE_PASSED+=($((total - failures)))
+    SUITE_TOTAL+=($total)
     echo ""
 }
 
 # Test Suite 1: Sensor Tests
-run_test "Sensor Tests (10 tests)" \
-         "test_sensor_simple.cpp" \
-         "test_ble_mesh.cpp"
+run_test "Sensor Tests" \
+         "test_sensor_simple.cpp"
 
 # Test Suite 2: BLE Mesh Tests
-run_test "BLE Mesh Tests (18 tests)" \
-         "test_ble_mesh.cpp" \
-         "test_sensor_simple.cpp"
+run_test "BLE Mesh Tests" \
+         "test_ble_mesh.cpp"
+
+# Test Suite 3: I2C Async Queue Tests
+run_test "I2C Async Tests" \
+         "test_i2c_async.cpp"
+
+# Test Suite 4: I2C Statistics Tests
+run_test "I2C Stats Tests" \
+         "test_i2c_stats.cpp"
+
+# Test Suite 5: Simulated I2C Bus Integration Tests
+run_test "I2C Simulated Bus Tests" \
+         "test_i2c_sim.cpp"
+
+# Test Suite 6: Fixed-Point Pipeline Tests
+run_test "Fixed-Point Pipeline Tests" \
+         "test_fixed_point.cpp"
+
+# Test Suite 7: Sensor Burst Filter Tests
+run_test "Sensor Burst Filter Tests" \
+         "test_sensor_filter.cpp"
+
+# Test Suite 8: Sensor Heap Tests
+run_test "Sensor Heap Tests" \
+         "test_sensor_alloc.cpp"
+
+# Test Suite 9: Sensor Binding Tests
+run_test "Sensor Binding Tests" \
+         "test_sensor_binding.cpp"
+
+# Test Suite 10: Sensor Scheduler Tests
+run_test "Sensor Scheduler Tests" \
+         "test_sensor_scheduler.cpp"
+
+# Test Suite 11: Measurement Pipeline Tests
+run_test "Measurement Pipeline Tests" \
+         "test_measurement_pipeline.cpp"
+
+# Test Suite 12: Sensor Power Policy Tests
+run_test "Sensor Power Policy Tests" \
+         "test_sensor_power_policy.cpp"
+
+# Test Suite 13: Measurement Batch Tests
+run_test "Measurement Batch Tests" \
+         "test_measurement_batch.cpp"
+
+# Test Suite 14: Wake trace
+run_test "Wake trace" \
+         "test_wake_trace.cpp"
+
+# Test Suite 15: RTC timebase
+run_test "RTC timebase" \
+         "test_rtc_timebase.cpp"
 
 # Summary
+TOTAL_PASSED=0
+TOTAL_TESTS=0
 echo "╔════════════════════════════════════════════════════════════╗"
 echo "║                    TEST RUN COMPLETE                       ║"
 echo "╠════════════════════════════════════════════════════════════╣"
-echo "║  Sensor Tests:    10/10 PASSED ✅                         ║"
-echo "║  BLE Mesh Tests:  18/18 PASSED ✅                         ║"
-echo "║  ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━  ║"
-echo "║  TOTAL:           28/28 PASSED ✅                         ║"
-echo "║                                                            ║"
-echo "║  Success Rate: 100%                                        ║"
+for i in "${!SUITE_NAMES[@]}"; do
+    mark="✅"
+    if [ "${SUITE_PASSED[$i]}" -ne "${SUITE_TOTAL[$i]}" ] || [ "${SUITE_TOTAL[$i]}" -eq 0 ]; then
+        mark="❌"
+    fi
+    printf "║  %-36s %3d/%-3d %s\n" "${SUITE_NAMES[$i]}:" "${SUITE_PASSED[$i]}" "${SUITE_TOTAL[$i]}" "$mark"
+    TOTAL_PASSED=$((TOTAL_PASSED + SUITE_PASSED[$i]))
+    TOTAL_TESTS=$((TOTAL_TESTS + SUITE_TOTAL[$i]))
+done
+echo "║  ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━  ║"
+printf "║  %-36s %3d/%-3d\n" "TOTAL:" "$TOTAL_PASSED" "$TOTAL_TESTS"
 echo "╚════════════════════════════════════════════════════════════╝"
 echo ""
+
+if [ $FAILED -ne 0 ]; then
+    echo "❌ Some test suites failed."
+    exit 1
+fi
 echo "✅ All tests passed! Firmware is ready for deployment."
 echo ""
-
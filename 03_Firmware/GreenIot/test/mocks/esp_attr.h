@@ -0,0 +1,12 @@
+/**
+ * @file esp_attr.h
+ * @brief Host-side section attributes (RTC memory is ordinary RAM)
+ */
+
+#ifndef NATIVE_ESP_ATTR_H
+#define NATIVE_ESP_ATTR_H
+
+#define RTC_DATA_ATTR
+#define IRAM_ATTR
+
+#endif // NATIVE_ESP_ATTR_H
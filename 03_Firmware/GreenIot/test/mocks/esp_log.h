@@ -0,0 +1,28 @@
+/**
+ * @file esp_log.h
+ * @brief Host-side ESP_LOGx macros for native builds
+ * 
+ * Errors and warnings go to stderr; info/debug output is only printed when
+ * NATIVE_LOG_VERBOSE is defined, to keep test output readable.
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifndef NATIVE_ESP_LOG_H
+#define NATIVE_ESP_LOG_H
+
+#include <stdio.h>
+
+#define ESP_LOGE(tag, fmt, ...) fprintf(stderr, "E (%s) " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) fprintf(stderr, "W (%s) " fmt "\n", tag, ##__VA_ARGS__)
+
+#ifdef NATIVE_LOG_VERBOSE
+#define ESP_LOGI(tag, fmt, ...) printf("I (%s) " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) printf("D (%s) " fmt "\n", tag, ##__VA_ARGS__)
+#else
+#define ESP_LOGI(tag, fmt, ...) do { (void)(tag); if (0) printf(fmt, ##__VA_ARGS__); } while (0)
+#define ESP_LOGD(tag, fmt, ...) do { (void)(tag); if (0) printf(fmt, ##__VA_ARGS__); } while (0)
+#endif
+
+#endif // NATIVE_ESP_LOG_H
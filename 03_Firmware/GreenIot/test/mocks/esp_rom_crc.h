@@ -0,0 +1,13 @@
+/**
+ * @file esp_rom_crc.h
+ * @brief Host-side ROM CRC32 (same result as the ESP32-C3 ROM routine)
+ */
+
+#ifndef NATIVE_ESP_ROM_CRC_H
+#define NATIVE_ESP_ROM_CRC_H
+
+#include <stdint.h>
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len);
+
+#endif // NATIVE_ESP_ROM_CRC_H
@@ -0,0 +1,13 @@
+/**
+ * @file esp_rom_sys.h
+ * @brief Host-side busy-wait delay
+ */
+
+#ifndef NATIVE_ESP_ROM_SYS_H
+#define NATIVE_ESP_ROM_SYS_H
+
+#include <stdint.h>
+
+void esp_rom_delay_us(uint32_t us);
+
+#endif // NATIVE_ESP_ROM_SYS_H
@@ -0,0 +1,32 @@
+/**
+ * @file esp_system.h
+ * @brief Host-side reset reason for native builds
+ * 
+ * Tests pick the reset reason with native_set_reset_reason() to exercise
+ * cold-boot and deep-sleep-wake paths.
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifndef NATIVE_ESP_SYSTEM_H
+#define NATIVE_ESP_SYSTEM_H
+
+typedef enum {
+    ESP_RST_UNKNOWN,
+    ESP_RST_POWERON,
+    ESP_RST_EXT,
+    ESP_RST_SW,
+    ESP_RST_PANIC,
+    ESP_RST_INT_WDT,
+    ESP_RST_TASK_WDT,
+    ESP_RST_WDT,
+    ESP_RST_DEEPSLEEP,
+    ESP_RST_BROWNOUT,
+    ESP_RST_SDIO
+} esp_reset_reason_t;
+
+esp_reset_reason_t esp_reset_reason(void);
+void native_set_reset_reason(esp_reset_reason_t reason);
+
+#endif // NATIVE_ESP_SYSTEM_H
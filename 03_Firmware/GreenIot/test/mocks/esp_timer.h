@@ -0,0 +1,19 @@
+/**
+ * @file esp_timer.h
+ * @brief Host-side esp_timer subset for native builds
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifndef NATIVE_ESP_TIMER_H
+#define NATIVE_ESP_TIMER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Microseconds since process start (monotonic)
+ */
+int64_t esp_timer_get_time(void);
+
+#endif // NATIVE_ESP_TIMER_H
@@ -0,0 +1,71 @@
+/**
+ * @file FreeRTOS.h
+ * @brief Host-side FreeRTOS subset for native builds
+ * 
+ * Implements just the kernel API the drivers use (static tasks, mutexes,
+ * queues, task notifications, delays) on top of std::thread, so the real
+ * I2CDriver and sensor sources run unchanged on a PC. 1 tick = 1 ms, as
+ * with CONFIG_FREERTOS_HZ=1000 on target.
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifndef NATIVE_FREERTOS_H
+#define NATIVE_FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint8_t StackType_t;
+
+struct NativeTask;
+struct NativeQueue;
+struct NativeMutex;
+
+typedef NativeTask* TaskHandle_t;
+typedef NativeQueue* QueueHandle_t;
+typedef NativeMutex* SemaphoreHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+// Static storage placeholders (host objects are allocated internally)
+typedef struct { uint8_t unused; } StaticTask_t;
+typedef struct { uint8_t unused; } StaticQueue_t;
+typedef struct { uint8_t unused; } StaticSemaphore_t;
+
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS 1
+#define portMAX_DELAY 0xFFFFFFFFUL
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+// Tasks
+TaskHandle_t xTaskCreateStatic(TaskFunction_t function, const char* name, uint32_t stack_depth,
+                               void* parameters, UBaseType_t priority,
+                               StackType_t* stack, StaticTask_t* tcb);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount(void);
+
+// Task notifications
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait);
+
+// Mutexes
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t* storage);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t ticks_to_wait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex);
+
+// Queues
+QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t item_size,
+                                 uint8_t* storage, StaticQueue_t* queue);
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait);
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks_to_wait);
+
+#endif // NATIVE_FREERTOS_H
@@ -0,0 +1,6 @@
+/**
+ * @file queue.h
+ * @brief Host-side FreeRTOS subset (see FreeRTOS.h)
+ */
+
+#include "FreeRTOS.h"
@@ -0,0 +1,6 @@
+/**
+ * @file semphr.h
+ * @brief Host-side FreeRTOS subset (see FreeRTOS.h)
+ */
+
+#include "FreeRTOS.h"
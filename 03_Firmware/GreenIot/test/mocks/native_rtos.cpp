@@ -0,0 +1,216 @@
+/**
+ * @file native_rtos.cpp
+ * @brief Host-side FreeRTOS / ESP-IDF subset for native builds
+ *
+ * Tasks are detached std::threads, mutexes are std::timed_mutex, queues
+ * are a mutex + condition variable around a ring in the caller's static
+ * storage (no allocation per item, like FreeRTOS), and every thread
+ * (including the test's main thread) gets a notification slot on first use.
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifdef NATIVE_BUILD
+
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "esp_rom_crc.h"
+#include "esp_rom_sys.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+typedef std::chrono::steady_clock Clock;
+
+static const Clock::time_point s_process_start = Clock::now();
+static esp_reset_reason_t s_reset_reason = ESP_RST_POWERON;
+
+struct NativeTask {
+    std::mutex lock;
+    std::condition_variable cv;
+    uint32_t notify_count = 0;
+};
+
+struct NativeMutex {
+    std::timed_mutex mutex;
+};
+
+struct NativeQueue {
+    std::mutex lock;
+    std::condition_variable not_empty;
+    uint8_t* storage = nullptr;  // length * item_size bytes
+    size_t length = 0;
+    size_t item_size = 0;
+    size_t head = 0;
+    size_t count = 0;
+};
+
+static thread_local NativeTask* t_current_task = nullptr;
+
+template <typename Predicate>
+static bool waitFor(std::condition_variable& cv, std::unique_lock<std::mutex>& guard,
+                    TickType_t ticks, Predicate ready) {
+    if (ticks == portMAX_DELAY) {
+        cv.wait(guard, ready);
+        return true;
+    }
+    return cv.wait_for(guard, std::chrono::milliseconds(ticks), ready);
+}
+
+// =======================================================================================
+// TASKS
+// =======================================================================================
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t function, const char* name, uint32_t stack_depth,
+                               void* parameters, UBaseType_t priority,
+                               StackType_t* stack, StaticTask_t* tcb) {
+    (void)name; (void)stack_depth; (void)priority; (void)stack; (void)tcb;
+    
+    NativeTask* task = new NativeTask();  // Lives as long as the process, like a static TCB
+    std::thread([task, function, parameters]() {
+        t_current_task = task;
+        function(parameters);
+    }).detach();
+    return task;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    if (t_current_task == nullptr) {
+        t_current_task = new NativeTask();
+    }
+    return t_current_task;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return static_cast<TickType_t>(esp_timer_get_time() / 1000);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    {
+        std::lock_guard<std::mutex> guard(task->lock);
+        task->notify_count++;
+    }
+    task->cv.notify_all();
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait) {
+    NativeTask* task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> guard(task->lock);
+    
+    waitFor(task->cv, guard, ticks_to_wait, [task]() { return task->notify_count > 0; });
+    uint32_t value = task->notify_count;
+    if (value > 0) {
+        task->notify_count = clear_on_exit ? 0 : value - 1;
+    }
+    return value;
+}
+
+// =======================================================================================
+// MUTEXES
+// =======================================================================================
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t* storage) {
+    (void)storage;
+    return new NativeMutex();
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t ticks_to_wait) {
+    if (ticks_to_wait == portMAX_DELAY) {
+        mutex->mutex.lock();
+        return pdTRUE;
+    }
+    return mutex->mutex.try_lock_for(std::chrono::milliseconds(ticks_to_wait)) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex) {
+    mutex->mutex.unlock();
+    return pdTRUE;
+}
+
+// =======================================================================================
+// QUEUES
+// =======================================================================================
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t item_size,
+                                 uint8_t* storage, StaticQueue_t* queue) {
+    (void)queue;
+    
+    NativeQueue* q = new NativeQueue();
+    q->storage = storage;
+    q->length = length;
+    q->item_size = item_size;
+    return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait) {
+    (void)ticks_to_wait;  // Senders never block in the drivers
+    
+    {
+        std::lock_guard<std::mutex> guard(queue->lock);
+        if (queue->count >= queue->length) {
+            return pdFALSE;
+        }
+        size_t tail = (queue->head + queue->count) % queue->length;
+        memcpy(queue->storage + tail * queue->item_size, item, queue->item_size);
+        queue->count++;
+    }
+    queue->not_empty.notify_one();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks_to_wait) {
+    std::unique_lock<std::mutex> guard(queue->lock);
+    if (!waitFor(queue->not_empty, guard, ticks_to_wait, [queue]() { return queue->count > 0; })) {
+        return pdFALSE;
+    }
+    memcpy(item, queue->storage + queue->head * queue->item_size, queue->item_size);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    return pdTRUE;
+}
+
+// =======================================================================================
+// ESP-IDF SYSTEM SERVICES
+// =======================================================================================
+
+int64_t esp_timer_get_time(void) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - s_process_start).count();
+}
+
+void esp_rom_delay_us(uint32_t us) {
+    // Busy-wait like the ROM routine; sleep_for is far too coarse for µs delays
+    Clock::time_point until = Clock::now() + std::chrono::microseconds(us);
+    while (Clock::now() < until) {
+    }
+}
+
+esp_reset_reason_t esp_reset_reason(void) {
+    return s_reset_reason;
+}
+
+void native_set_reset_reason(esp_reset_reason_t reason) {
+    s_reset_reason = reason;
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len) {
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= buf[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1UL)));
+        }
+    }
+    return ~crc;
+}
+
+#endif // NATIVE_BUILD
@@ -0,0 +1,146 @@
+/**
+ * @file sim_i2c_bus.cpp
+ * @brief Host-side simulated I2C bus backend
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifdef NATIVE_BUILD
+
+#include "sim_i2c_bus.h"
+#include "esp_rom_sys.h"
+#include <chrono>
+#include <thread>
+
+// START + STOP (and a repeated START) cost about one bit time each
+#define SIM_FRAME_OVERHEAD_BITS 2
+#define SIM_BITS_PER_BYTE 9  // 8 data bits + ACK
+
+SimI2CBus::SimI2CBus()
+    : m_installed(false)
+    , m_clock_hz(100000)
+    , m_sda_stuck(false)
+    , m_stuck_releases(true)
+    , m_transfers(0)
+    , m_installs(0)
+    , m_bus_time_us(0) {}
+
+void SimI2CBus::attach(ISimI2CDevice* device) {
+    m_devices.push_back(device);
+}
+
+void SimI2CBus::detachAll() {
+    m_devices.clear();
+}
+
+void SimI2CBus::setSdaStuck(bool stuck, bool releases_on_clocks) {
+    m_stuck_releases = releases_on_clocks;
+    m_sda_stuck = stuck;
+}
+
+uint32_t SimI2CBus::transferTimeUs(uint16_t write_len, uint16_t read_len, uint32_t frequency_hz) {
+    uint32_t bits = SIM_FRAME_OVERHEAD_BITS;
+    if (write_len > 0 || read_len == 0) {
+        bits += SIM_BITS_PER_BYTE * (1 + write_len);  // Address + W, data
+    }
+    if (read_len > 0) {
+        bits += SIM_BITS_PER_BYTE * (1 + read_len);   // Address + R, data
+        if (write_len > 0) {
+            bits += 1;  // Repeated START
+        }
+    }
+    return static_cast<uint32_t>((static_cast<uint64_t>(bits) * 1000000 + frequency_hz - 1) / frequency_hz);
+}
+
+I2CStatus SimI2CBus::install(const I2CConfig& config, uint32_t frequency_hz) {
+    (void)config;
+    m_installed = true;
+    m_clock_hz = frequency_hz;
+    m_installs++;
+    return I2CStatus::OK;
+}
+
+void SimI2CBus::uninstall() {
+    m_installed = false;
+}
+
+I2CStatus SimI2CBus::setClock(uint32_t frequency_hz) {
+    if (!m_installed) return I2CStatus::ERROR_INIT;
+    m_clock_hz = frequency_hz;
+    return I2CStatus::OK;
+}
+
+I2CStatus SimI2CBus::transfer(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                              uint8_t* read_data, uint16_t read_len, uint32_t timeout_ms) {
+    if (!m_installed) return I2CStatus::ERROR_INIT;
+    m_transfers++;
+    
+    // A wedged SDA means the controller never sees its own START complete
+    if (m_sda_stuck) {
+        occupy(transferTimeUs(0, 0, m_clock_hz));
+        return I2CStatus::ERROR_TIMEOUT;
+    }
+    
+    ISimI2CDevice* device = find(device_addr);
+    bool too_fast = device != nullptr && m_clock_hz > device->maxClockHz();
+    
+    // Write phase (also the address-only probe); the device sees the
+    // command once its bytes have been clocked out
+    uint32_t write_us = 0;
+    if (write_len > 0 || read_len == 0) {
+        write_us = transferTimeUs(write_len, 0, m_clock_hz);
+        occupy(write_us);
+        if (device == nullptr || too_fast || !device->onWrite(write_data, write_len)) {
+            return I2CStatus::ERROR_NACK_ADDR;
+        }
+    }
+    
+    // Read phase
+    if (read_len > 0) {
+        uint32_t stretch_us = 0;
+        if (device == nullptr || too_fast || !device->onRead(read_data, read_len, stretch_us)) {
+            occupy(transferTimeUs(0, 0, m_clock_hz));  // NACK after the address byte
+            return I2CStatus::ERROR_NACK_ADDR;
+        }
+        if (stretch_us > timeout_ms * 1000) {
+            occupy(timeout_ms * 1000);
+            return I2CStatus::ERROR_TIMEOUT;
+        }
+        occupy(transferTimeUs(write_len, read_len, m_clock_hz) - write_us + stretch_us);
+    }
+    return I2CStatus::OK;
+}
+
+bool SimI2CBus::clearBus() {
+    // 9 clocks + STOP at ~100 kHz
+    esp_rom_delay_us(100);
+    if (m_sda_stuck && m_stuck_releases) {
+        m_sda_stuck = false;
+    }
+    return !m_sda_stuck;
+}
+
+ISimI2CDevice* SimI2CBus::find(uint8_t address) const {
+    for (ISimI2CDevice* device : m_devices) {
+        if (device->address() == address) {
+            return device;
+        }
+    }
+    return nullptr;
+}
+
+void SimI2CBus::occupy(uint32_t duration_us) {
+    m_bus_time_us += duration_us;
+    
+    // Sleep for the bulk (clock stretching), spin the tail for µs accuracy
+    std::chrono::steady_clock::time_point deadline = 
+        std::chrono::steady_clock::now() + std::chrono::microseconds(duration_us);
+    if (duration_us > 2000) {
+        std::this_thread::sleep_until(deadline - std::chrono::milliseconds(1));
+    }
+    while (std::chrono::steady_clock::now() < deadline) {
+    }
+}
+
+#endif // NATIVE_BUILD
@@ -0,0 +1,105 @@
+/**
+ * @file sim_i2c_bus.h
+ * @brief Host-side simulated I2C bus backend for native builds
+ * 
+ * Plugs into I2CDriver::setBackend() so the real driver, batch scheduler
+ * and sensor drivers run on a PC. Transfers take the time they would take
+ * on the wire (9 clocks per byte plus START/STOP at the programmed SCL
+ * frequency, plus any clock stretching by the device), so wake-cycle
+ * timing can be benchmarked and regression-tested.
+ * 
+ * Fault injection:
+ * - Devices NACK when clocked faster than their maxClockHz()
+ * - setSdaStuck() models a slave holding SDA low until clearBus()
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifndef SIM_I2C_BUS_H
+#define SIM_I2C_BUS_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "II2CBackend.hpp"
+
+/**
+ * @brief Device model attached to the simulated bus
+ */
+class ISimI2CDevice {
+public:
+    virtual ~ISimI2CDevice() = default;
+    
+    virtual uint8_t address() const = 0;
+    
+    /**
+     * @brief Fastest SCL the device (and its wiring) can follow
+     */
+    virtual uint32_t maxClockHz() const { return 1000000; }
+    
+    /**
+     * @brief Write phase (address + W acknowledged first)
+     * @return false to NACK
+     */
+    virtual bool onWrite(const uint8_t* data, uint16_t len) = 0;
+    
+    /**
+     * @brief Read phase (address + R)
+     * @param data Bytes to return to the master
+     * @param len Number of bytes requested
+     * @param stretch_us Set to hold SCL low before the first byte
+     * @return false to NACK the address
+     */
+    virtual bool onRead(uint8_t* data, uint16_t len, uint32_t& stretch_us) = 0;
+};
+
+class SimI2CBus : public II2CBackend {
+public:
+    SimI2CBus();
+    
+    void attach(ISimI2CDevice* device);
+    void detachAll();
+    
+    /**
+     * @brief Hold SDA low (wedged slave)
+     * @param stuck Line state
+     * @param releases_on_clocks true if 9 recovery clocks free the line
+     */
+    void setSdaStuck(bool stuck, bool releases_on_clocks = true);
+    
+    bool isInstalled() const { return m_installed; }
+    uint32_t clockHz() const { return m_clock_hz; }
+    uint32_t transferCount() const { return m_transfers; }
+    uint32_t installCount() const { return m_installs; }
+    uint64_t busTimeUs() const { return m_bus_time_us; }
+    
+    /**
+     * @brief Wire time of one framed transfer at a given clock
+     */
+    static uint32_t transferTimeUs(uint16_t write_len, uint16_t read_len, uint32_t frequency_hz);
+    
+    // II2CBackend
+    I2CStatus install(const I2CConfig& config, uint32_t frequency_hz) override;
+    void uninstall() override;
+    I2CStatus setClock(uint32_t frequency_hz) override;
+    I2CStatus transfer(uint8_t device_addr, const uint8_t* write_data, uint16_t write_len,
+                       uint8_t* read_data, uint16_t read_len, uint32_t timeout_ms) override;
+    bool isSdaStuckLow() override { return m_sda_stuck; }
+    bool clearBus() override;
+    
+private:
+    std::vector<ISimI2CDevice*> m_devices;
+    bool m_installed;
+    uint32_t m_clock_hz;
+    std::atomic<bool> m_sda_stuck;
+    bool m_stuck_releases;
+    uint32_t m_transfers;
+    uint32_t m_installs;
+    uint64_t m_bus_time_us;
+    
+    ISimI2CDevice* find(uint8_t address) const;
+    void occupy(uint32_t duration_us);
+};
+
+#endif // SIM_I2C_BUS_H
@@ -0,0 +1,117 @@
+/**
+ * @file virtual_aht20.cpp
+ * @brief Cycle-timed AHT20 device model
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#ifdef NATIVE_BUILD
+
+#include "virtual_aht20.h"
+#include "esp_timer.h"
+#include <cmath>
+
+// Command codes (AHT20 datasheet, section 5.3 onwards)
+#define AHT20_STATUS      0x71
+#define AHT20_CALIBRATE   0xBE
+#define AHT20_TRIGGER     0xAC
+#define AHT20_SOFT_RESET  0xBA
+
+#define AHT20_STATUS_BUSY       0x80
+#define AHT20_STATUS_CALIBRATED 0x08
+
+// Typical times (µs); drivers budget the datasheet's 80 ms conversion
+#define AHT20_CONV_US      75000
+#define AHT20_CALIBRATE_US 10000
+#define AHT20_RESET_US     20000
+
+VirtualAHT20::VirtualAHT20()
+    : m_temperature_c(25.0f)
+    , m_humidity_pct(60.0f)
+    , m_calibrated(true)
+    , m_corrupt_next_crc(false)
+    , m_absent(false)
+    , m_busy_until_us(0)
+    , m_raw_temperature(0)
+    , m_raw_humidity(0)
+    , m_measurements(0)
+    , m_calibrations(0)
+    , m_busy_reads(0) {}
+
+void VirtualAHT20::setConditions(float temperature_c, float humidity_pct) {
+    m_temperature_c = temperature_c;
+    m_humidity_pct = humidity_pct;
+}
+
+uint8_t VirtualAHT20::crc8(const uint8_t* data, uint8_t len) {
+    uint8_t crc = 0xFF;
+    for (uint8_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x31) : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+bool VirtualAHT20::onWrite(const uint8_t* data, uint16_t len) {
+    if (m_absent) return false;
+    if (len == 0) return true;  // Address probe
+    
+    int64_t now = esp_timer_get_time();
+    switch (data[0]) {
+        case AHT20_STATUS:
+            return len == 1;
+        case AHT20_CALIBRATE:
+            if (len != 3 || data[1] != 0x08 || data[2] != 0x00) return false;
+            m_calibrated = true;
+            m_busy_until_us = now + AHT20_CALIBRATE_US;
+            m_calibrations++;
+            return true;
+        case AHT20_TRIGGER: {
+            if (len != 3 || data[1] != 0x33 || data[2] != 0x00) return false;
+            // Sample the conditions now; they become readable after the conversion
+            double t = (m_temperature_c + 50.0) / 200.0 * 1048576.0;
+            double h = m_humidity_pct / 100.0 * 1048576.0;
+            m_raw_temperature = static_cast<uint32_t>(std::lround(t < 0 ? 0 : (t > 1048575 ? 1048575 : t)));
+            m_raw_humidity = static_cast<uint32_t>(std::lround(h < 0 ? 0 : (h > 1048575 ? 1048575 : h)));
+            m_busy_until_us = now + AHT20_CONV_US;
+            m_measurements++;
+            return true;
+        }
+        case AHT20_SOFT_RESET:
+            m_busy_until_us = now + AHT20_RESET_US;
+            return len == 1;
+        default:
+            return false;
+    }
+}
+
+bool VirtualAHT20::onRead(uint8_t* data, uint16_t len, uint32_t& stretch_us) {
+    stretch_us = 0;
+    if (m_absent) return false;
+    
+    bool busy = esp_timer_get_time() < m_busy_until_us;
+    if (busy && len > 1) m_busy_reads++;
+    
+    uint8_t frame[7];
+    frame[0] = static_cast<uint8_t>((busy ? AHT20_STATUS_BUSY : 0) | (m_calibrated ? AHT20_STATUS_CALIBRATED : 0));
+    frame[1] = static_cast<uint8_t>(m_raw_humidity >> 12);
+    frame[2] = static_cast<uint8_t>(m_raw_humidity >> 4);
+    frame[3] = static_cast<uint8_t>(((m_raw_humidity & 0x0F) << 4) | ((m_raw_temperature >> 16) & 0x0F));
+    frame[4] = static_cast<uint8_t>(m_raw_temperature >> 8);
+    frame[5] = static_cast<uint8_t>(m_raw_temperature);
+    frame[6] = crc8(frame, 6);
+    if (m_corrupt_next_crc && !busy && len >= 7) {
+        frame[6] ^= 0xFF;
+        m_corrupt_next_crc = false;
+    }
+    
+    for (uint16_t i = 0; i < len; i++) {
+        data[i] = (i < 7) ? frame[i] : 0xFF;
+    }
+    return true;
+}
+
+#endif // NATIVE_BUILD
@@ -0,0 +1,61 @@
+/**
+ * @file virtual_aht20.h
+ * @brief Cycle-timed AHT20 device model for the simulated I2C bus
+ * 
+ * Honours the status (0x71), calibration (0xBE), trigger (0xAC) and soft
+ * reset (0xBA) commands, the typical 75 ms conversion time and CRC-8
+ * framing. The sensor acknowledges while busy; a fetch before the
+ * conversion is done returns the busy bit and the previous sample.
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#ifndef VIRTUAL_AHT20_H
+#define VIRTUAL_AHT20_H
+
+#include <cstdint>
+#include "sim_i2c_bus.h"
+
+class VirtualAHT20 : public ISimI2CDevice {
+public:
+    VirtualAHT20();
+    
+    // Conditions
+    void setConditions(float temperature_c, float humidity_pct);
+    void setCalibrated(bool calibrated) { m_calibrated = calibrated; }
+    
+    // Fault injection
+    void corruptNextCrc() { m_corrupt_next_crc = true; }
+    void setAbsent(bool absent) { m_absent = absent; }
+    
+    // Observation
+    uint32_t measurementsStarted() const { return m_measurements; }
+    uint32_t calibrationCommands() const { return m_calibrations; }
+    uint32_t busyReads() const { return m_busy_reads; }
+    bool isCalibrated() const { return m_calibrated; }
+    
+    static uint8_t crc8(const uint8_t* data, uint8_t len);
+    
+    // ISimI2CDevice
+    uint8_t address() const override { return 0x38; }
+    uint32_t maxClockHz() const override { return 400000; }
+    bool onWrite(const uint8_t* data, uint16_t len) override;
+    bool onRead(uint8_t* data, uint16_t len, uint32_t& stretch_us) override;
+    
+private:
+    float m_temperature_c;
+    float m_humidity_pct;
+    bool m_calibrated;
+    bool m_corrupt_next_crc;
+    bool m_absent;
+    int64_t m_busy_until_us;
+    uint32_t m_raw_temperature;   // 20-bit codes of the last completed conversion
+    uint32_t m_raw_humidity;
+    
+    uint32_t m_measurements;
+    uint32_t m_calibrations;
+    uint32_t m_busy_reads;
+};
+
+#endif // VIRTUAL_AHT20_H
@@ -0,0 +1,391 @@
+/**
+ * @file virtual_sht31.cpp
+ * @brief Cycle-timed SHT3x device model
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifdef NATIVE_BUILD
+
+#include "virtual_sht31.h"
+#include "esp_timer.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// Command codes (SHT3x-DIS datasheet, Table 9 onwards)
+#define SHT3X_MEAS_STRETCH_HIGH   0x2C06
+#define SHT3X_MEAS_STRETCH_MED    0x2C0D
+#define SHT3X_MEAS_STRETCH_LOW    0x2C10
+#define SHT3X_MEAS_NOSTRETCH_HIGH 0x2400
+#define SHT3X_MEAS_NOSTRETCH_MED  0x240B
+#define SHT3X_MEAS_NOSTRETCH_LOW  0x2416
+#define SHT3X_SOFT_RESET          0x30A2
+#define SHT3X_HEATER_ON           0x306D
+#define SHT3X_HEATER_OFF          0x3066
+#define SHT3X_READ_STATUS         0xF32D
+#define SHT3X_CLEAR_STATUS        0x3041
+#define SHT3X_FETCH_DATA          0xE000
+#define SHT3X_BREAK               0x3093
+#define SHT3X_ART                 0x2B32
+#define SHT3X_ALERT_HIGH_SET      0x611D
+#define SHT3X_ALERT_HIGH_CLEAR    0x6116
+#define SHT3X_ALERT_LOW_CLEAR     0x610B
+#define SHT3X_ALERT_LOW_SET       0x6100
+
+// Typical conversion times (µs) per repeatability; drivers budget the
+// datasheet maximum (15 / 6 / 4 ms), a real part is usually done sooner
+#define SHT3X_CONV_HIGH_US 12500
+#define SHT3X_CONV_MED_US  4500
+#define SHT3X_CONV_LOW_US  2500
+#define SHT3X_RESET_US     1000
+#define SHT3X_BREAK_US     1000
+
+VirtualSHT31::VirtualSHT31(uint8_t address)
+    : m_address(address)
+    , m_max_clock_hz(1000000)
+    , m_trace_index(0)
+    , m_fixed{25.0f, 60.0f}
+    , m_pending(Pending::NONE)
+    , m_stretch(false)
+    , m_ready_at_us(0)
+    , m_raw_temperature(0)
+    , m_raw_humidity(0)
+    , m_heater(false)
+    , m_corrupt_next_crc(false)
+    , m_periodic_interval_us(0)
+    , m_periodic_next_us(0)
+    , m_periodic_lag_us(0)
+    , m_alert_limits{0xFFFF, 0xFFFF, 0x0000, 0x0000}
+    , m_alert(false)
+    , m_repeatability(2)
+    , m_noise_scale(0.0f)
+    , m_excess_temp_c(0.0f)
+    , m_excess_hum_pct(0.0f)
+    , m_noise_state(0x12345678)
+    , m_measurements(0)
+    , m_measurements_at{0, 0, 0}
+    , m_soft_resets(0)
+    , m_not_ready_nacks(0)
+    , m_last_temperature(0.0f)
+    , m_last_humidity(0.0f) {}
+
+void VirtualSHT31::setConditions(float temperature_c, float humidity_pct) {
+    m_trace.clear();
+    m_fixed.temperature_c = temperature_c;
+    m_fixed.humidity_pct = humidity_pct;
+}
+
+void VirtualSHT31::setNoise(float repeatability_scale, float excess_temp_c, float excess_hum_pct) {
+    m_noise_scale = repeatability_scale;
+    m_excess_temp_c = excess_temp_c;
+    m_excess_hum_pct = excess_hum_pct;
+}
+
+bool VirtualSHT31::loadTraceCsv(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) return false;
+    
+    std::string csv;
+    char buf[256];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), file)) > 0) {
+        csv.append(buf, n);
+    }
+    fclose(file);
+    return loadTraceCsvString(csv.c_str());
+}
+
+bool VirtualSHT31::loadTraceCsvString(const char* csv) {
+    std::vector<Sample> trace;
+    const char* line = csv;
+    
+    while (line != nullptr && *line != '\0') {
+        const char* end = strchr(line, '\n');
+        std::string row(line, end != nullptr ? static_cast<size_t>(end - line) : strlen(line));
+        line = (end != nullptr) ? end + 1 : nullptr;
+        
+        float cols[3];
+        int count = sscanf(row.c_str(), "%f,%f,%f", &cols[0], &cols[1], &cols[2]);
+        if (count == 2) {
+            trace.push_back({cols[0], cols[1]});
+        } else if (count == 3) {
+            trace.push_back({cols[1], cols[2]});  // time, temperature, humidity
+        }
+        // Anything else (header, blank line, comment) is skipped
+    }
+    
+    if (trace.empty()) return false;
+    m_trace = trace;
+    m_trace_index = 0;
+    return true;
+}
+
+uint32_t VirtualSHT31::conversionTimeUs(uint16_t command) {
+    switch (command) {
+        case SHT3X_MEAS_STRETCH_HIGH:
+        case SHT3X_MEAS_NOSTRETCH_HIGH: return SHT3X_CONV_HIGH_US;
+        case SHT3X_MEAS_STRETCH_MED:
+        case SHT3X_MEAS_NOSTRETCH_MED: return SHT3X_CONV_MED_US;
+        case SHT3X_MEAS_STRETCH_LOW:
+        case SHT3X_MEAS_NOSTRETCH_LOW: return SHT3X_CONV_LOW_US;
+        default: return 0;
+    }
+}
+
+uint32_t VirtualSHT31::periodicIntervalUs(uint16_t command) {
+    if (command == SHT3X_ART) return 250000;
+    
+    // MSB selects the rate, LSB the repeatability
+    uint8_t lsb = command & 0xFF;
+    switch (command >> 8) {
+        case 0x20: return (lsb == 0x32 || lsb == 0x24 || lsb == 0x2F) ? 2000000 : 0;
+        case 0x21: return (lsb == 0x30 || lsb == 0x26 || lsb == 0x2D) ? 1000000 : 0;
+        case 0x22: return (lsb == 0x36 || lsb == 0x20 || lsb == 0x2B) ? 500000 : 0;
+        case 0x23: return (lsb == 0x34 || lsb == 0x22 || lsb == 0x29) ? 250000 : 0;
+        case 0x27: return (lsb == 0x37 || lsb == 0x21 || lsb == 0x2A) ? 100000 : 0;
+        default: return 0;
+    }
+}
+
+uint8_t VirtualSHT31::crc8(const uint8_t* data, size_t len) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x31) : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+bool VirtualSHT31::onWrite(const uint8_t* data, uint16_t len) {
+    int64_t now = esp_timer_get_time();
+    
+    // Busy converting or resetting: the address is not acknowledged
+    if (now < m_ready_at_us) return false;
+    if (len == 0) return true;  // Address probe
+    if (len == 5) return writeAlertLimit(data);
+    if (len != 2) return false;
+    
+    uint16_t command = (static_cast<uint16_t>(data[0]) << 8) | data[1];
+    
+    // Periodic mode accepts only fetch, break and soft reset
+    if (m_periodic_interval_us != 0) {
+        switch (command) {
+            case SHT3X_FETCH_DATA:
+                m_pending = Pending::FETCH;
+                return true;
+            case SHT3X_BREAK:
+                m_periodic_interval_us = 0;
+                m_pending = Pending::NONE;
+                m_ready_at_us = now + SHT3X_BREAK_US;
+                return true;
+            case SHT3X_SOFT_RESET:
+                m_periodic_interval_us = 0;
+                break;
+            default:
+                return false;
+        }
+    }
+    
+    switch (command) {
+        case SHT3X_SOFT_RESET:
+            m_pending = Pending::NONE;
+            m_heater = false;
+            m_ready_at_us = now + SHT3X_RESET_US;
+            m_soft_resets++;
+            return true;
+        case SHT3X_HEATER_ON:
+            m_heater = true;
+            return true;
+        case SHT3X_HEATER_OFF:
+            m_heater = false;
+            return true;
+        case SHT3X_CLEAR_STATUS:
+            return true;
+        case SHT3X_READ_STATUS:
+            m_pending = Pending::STATUS;
+            return true;
+        case SHT3X_BREAK:
+            return true;  // Already idle
+        default:
+            if (periodicIntervalUs(command) != 0) {
+                startPeriodic(command);
+                return true;
+            }
+            if (conversionTimeUs(command) == 0) return false;  // Unknown command
+            startMeasurement(command);
+            return true;
+    }
+}
+
+bool VirtualSHT31::onRead(uint8_t* data, uint16_t len, uint32_t& stretch_us) {
+    int64_t now = esp_timer_get_time();
+    stretch_us = 0;
+    
+    if (m_pending == Pending::STATUS) {
+        uint8_t status[3];
+        putWord(status, m_heater ? 0x2000 : 0x0000);
+        memcpy(data, status, len < 3 ? len : 3);
+        m_pending = Pending::NONE;
+        return true;
+    }
+    
+    if (m_pending == Pending::FETCH) {
+        m_pending = Pending::NONE;
+        if (now < m_periodic_next_us) return false;  // No new sample since the last fetch
+        
+        // Samples not fetched in time were overwritten; only the newest is read
+        while (m_periodic_next_us <= now) {
+            m_periodic_next_us += m_periodic_interval_us + m_periodic_lag_us;
+        }
+        captureSample();
+        m_measurements++;
+        m_pending = Pending::MEASUREMENT;
+        m_stretch = false;
+        m_ready_at_us = 0;
+    }
+    
+    if (m_pending != Pending::MEASUREMENT) return false;  // Nothing to fetch
+    
+    if (now < m_ready_at_us) {
+        if (!m_stretch) {
+            m_not_ready_nacks++;
+            return false;  // No-stretch mode: NACK until ready
+        }
+        stretch_us = static_cast<uint32_t>(m_ready_at_us - now);
+    }
+    
+    uint8_t frame[6];
+    putWord(&frame[0], m_raw_temperature);
+    putWord(&frame[3], m_raw_humidity);
+    if (m_corrupt_next_crc) {
+        frame[2] ^= 0xFF;
+        m_corrupt_next_crc = false;
+    }
+    memcpy(data, frame, len < 6 ? len : 6);
+    m_pending = Pending::NONE;
+    return true;
+}
+
+bool VirtualSHT31::writeAlertLimit(const uint8_t* data) {
+    // Limit registers are written from idle only, with a CRC over the word
+    if (m_periodic_interval_us != 0) return false;
+    if (crc8(&data[2], 2) != data[4]) return false;
+    
+    uint16_t command = (static_cast<uint16_t>(data[0]) << 8) | data[1];
+    uint16_t word = (static_cast<uint16_t>(data[2]) << 8) | data[3];
+    switch (command) {
+        case SHT3X_ALERT_HIGH_SET:   m_alert_limits[0] = word; return true;
+        case SHT3X_ALERT_HIGH_CLEAR: m_alert_limits[1] = word; return true;
+        case SHT3X_ALERT_LOW_CLEAR:  m_alert_limits[2] = word; return true;
+        case SHT3X_ALERT_LOW_SET:    m_alert_limits[3] = word; return true;
+        default: return false;
+    }
+}
+
+bool VirtualSHT31::alertActive() {
+    // Only evaluated in periodic mode, once the first sample has completed
+    if (m_periodic_interval_us == 0 || esp_timer_get_time() < m_periodic_next_us) {
+        m_alert = false;
+        return false;
+    }
+    
+    // Compare on the register resolution: 9 MSBs of T, 7 MSBs of RH
+    const Sample& sample = m_trace.empty() ? m_fixed : m_trace[m_trace_index];
+    float raw_t = (sample.temperature_c + 45.0f) / 175.0f * 65535.0f;
+    float raw_h = sample.humidity_pct / 100.0f * 65535.0f;
+    uint16_t t = static_cast<uint16_t>(std::lround(raw_t < 0 ? 0 : (raw_t > 65535 ? 65535 : raw_t))) >> 7;
+    uint16_t h = static_cast<uint16_t>(std::lround(raw_h < 0 ? 0 : (raw_h > 65535 ? 65535 : raw_h))) >> 9;
+    
+    auto limitT = [this](int i) { return static_cast<uint16_t>(m_alert_limits[i] & 0x01FF); };
+    auto limitH = [this](int i) { return static_cast<uint16_t>(m_alert_limits[i] >> 9); };
+    
+    if (t > limitT(0) || h > limitH(0) || t < limitT(3) || h < limitH(3)) {
+        m_alert = true;
+    } else if (t <= limitT(1) && h <= limitH(1) && t >= limitT(2) && h >= limitH(2)) {
+        m_alert = false;
+    }
+    return m_alert;
+}
+
+void VirtualSHT31::startMeasurement(uint16_t command) {
+    uint32_t conversion_us = conversionTimeUs(command);
+    m_repeatability = (conversion_us == SHT3X_CONV_LOW_US) ? 0 : (conversion_us == SHT3X_CONV_MED_US) ? 1 : 2;
+    m_measurements_at[m_repeatability]++;
+    captureSample();
+    
+    m_stretch = (command & 0xFF00) == 0x2C00;
+    m_pending = Pending::MEASUREMENT;
+    m_ready_at_us = esp_timer_get_time() + conversionTimeUs(command);
+    m_measurements++;
+}
+
+void VirtualSHT31::startPeriodic(uint16_t command) {
+    // Repeatability sits in the LSB; ART converts at high repeatability
+    uint32_t conversion_us = SHT3X_CONV_HIGH_US;
+    uint8_t lsb = command & 0xFF;
+    m_repeatability = 2;
+    if (lsb == 0x24 || lsb == 0x26 || lsb == 0x20 || lsb == 0x22 || lsb == 0x21) {
+        conversion_us = SHT3X_CONV_MED_US;
+        m_repeatability = 1;
+    } else if (lsb == 0x2F || lsb == 0x2D || lsb == 0x2B || lsb == 0x29 || lsb == 0x2A) {
+        conversion_us = SHT3X_CONV_LOW_US;
+        m_repeatability = 0;
+    }
+    
+    m_periodic_interval_us = periodicIntervalUs(command);
+    m_periodic_next_us = esp_timer_get_time() + conversion_us + m_periodic_lag_us;
+    m_pending = Pending::NONE;
+}
+
+void VirtualSHT31::captureSample() {
+    Sample sample = m_fixed;
+    if (!m_trace.empty()) {
+        sample = m_trace[m_trace_index];
+        m_trace_index = (m_trace_index + 1) % m_trace.size();
+    }
+    
+    if (m_noise_scale > 0.0f || m_excess_temp_c > 0.0f || m_excess_hum_pct > 0.0f) {
+        static const float TEMP_SIGMA[3] = {0.05f, 0.0267f, 0.0133f};   // Datasheet 3 sigma / 3
+        static const float HUM_SIGMA[3] = {0.07f, 0.05f, 0.0267f};
+        float sensor_t = TEMP_SIGMA[m_repeatability] * m_noise_scale;
+        float sensor_h = HUM_SIGMA[m_repeatability] * m_noise_scale;
+        float temp_sigma = std::sqrt(sensor_t * sensor_t + m_excess_temp_c * m_excess_temp_c);
+        float hum_sigma = std::sqrt(sensor_h * sensor_h + m_excess_hum_pct * m_excess_hum_pct);
+        sample.temperature_c += temp_sigma * gaussian();
+        sample.humidity_pct += hum_sigma * gaussian();
+    }
+    
+    // Inverse of the datasheet conversion formulas
+    float raw_t = (sample.temperature_c + 45.0f) / 175.0f * 65535.0f;
+    float raw_h = sample.humidity_pct / 100.0f * 65535.0f;
+    m_raw_temperature = static_cast<uint16_t>(std::lround(raw_t < 0 ? 0 : (raw_t > 65535 ? 65535 : raw_t)));
+    m_raw_humidity = static_cast<uint16_t>(std::lround(raw_h < 0 ? 0 : (raw_h > 65535 ? 65535 : raw_h)));
+    m_last_temperature = sample.temperature_c;
+    m_last_humidity = sample.humidity_pct;
+}
+
+float VirtualSHT31::gaussian() {
+    // Irwin-Hall: the sum of 12 uniforms minus 6 is close enough to N(0, 1)
+    float sum = 0.0f;
+    for (int i = 0; i < 12; i++) {
+        m_noise_state ^= m_noise_state << 13;
+        m_noise_state ^= m_noise_state >> 17;
+        m_noise_state ^= m_noise_state << 5;
+        sum += static_cast<float>(m_noise_state) / 4294967296.0f;
+    }
+    return sum - 6.0f;
+}
+
+void VirtualSHT31::putWord(uint8_t* out, uint16_t word) {
+    out[0] = static_cast<uint8_t>(word >> 8);
+    out[1] = static_cast<uint8_t>(word & 0xFF);
+    out[2] = crc8(out, 2);
+}
+
+#endif // NATIVE_BUILD
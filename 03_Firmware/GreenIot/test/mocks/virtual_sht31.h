@@ -0,0 +1,147 @@
+/**
+ * @file virtual_sht31.h
+ * @brief Cycle-timed SHT3x device model for the simulated I2C bus
+ * 
+ * Honours the single-shot command set (with and without clock stretching),
+ * periodic mode (0.5-10 mps and ART, FETCH_DATA, BREAK), soft reset, heater
+ * and status commands, typical conversion times and CRC-8 framing.
+ * Without stretching an early fetch is NACKed; with stretching SCL is held
+ * until the conversion completes. In periodic mode only the newest sample
+ * is kept and a fetch with nothing new is NACKed. Alert limits (high/low
+ * set/clear) are held at register resolution and drive alertActive() while
+ * periodic mode runs.
+ * 
+ * Conditions come from setConditions() or from a replayed CSV trace (one
+ * row per measurement, wrapping at the end):
+ * 
+ *   temperature_c,humidity_pct
+ *   22.50,61.2
+ * 
+ * A leading timestamp column (3 columns) is accepted and ignored.
+ * 
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#ifndef VIRTUAL_SHT31_H
+#define VIRTUAL_SHT31_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "sim_i2c_bus.h"
+
+class VirtualSHT31 : public ISimI2CDevice {
+public:
+    explicit VirtualSHT31(uint8_t address = 0x44);
+    
+    // Conditions
+    void setConditions(float temperature_c, float humidity_pct);
+    bool loadTraceCsv(const char* path);
+    bool loadTraceCsvString(const char* csv);
+    size_t traceLength() const { return m_trace.size(); }
+    
+    /**
+     * @brief Gaussian noise on every conversion (0 = off, the default)
+     * 
+     * Repeatability noise follows the datasheet (3 sigma = 0.15 / 0.08 / 0.04 °C
+     * and 0.21 / 0.15 / 0.08 %RH at low / medium / high) scaled by
+     * repeatability_scale; the excess sigma models air turbulence and is the
+     * same at every repeatability.
+     */
+    void setNoise(float repeatability_scale, float excess_temp_c = 0.0f, float excess_hum_pct = 0.0f);
+    
+    // Fault injection
+    void setMaxClockHz(uint32_t frequency_hz) { m_max_clock_hz = frequency_hz; }
+    void corruptNextCrc() { m_corrupt_next_crc = true; }
+    void setPeriodicLagUs(uint32_t lag_us) { m_periodic_lag_us = lag_us; }  // Slow sensor clock
+    
+    // Observation
+    uint32_t measurementsStarted() const { return m_measurements; }
+    uint32_t softResets() const { return m_soft_resets; }
+    uint32_t notReadyNacks() const { return m_not_ready_nacks; }
+    bool lastCommandStretched() const { return m_stretch; }
+    uint8_t lastRepeatability() const { return m_repeatability; }   // 0=low, 1=medium, 2=high
+    uint32_t measurementsAt(uint8_t repeatability) const { return m_measurements_at[repeatability]; }
+    bool heaterEnabled() const { return m_heater; }
+    bool periodicActive() const { return m_periodic_interval_us != 0; }
+    float lastTemperature() const { return m_last_temperature; }
+    float lastHumidity() const { return m_last_humidity; }
+    uint16_t alertLimit(uint8_t index) const { return m_alert_limits[index]; }  // High set, high clear, low clear, low set
+    
+    /**
+     * @brief Level of the ALERT output for the current conditions
+     */
+    bool alertActive();
+    
+    /**
+     * @brief Conversion time for a measurement command (0 if not one)
+     */
+    static uint32_t conversionTimeUs(uint16_t command);
+    
+    /**
+     * @brief Sample interval for a periodic start command (0 if not one)
+     */
+    static uint32_t periodicIntervalUs(uint16_t command);
+    static uint8_t crc8(const uint8_t* data, size_t len);
+    
+    // ISimI2CDevice
+    uint8_t address() const override { return m_address; }
+    uint32_t maxClockHz() const override { return m_max_clock_hz; }
+    bool onWrite(const uint8_t* data, uint16_t len) override;
+    bool onRead(uint8_t* data, uint16_t len, uint32_t& stretch_us) override;
+    
+private:
+    enum class Pending {
+        NONE,
+        MEASUREMENT,
+        FETCH,
+        STATUS
+    };
+    
+    struct Sample {
+        float temperature_c;
+        float humidity_pct;
+    };
+    
+    uint8_t m_address;
+    uint32_t m_max_clock_hz;
+    
+    std::vector<Sample> m_trace;
+    size_t m_trace_index;
+    Sample m_fixed;
+    
+    Pending m_pending;
+    bool m_stretch;
+    int64_t m_ready_at_us;   // Conversion (or reset) completes
+    uint16_t m_raw_temperature;
+    uint16_t m_raw_humidity;
+    bool m_heater;
+    bool m_corrupt_next_crc;
+    uint32_t m_periodic_interval_us;   // 0 = single-shot mode
+    int64_t m_periodic_next_us;        // Next periodic sample completes
+    uint32_t m_periodic_lag_us;        // Added to every periodic interval
+    uint16_t m_alert_limits[4];        // High set, high clear, low clear, low set
+    bool m_alert;
+    uint8_t m_repeatability;           // Of the last conversion
+    float m_noise_scale;
+    float m_excess_temp_c;
+    float m_excess_hum_pct;
+    uint32_t m_noise_state;            // xorshift32
+    
+    uint32_t m_measurements;
+    uint32_t m_measurements_at[3];
+    uint32_t m_soft_resets;
+    uint32_t m_not_ready_nacks;
+    float m_last_temperature;
+    float m_last_humidity;
+    
+    bool writeAlertLimit(const uint8_t* data);
+    void startMeasurement(uint16_t command);
+    void startPeriodic(uint16_t command);
+    void captureSample();
+    float gaussian();
+    void putWord(uint8_t* out, uint16_t word);
+};
+
+#endif // VIRTUAL_SHT31_H
@@ -62,8 +62,8 @@ void setUp(void) {
     test_config.features = BLE_MESH_FEATURE_LOW_POWER | BLE_MESH_FEATURE_PROXY;
     
     // Initialize test sensor data
-    test_sensor_data.temperature_celsius = 22.5f;
-    test_sensor_data.humidity_percent = 65.0f;
+    test_sensor_data.temperature_centi_c = 2250;
+    test_sensor_data.humidity_centi_pct = 6500;
     test_sensor_data.battery_level = 95;
     test_sensor_data.timestamp = 123456;
 }
@@ -222,17 +222,17 @@ void test_ble_mesh_publish_temperature_range(void) {
     TEST_ASSERT_EQUAL(BLE_MESH_OK, status);
     
     // Test min temperature
-    test_sensor_data.temperature_celsius = -40.0f;
+    test_sensor_data.temperature_centi_c = -4000;
     status = ble_mesh_publish_sensor_data(&test_sensor_data);
     TEST_ASSERT_EQUAL(BLE_MESH_OK, status);
     
     // Test max temperature
-    test_sensor_data.temperature_celsius = 85.0f;
+    test_sensor_data.temperature_centi_c = 8500;
     status = ble_mesh_publish_sensor_data(&test_sensor_data);
     TEST_ASSERT_EQUAL(BLE_MESH_OK, status);
     
     // Test optimal basil temperature
-    test_sensor_data.temperature_celsius = 22.0f;
+    test_sensor_data.temperature_centi_c = 2200;
     status = ble_mesh_publish_sensor_data(&test_sensor_data);
     TEST_ASSERT_EQUAL(BLE_MESH_OK, status);
     
@@ -244,17 +244,17 @@ void test_ble_mesh_publish_humidity_range(void) {
     TEST_ASSERT_EQUAL(BLE_MESH_OK, status);
     
     // Test min humidity
-    test_sensor_data.humidity_percent = 0.0f;
+    test_sensor_data.humidity_centi_pct = 0;
     status = ble_mesh_publish_sensor_data(&test_sensor_data);
     TEST_ASSERT_EQUAL(BLE_MESH_OK, status);
     
     // Test max humidity
-    test_sensor_data.humidity_percent = 100.0f;
+    test_sensor_data.humidity_centi_pct = 10000;
     status = ble_mesh_publish_sensor_data(&test_sensor_data);
     TEST_ASSERT_EQUAL(BLE_MESH_OK, status);
     
     // Test optimal basil humidity
-    test_sensor_data.humidity_percent = 65.0f;
+    test_sensor_data.humidity_centi_pct = 6500;
     status = ble_mesh_publish_sensor_data(&test_sensor_data);
     TEST_ASSERT_EQUAL(BLE_MESH_OK, status);
     
@@ -188,8 +188,8 @@ void setUp(void) {
     test_config.lpn_poll_interval_ms = 10000;
     test_config.features = BLE_MESH_FEATURE_LOW_POWER | BLE_MESH_FEATURE_PROXY;
     
-    test_sensor_data.temperature_celsius = 22.5f;
-    test_sensor_data.humidity_percent = 65.0f;
+    test_sensor_data.temperature_centi_c = 2250;
+    test_sensor_data.humidity_centi_pct = 6500;
     test_sensor_data.battery_level = 95;
     test_sensor_data.timestamp = 123456;
 }
@@ -0,0 +1,237 @@
+/**
+ * @file test_fixed_point.cpp
+ * @brief Native Unit Tests for the fixed-point measurement pipeline
+ *
+ * Checks the integer conversions against the float formulas they replaced
+ * and benchmarks one wake's worth of arithmetic in both representations.
+ *
+ * Test Coverage:
+ * - SHT31 raw codes -> centi-°C / centi-%RH over the full 16-bit range
+ * - Calibration offsets and humidity clamping
+ * - Mesh 0.5-unit quantisation
+ * - Battery ADC -> mV -> percent
+ * - CENTI_FMT / CENTI_ARGS log formatting
+ * - Per-wake benchmark: float pipeline vs fixed-point pipeline
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "fixed_point.h"
+#include "PowerManager.hpp"
+#include "SHT31Sensor.hpp"
+
+#ifndef NATIVE_BUILD
+#include "esp_cpu.h"
+#endif
+
+// =======================================================================================
+// REFERENCE (FLOAT) AND FIXED-POINT PIPELINES
+// =======================================================================================
+
+struct WakeInput {
+    uint16_t raw_t;
+    uint16_t raw_h;
+    uint16_t adc;
+};
+
+struct WakeOutput {
+    int16_t mesh_t;     // 0.5 °C steps
+    uint16_t mesh_h;    // 0.5 %RH steps
+    uint8_t battery_pct;
+};
+
+// The arithmetic the firmware did per wake before the switch to integers
+static WakeOutput floatPipeline(const WakeInput& in, float temp_offset, float hum_offset) {
+    float temp = -45.0f + 175.0f * (static_cast<float>(in.raw_t) / 65535.0f) + temp_offset;
+    float hum = 100.0f * (static_cast<float>(in.raw_h) / 65535.0f) + hum_offset;
+    if (hum < 0.0f) hum = 0.0f;
+    if (hum > 100.0f) hum = 100.0f;
+    
+    float vbat = (static_cast<float>(in.adc) / 4095.0f) * 3.3f * 2.0f;
+    float pct = (vbat - 3.0f) / 1.2f * 100.0f;
+    if (pct < 0.0f) pct = 0.0f;
+    if (pct > 100.0f) pct = 100.0f;
+    
+    WakeOutput out;
+    out.mesh_t = static_cast<int16_t>(temp / 0.5f);
+    out.mesh_h = static_cast<uint16_t>(hum / 0.5f);
+    out.battery_pct = static_cast<uint8_t>(pct);
+    return out;
+}
+
+// Same steps on the integer path used by SHT31Sensor, ble_mesh_driver and PowerManager
+static WakeOutput fixedPipeline(const WakeInput& in, int16_t temp_offset, int16_t hum_offset) {
+    int32_t temp = SHT31Sensor::rawToCentiCelsius(in.raw_t) + temp_offset;
+    int32_t hum = static_cast<int32_t>(SHT31Sensor::rawToCentiPercent(in.raw_h)) + hum_offset;
+    if (hum < 0) hum = 0;
+    if (hum > 10000) hum = 10000;
+    
+    WakeOutput out;
+    out.mesh_t = static_cast<int16_t>(temp / 50);
+    out.mesh_h = static_cast<uint16_t>(hum / 50);
+    out.battery_pct = PowerManager::millivoltsToPercent(PowerManager::adcToMillivolts(in.adc));
+    return out;
+}
+
+static uint32_t nowTicks() {
+#ifdef NATIVE_BUILD
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#else
+    return esp_cpu_get_cycle_count();
+#endif
+}
+
+// =======================================================================================
+// TEST SETUP & TEARDOWN
+// =======================================================================================
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// =======================================================================================
+// CONVERSION TESTS
+// =======================================================================================
+
+void test_fixed_raw_conversion_matches_float() {
+    for (uint32_t raw = 0; raw <= 0xFFFF; raw++) {
+        float t = -45.0f + 175.0f * (static_cast<float>(raw) / 65535.0f);
+        float h = 100.0f * (static_cast<float>(raw) / 65535.0f);
+        
+        TEST_ASSERT_INT_WITHIN(1, std::lround(t * 100.0f),
+                               SHT31Sensor::rawToCentiCelsius(static_cast<uint16_t>(raw)));
+        TEST_ASSERT_INT_WITHIN(1, std::lround(h * 100.0f),
+                               SHT31Sensor::rawToCentiPercent(static_cast<uint16_t>(raw)));
+    }
+    
+    // Datasheet end points
+    TEST_ASSERT_EQUAL_INT16(-4500, SHT31Sensor::rawToCentiCelsius(0));
+    TEST_ASSERT_EQUAL_INT16(13000, SHT31Sensor::rawToCentiCelsius(0xFFFF));
+    TEST_ASSERT_EQUAL_UINT16(10000, SHT31Sensor::rawToCentiPercent(0xFFFF));
+}
+
+void test_fixed_offsets_and_clamping() {
+    WakeInput in = {0x6666, 0xFFF0, 3000};
+    
+    // Humidity offset pushes past 100 %RH and below 0 %RH
+    WakeOutput high = fixedPipeline(in, 0, 500);
+    TEST_ASSERT_EQUAL_UINT16(200, high.mesh_h);
+    
+    in.raw_h = 0x0100;
+    WakeOutput low = fixedPipeline(in, 0, -500);
+    TEST_ASSERT_EQUAL_UINT16(0, low.mesh_h);
+    
+    // Temperature offset is applied before quantisation
+    int16_t base = fixedPipeline(in, 0, 0).mesh_t;
+    TEST_ASSERT_EQUAL_INT16(base - 2, fixedPipeline(in, -100, 0).mesh_t);
+}
+
+void test_fixed_mesh_quantisation_matches_float() {
+    // Sweep both raw codes; the integer path may only disagree where the float
+    // value lies within one centi-unit of a 0.5 step boundary
+    uint32_t mismatches = 0;
+    uint32_t samples = 0;
+    for (uint32_t raw = 0; raw <= 0xFFFF; raw += 7) {
+        WakeInput in = {static_cast<uint16_t>(raw), static_cast<uint16_t>(raw), 2500};
+        WakeOutput f = floatPipeline(in, -0.25f, 1.5f);
+        WakeOutput x = fixedPipeline(in, -25, 150);
+        
+        TEST_ASSERT_INT_WITHIN(1, f.mesh_t, x.mesh_t);
+        TEST_ASSERT_INT_WITHIN(1, f.mesh_h, x.mesh_h);
+        if (f.mesh_t != x.mesh_t || f.mesh_h != x.mesh_h) mismatches++;
+        samples++;
+    }
+    TEST_ASSERT_LESS_THAN(samples / 50, mismatches);
+}
+
+void test_fixed_battery_millivolts() {
+    for (uint32_t adc = 0; adc <= 4095; adc++) {
+        float vbat = (static_cast<float>(adc) / 4095.0f) * 3.3f * 2.0f;
+        TEST_ASSERT_INT_WITHIN(2, std::lround(vbat * 1000.0f),
+                               PowerManager::adcToMillivolts(static_cast<uint16_t>(adc)));
+    }
+    
+    TEST_ASSERT_EQUAL_UINT8(0, PowerManager::millivoltsToPercent(2900));
+    TEST_ASSERT_EQUAL_UINT8(0, PowerManager::millivoltsToPercent(3000));
+    TEST_ASSERT_EQUAL_UINT8(50, PowerManager::millivoltsToPercent(3600));
+    TEST_ASSERT_EQUAL_UINT8(100, PowerManager::millivoltsToPercent(4200));
+    TEST_ASSERT_EQUAL_UINT8(100, PowerManager::millivoltsToPercent(4300));
+}
+
+void test_fixed_log_formatting() {
+    char text[16];
+    int16_t values[] = {-50, 2205, -4000, 0, 7};
+    const char* expected[] = {"-0.50", "22.05", "-40.00", "0.00", "0.07"};
+    
+    for (uint8_t i = 0; i < 5; i++) {
+        int16_t v = values[i];
+        snprintf(text, sizeof(text), CENTI_FMT, CENTI_ARGS(v));
+        TEST_ASSERT_EQUAL_STRING(expected[i], text);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -0.5f, centi_to_float(-50));
+}
+
+// =======================================================================================
+// BENCHMARK
+// =======================================================================================
+
+void test_fixed_benchmark_per_wake() {
+    const uint32_t ROUNDS = 20000;
+    volatile uint16_t raw = 0x6000;  // volatile: keep the compiler from folding the inputs
+    volatile int32_t sink = 0;
+    
+    uint32_t start = nowTicks();
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        WakeInput in = {static_cast<uint16_t>(raw + i), static_cast<uint16_t>(raw - i),
+                        static_cast<uint16_t>(2400 + (i & 0x3FF))};
+        WakeOutput out = floatPipeline(in, -0.25f, 1.5f);
+        sink = sink + out.mesh_t + out.mesh_h + out.battery_pct;
+    }
+    uint32_t float_ticks = nowTicks() - start;
+    
+    start = nowTicks();
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        WakeInput in = {static_cast<uint16_t>(raw + i), static_cast<uint16_t>(raw - i),
+                        static_cast<uint16_t>(2400 + (i & 0x3FF))};
+        WakeOutput out = fixedPipeline(in, -25, 150);
+        sink = sink + out.mesh_t + out.mesh_h + out.battery_pct;
+    }
+    uint32_t fixed_ticks = nowTicks() - start;
+    
+    char message[120];
+#ifdef NATIVE_BUILD
+    snprintf(message, sizeof(message), "Per wake (host, FPU): float %u ns, fixed %u ns",
+             static_cast<unsigned>(float_ticks / ROUNDS), static_cast<unsigned>(fixed_ticks / ROUNDS));
+#else
+    snprintf(message, sizeof(message), "Per wake (ESP32-C3, soft-float): float %u cycles, fixed %u cycles",
+             static_cast<unsigned>(float_ticks / ROUNDS), static_cast<unsigned>(fixed_ticks / ROUNDS));
+    TEST_ASSERT_LESS_THAN(float_ticks, fixed_ticks);
+#endif
+    TEST_MESSAGE(message);
+    (void)sink;
+}
+
+// =======================================================================================
+// MAIN TEST RUNNER
+// =======================================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    
+    RUN_TEST(test_fixed_raw_conversion_matches_float);
+    RUN_TEST(test_fixed_offsets_and_clamping);
+    RUN_TEST(test_fixed_mesh_quantisation_matches_float);
+    RUN_TEST(test_fixed_battery_millivolts);
+    RUN_TEST(test_fixed_log_formatting);
+    RUN_TEST(test_fixed_benchmark_per_wake);
+    
+    return UNITY_END();
+}
@@ -0,0 +1,298 @@
+/**
+ * @file test_i2c_async.cpp
+ * @brief Native Unit Tests for the asynchronous I2C transaction queue
+ *
+ * Runs the firmware's I2CDriver submit() queue and worker task on SimI2CBus
+ * with the host FreeRTOS subset from test/mocks, so the overlap between
+ * SHT31 conversion and other wake-cycle work can be measured on a PC.
+ *
+ * Test Coverage:
+ * - submit() returns without waiting for the bus
+ * - Completion callbacks report per-transaction status
+ * - FIFO execution order and start delays
+ * - Queue-full back-pressure (ERROR_BUS_BUSY)
+ * - Wake-window timing: async overlap vs blocking sequence
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#include <unity.h>
+#include <atomic>
+#include <cstdio>
+#include "I2CDriver.hpp"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sim_i2c_bus.h"
+
+// =======================================================================================
+// SCRIPTED DEVICE (one device at 0x44, reads return 0xA0, 0xA1, ...)
+// =======================================================================================
+
+class ScriptedDevice : public ISimI2CDevice {
+public:
+    static constexpr uint8_t ADDR = 0x44;
+    
+    uint8_t address() const override { return ADDR; }
+    
+    bool onWrite(const uint8_t* data, uint16_t len) override {
+        if (len > 0) {
+            m_last_write = data[0];
+        }
+        return true;
+    }
+    
+    bool onRead(uint8_t* data, uint16_t len, uint32_t& stretch_us) override {
+        for (uint16_t i = 0; i < len; i++) {
+            data[i] = static_cast<uint8_t>(0xA0 + i);
+        }
+        return true;
+    }
+    
+    uint8_t lastWrite() const { return m_last_write; }
+    
+private:
+    uint8_t m_last_write = 0;
+};
+
+static SimI2CBus s_bus;
+static ScriptedDevice s_device;
+
+// =======================================================================================
+// COMPLETION HELPERS (callbacks run on the driver's worker task)
+// =======================================================================================
+
+struct Completion {
+    std::atomic<bool> done{false};
+    std::atomic<int> status{-1};
+    int64_t done_us = 0;
+};
+
+static void onComplete(I2CStatus status, void* context) {
+    Completion* c = static_cast<Completion*>(context);
+    c->done_us = esp_timer_get_time();
+    c->status = static_cast<int>(status);
+    c->done = true;
+}
+
+struct OrderLog {
+    int order[8];
+    std::atomic<int> count{0};
+};
+
+struct OrderTag {
+    OrderLog* log;
+    int id;
+};
+
+static void onOrdered(I2CStatus status, void* context) {
+    OrderTag* tag = static_cast<OrderTag*>(context);
+    tag->log->order[tag->log->count++] = tag->id;
+}
+
+static uint32_t elapsedMs(int64_t since_us) {
+    return static_cast<uint32_t>((esp_timer_get_time() - since_us) / 1000);
+}
+
+// SHT31 single-shot, high repeatability
+static constexpr uint32_t SHT31_CONVERSION_MS = 15;
+static constexpr uint32_t OTHER_WORK_MS = 10;  // e.g. battery ADC averaging
+
+static const uint8_t SHT31_CMD[2] = {0x2C, 0x06};
+
+// =======================================================================================
+// TEST SETUP & TEARDOWN
+// =======================================================================================
+
+void setUp(void) {
+    s_bus.detachAll();
+    s_device = ScriptedDevice();
+    s_bus.attach(&s_device);
+    
+    I2CDriver& driver = I2CDriver::getInstance();
+    driver.deinit();
+    native_set_reset_reason(ESP_RST_POWERON);
+    driver.setBackend(&s_bus);
+    
+    I2CConfig config;
+    config.frequency_hz = 100000;  // Standard mode byte timing
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(driver.init(config)));
+}
+
+void tearDown(void) {
+    I2CDriver::getInstance().waitIdle(200);
+}
+
+// =======================================================================================
+// UNIT TESTS
+// =======================================================================================
+
+void test_async_submit_returns_immediately() {
+    I2CDriver& driver = I2CDriver::getInstance();
+    uint8_t buf[6];
+    Completion completion;
+    
+    I2CTransaction fetch;
+    fetch.device_addr = ScriptedDevice::ADDR;
+    fetch.read_data = buf;
+    fetch.read_len = 6;
+    fetch.start_delay_ms = SHT31_CONVERSION_MS;
+    fetch.callback = onComplete;
+    fetch.context = &completion;
+    
+    int64_t start_us = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(driver.submit(fetch)));
+    TEST_ASSERT_LESS_THAN_UINT32(2, elapsedMs(start_us));
+    
+    TEST_ASSERT_TRUE(driver.waitIdle(200));
+    TEST_ASSERT_TRUE(completion.done);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(SHT31_CONVERSION_MS * 1000,
+                                        static_cast<uint32_t>(completion.done_us - start_us));
+}
+
+void test_async_callback_reports_status() {
+    I2CDriver& driver = I2CDriver::getInstance();
+    uint8_t buf[6] = {0};
+    Completion ok_completion;
+    Completion nack_completion;
+    
+    I2CTransaction ok_txn;
+    ok_txn.device_addr = ScriptedDevice::ADDR;
+    ok_txn.read_data = buf;
+    ok_txn.read_len = 6;
+    ok_txn.callback = onComplete;
+    ok_txn.context = &ok_completion;
+    
+    I2CTransaction nack_txn = ok_txn;
+    nack_txn.device_addr = 0x45;  // Nothing attached
+    nack_txn.context = &nack_completion;
+    
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(driver.submit(ok_txn)));
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(driver.submit(nack_txn)));
+    
+    TEST_ASSERT_TRUE(driver.waitIdle(200));
+    TEST_ASSERT_TRUE(ok_completion.done);
+    TEST_ASSERT_TRUE(nack_completion.done);
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), ok_completion.status.load());
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::ERROR_NACK_ADDR), nack_completion.status.load());
+    TEST_ASSERT_EQUAL_HEX8(0xA0, buf[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xA5, buf[5]);
+}
+
+void test_async_fifo_order() {
+    I2CDriver& driver = I2CDriver::getInstance();
+    OrderLog log;
+    OrderTag tags[4];
+    
+    for (int i = 0; i < 4; i++) {
+        tags[i].log = &log;
+        tags[i].id = i;
+        
+        I2CTransaction txn;
+        txn.device_addr = ScriptedDevice::ADDR;
+        txn.write_data = SHT31_CMD;
+        txn.write_len = 2;
+        txn.start_delay_ms = (i == 0) ? 5 : 0;  // Later entries must still wait their turn
+        txn.callback = onOrdered;
+        txn.context = &tags[i];
+        TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(driver.submit(txn)));
+    }
+    
+    TEST_ASSERT_TRUE(driver.waitIdle(200));
+    TEST_ASSERT_EQUAL(4, log.count.load());
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(i, log.order[i]);
+    }
+    TEST_ASSERT_EQUAL_HEX8(0x2C, s_device.lastWrite());
+}
+
+void test_async_queue_full_returns_busy() {
+    I2CDriver& driver = I2CDriver::getInstance();
+    
+    I2CTransaction txn;
+    txn.device_addr = ScriptedDevice::ADDR;
+    txn.write_data = SHT31_CMD;
+    txn.write_len = 2;
+    
+    // Hold the worker in a start delay so the queue fills deterministically
+    I2CTransaction hold = txn;
+    hold.start_delay_ms = 50;
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(driver.submit(hold)));
+    vTaskDelay(pdMS_TO_TICKS(5));
+    
+    int queued = 0;
+    while (driver.submit(txn) == I2CStatus::OK) {
+        queued++;
+        TEST_ASSERT_LESS_THAN(64, queued);
+    }
+    TEST_ASSERT_EQUAL(8, queued);  // I2C_ASYNC_QUEUE_DEPTH
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::ERROR_BUS_BUSY), static_cast<int>(driver.submit(txn)));
+    
+    TEST_ASSERT_TRUE(driver.waitIdle(200));
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(driver.submit(txn)));
+}
+
+void test_async_overlaps_conversion_with_other_work() {
+    I2CDriver& driver = I2CDriver::getInstance();
+    uint8_t buf[6];
+    
+    // Blocking baseline: command, fixed conversion wait, read, then the other work
+    int64_t start_us = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK),
+                      static_cast<int>(driver.write(ScriptedDevice::ADDR, SHT31_CMD, 2)));
+    vTaskDelay(pdMS_TO_TICKS(SHT31_CONVERSION_MS));
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK),
+                      static_cast<int>(driver.read(ScriptedDevice::ADDR, buf, 6)));
+    vTaskDelay(pdMS_TO_TICKS(OTHER_WORK_MS));
+    uint32_t blocking_ms = elapsedMs(start_us);
+    
+    // Async: queue command + delayed fetch, do the other work, then wait for completion
+    I2CTransaction command;
+    command.device_addr = ScriptedDevice::ADDR;
+    command.write_data = SHT31_CMD;
+    command.write_len = 2;
+    
+    Completion completion;
+    I2CTransaction fetch;
+    fetch.device_addr = ScriptedDevice::ADDR;
+    fetch.read_data = buf;
+    fetch.read_len = 6;
+    fetch.start_delay_ms = SHT31_CONVERSION_MS;
+    fetch.callback = onComplete;
+    fetch.context = &completion;
+    
+    start_us = esp_timer_get_time();
+    driver.submit(command);
+    driver.submit(fetch);
+    vTaskDelay(pdMS_TO_TICKS(OTHER_WORK_MS));
+    TEST_ASSERT_TRUE(driver.waitIdle(200));
+    uint32_t async_ms = elapsedMs(start_us);
+    
+    char msg[96];
+    snprintf(msg, sizeof(msg), "Wake window: blocking %u ms, async %u ms",
+             (unsigned)blocking_ms, (unsigned)async_ms);
+    TEST_MESSAGE(msg);
+    
+    // Async window tracks max(conversion, other work) instead of their sum
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(SHT31_CONVERSION_MS + OTHER_WORK_MS, blocking_ms);
+    TEST_ASSERT_LESS_THAN_UINT32(blocking_ms - (OTHER_WORK_MS / 2), async_ms);
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), completion.status.load());
+}
+
+// =======================================================================================
+// TEST RUNNER
+// =======================================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    
+    RUN_TEST(test_async_submit_returns_immediately);
+    RUN_TEST(test_async_callback_reports_status);
+    RUN_TEST(test_async_fifo_order);
+    RUN_TEST(test_async_queue_full_returns_busy);
+    RUN_TEST(test_async_overlaps_conversion_with_other_work);
+    
+    return UNITY_END();
+}
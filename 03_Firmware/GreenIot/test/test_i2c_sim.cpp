@@ -0,0 +1,745 @@
+/**
+ * @file test_i2c_sim.cpp
+ * @brief Native Integration Tests: real I2CDriver + SHT31Sensor on a simulated bus
+ *
+ * Runs the firmware's own I2CDriver (worker task, batches, clock profiles,
+ * recovery, topology cache) and SHT31Sensor against SimI2CBus and a
+ * cycle-timed VirtualSHT31, with the host FreeRTOS subset from test/mocks.
+ *
+ * Test Coverage:
+ * - Async acquisition decodes a replayed CSV trace
+ * - Synchronous trigger + read path
+ * - CRC errors are detected
+ * - Clock profiles shrink bus-occupied time (benchmark)
+ * - Speed fallback when the device cannot keep up
+ * - Transparent recovery of a stuck bus
+ * - A failing batch step aborts the later steps and keeps earlier results;
+ *   DELAY_UNTIL offsets count from the batch start
+ * - Topology cache skips probing on warm wakes only
+ * - Periodic mode streams samples at the configured rate without conversion waits
+ * - An early periodic fetch (slow sensor clock) never steps the clock profile down
+ * - Single-shot commands are rejected in periodic mode, BREAK returns to idle
+ * - Readiness polling ends a reading at the real conversion time, not the worst case
+ * - Burst acquisition masks a CRC error and outvotes a spike
+ * - Alert limits drive ALERT with hysteresis; a warm wake ends monitoring
+ * - AHT20 calibrates on a cold start and decodes a single-shot reading
+ * - A SHT31 + AHT20 group overlaps conversions, merges the readings and
+ *   acquires only the selected members
+ * - A group masks a failing member and keeps reporting; group bursts run the
+ *   members at their burst precision
+ * - Adaptive repeatability drops to low in a quiet room and returns to high
+ *   near a critical limit, also for a group member
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#include <unity.h>
+#include <cmath>
+#include <cstdio>
+#include "I2CDriver.hpp"
+#include "SHT31Sensor.hpp"
+#include "AHT20Sensor.hpp"
+#include "SensorGroup.hpp"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sim_i2c_bus.h"
+#include "virtual_sht31.h"
+#include "virtual_aht20.h"
+
+static const char* TRACE_CSV =
+    "time_ms,temperature_c,humidity_pct\n"
+    "0,22.50,61.20\n"
+    "300000,22.75,60.80\n"
+    "600000,23.10,59.90\n";
+
+static SimI2CBus s_bus;
+static VirtualSHT31 s_sht31(0x44);
+static VirtualAHT20 s_aht20;
+
+static void startDriver(esp_reset_reason_t reset_reason) {
+    I2CDriver& driver = I2CDriver::getInstance();
+    driver.deinit();
+    native_set_reset_reason(reset_reason);
+    driver.setBackend(&s_bus);
+    
+    I2CConfig config;
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(driver.init(config)));
+    driver.resetStats();
+}
+
+// =======================================================================================
+// TEST SETUP & TEARDOWN
+// =======================================================================================
+
+void setUp(void) {
+    s_bus.detachAll();
+    s_bus.setSdaStuck(false);
+    s_sht31 = VirtualSHT31(0x44);
+    s_bus.attach(&s_sht31);
+    s_aht20 = VirtualAHT20();
+    startDriver(ESP_RST_POWERON);
+}
+
+void tearDown(void) {
+    I2CDriver::getInstance().waitIdle(100);
+}
+
+// =======================================================================================
+// TESTS
+// =======================================================================================
+
+void test_sim_async_acquisition_replays_trace() {
+    TEST_ASSERT_TRUE(s_sht31.loadTraceCsvString(TRACE_CSV));
+    TEST_ASSERT_EQUAL(3, static_cast<int>(s_sht31.traceLength()));
+    
+    SHT31Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    
+    const float expected[3][2] = {{22.50f, 61.20f}, {22.75f, 60.80f}, {23.10f, 59.90f}};
+    for (int i = 0; i < 3; i++) {
+        SensorData data;
+        TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK),
+                          static_cast<int>(sensor.triggerMeasurementAsync()));
+        TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK),
+                          static_cast<int>(sensor.awaitMeasurement(data)));
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, expected[i][0], data.temperatureCelsius());
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, expected[i][1], data.humidityPercent());
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, s_sht31.measurementsStarted());
+}
+
+void test_sim_sync_trigger_and_read() {
+    s_sht31.setConditions(18.0f, 45.0f);
+    
+    SHT31Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    
+    SensorData data;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.triggerMeasurement()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.read(data)));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 18.0f, data.temperatureCelsius());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 45.0f, data.humidityPercent());
+}
+
+void test_sim_crc_error_detected() {
+    SHT31Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    
+    s_sht31.corruptNextCrc();
+    SensorData data;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK),
+                      static_cast<int>(sensor.triggerMeasurementAsync()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::ERROR_CRC),
+                      static_cast<int>(sensor.awaitMeasurement(data)));
+}
+
+void test_sim_clock_profile_shrinks_bus_time() {
+    SHT31Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    I2CDriver& driver = I2CDriver::getInstance();
+    SensorData data;
+    
+    driver.setDeviceSpeed(0x44, I2CSpeed::STANDARD);
+    driver.resetStats();
+    sensor.triggerMeasurementAsync();
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.awaitMeasurement(data)));
+    uint32_t standard_us = driver.getStats().bus_busy_us;
+    
+    driver.setDeviceSpeed(0x44, I2CSpeed::FAST_PLUS);
+    driver.resetStats();
+    sensor.triggerMeasurementAsync();
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.awaitMeasurement(data)));
+    uint32_t fast_plus_us = driver.getStats().bus_busy_us;
+    
+    char msg[96];
+    snprintf(msg, sizeof(msg), "Acquisition bus time: 100 kHz %u us, 800 kHz %u us",
+             (unsigned)standard_us, (unsigned)fast_plus_us);
+    TEST_MESSAGE(msg);
+    
+    // 2-byte command + 6-byte fetch (+ NACKed polls): ~1 ms at 100 kHz, ~0.15 ms at 800 kHz
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(SimI2CBus::transferTimeUs(2, 0, 100000) +
+                                        SimI2CBus::transferTimeUs(0, 6, 100000), standard_us);
+    TEST_ASSERT_LESS_THAN_UINT32(standard_us / 3, fast_plus_us);
+}
+
+void test_sim_speed_fallback_when_device_too_slow() {
+    s_sht31.setMaxClockHz(400000);  // Long cable: Fast-mode only
+    
+    SHT31Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    
+    SensorData data;
+    sensor.triggerMeasurementAsync();
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.awaitMeasurement(data)));
+    
+    I2CDriver& driver = I2CDriver::getInstance();
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CSpeed::FAST), static_cast<int>(driver.getDeviceSpeed(0x44)));
+    TEST_ASSERT_EQUAL_UINT32(1, driver.getStats().speed_fallbacks);
+}
+
+void test_sim_stuck_bus_recovered_transparently() {
+    SHT31Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    
+    s_bus.setSdaStuck(true);
+    int64_t start_us = esp_timer_get_time();
+    SensorData data;
+    sensor.triggerMeasurementAsync();
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.awaitMeasurement(data)));
+    uint32_t elapsed_ms = static_cast<uint32_t>((esp_timer_get_time() - start_us) / 1000);
+    
+    TEST_ASSERT_EQUAL_UINT32(1, I2CDriver::getInstance().getStats().bus_recoveries);
+    TEST_ASSERT_LESS_THAN_UINT32(50, elapsed_ms);  // Conversion time + a few ms, not seconds
+}
+
+static I2CStatus s_batch_status;
+
+static void onBatchDone(I2CStatus status, void* context) {
+    s_batch_status = status;
+}
+
+void test_sim_batch_failure_aborts_later_steps() {
+    s_bus.attach(&s_aht20);
+    I2CDriver& driver = I2CDriver::getInstance();
+    
+    // SHT31 command, a write to an absent device, then reads from both sensors
+    static const uint8_t SHT31_CMD[2] = {0x24, 0x00};
+    static const uint8_t AHT20_STATUS = 0x71;
+    uint8_t sht31_buf[6] = {0};
+    uint8_t aht20_status = 0;
+    I2COp ops[4] = {
+        I2COp::write(0x44, SHT31_CMD, 2),
+        I2COp::write(0x45, SHT31_CMD, 2),
+        I2COp::writeRead(0x38, &AHT20_STATUS, 1, &aht20_status, 1),
+        I2COp::read(0x44, sht31_buf, 6),
+    };
+    uint32_t transfers_before = s_bus.transferCount();
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::ERROR_NACK_ADDR),
+                      static_cast<int>(driver.executeBatch(ops, 4)));
+    
+    // The step before the failure keeps its result; nothing after it touches the bus
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(ops[0].result));
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::ERROR_NACK_ADDR), static_cast<int>(ops[1].result));
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::ERROR_ABORTED), static_cast<int>(ops[2].result));
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::ERROR_ABORTED), static_cast<int>(ops[3].result));
+    TEST_ASSERT_EQUAL_UINT32(transfers_before + 2, s_bus.transferCount());
+    TEST_ASSERT_EQUAL_UINT32(1, s_sht31.measurementsStarted());
+    
+    // Queued (the SHT31 is converting now): the callback reports the first
+    // failure, results are written back
+    ops[0] = I2COp::write(0x38, &AHT20_STATUS, 1);
+    ops[1] = I2COp::writeRead(0x38, &AHT20_STATUS, 1, &aht20_status, 1);
+    ops[2] = I2COp::read(0x46, &aht20_status, 1);
+    ops[3] = I2COp::delayUntil(0);
+    s_batch_status = I2CStatus::OK;
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK),
+                      static_cast<int>(driver.submitBatch(ops, 4, onBatchDone, nullptr)));
+    TEST_ASSERT_TRUE(driver.waitIdle(100));
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::ERROR_NACK_ADDR), static_cast<int>(s_batch_status));
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(ops[0].result));
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(ops[1].result));
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::ERROR_NACK_ADDR), static_cast<int>(ops[2].result));
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::ERROR_ABORTED), static_cast<int>(ops[3].result));
+}
+
+void test_sim_batch_delay_until_offsets_from_batch_start() {
+    I2CDriver& driver = I2CDriver::getInstance();
+    static const uint8_t SHT31_CMD[2] = {0x24, 0x00};
+    
+    // Offsets are absolute within the batch: the 3 ms step is already past
+    // when the 5 ms step returns, so it does not add to the batch
+    I2COp ops[4] = {
+        I2COp::write(0x44, SHT31_CMD, 2),
+        I2COp::delayUntil(5000),
+        I2COp::delayUntil(3000),
+        I2COp::delayUntil(6000),
+    };
+    int64_t start_us = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(driver.executeBatch(ops, 4)));
+    uint32_t batch_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+    
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(ops[i].result));
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(6000, batch_us);
+    TEST_ASSERT_LESS_THAN_UINT32(7500, batch_us);     // Not 5 + 3 + 6 ms
+}
+
+void test_sim_topology_cache_skips_probe_on_warm_wake() {
+    // Cold boot: full discovery with a soft reset
+    {
+        SHT31Sensor sensor;
+        TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, s_sht31.softResets());
+    
+    // Deep-sleep wake: cached address, no bus traffic during init
+    startDriver(ESP_RST_DEEPSLEEP);
+    uint32_t transfers_before = s_bus.transferCount();
+    {
+        SHT31Sensor sensor;
+        TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    }
+    TEST_ASSERT_EQUAL_UINT32(transfers_before, s_bus.transferCount());
+    TEST_ASSERT_EQUAL_UINT32(1, s_sht31.softResets());
+    
+    // Power-on reset: cache discarded, discovery again
+    startDriver(ESP_RST_POWERON);
+    {
+        SHT31Sensor sensor;
+        TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, s_sht31.softResets());
+}
+
+void test_sim_periodic_streams_without_conversion_wait() {
+    TEST_ASSERT_TRUE(s_sht31.loadTraceCsvString(TRACE_CSV));
+    SHT31Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK),
+                      static_cast<int>(sensor.startPeriodic(PeriodicRate::MPS_10)));
+    TEST_ASSERT_TRUE(sensor.isPeriodic());
+    TEST_ASSERT_TRUE(s_sht31.periodicActive());
+    
+    // Before the first conversion completes: nothing new and no bus traffic
+    SensorData data;
+    uint32_t transfers_before = s_bus.transferCount();
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::ERROR_NOT_READY),
+                      static_cast<int>(sensor.readLatest(data)));
+    TEST_ASSERT_EQUAL_UINT32(transfers_before, s_bus.transferCount());
+    
+    // Poll for 340 ms: samples at ~15, 115, 215 and 315 ms
+    const float expected_t[3] = {22.50f, 22.75f, 23.10f};
+    uint32_t samples = 0;
+    uint32_t slowest_us = 0;
+    int64_t start_us = esp_timer_get_time();
+    while (esp_timer_get_time() - start_us < 340000) {
+        int64_t call_us = esp_timer_get_time();
+        SensorStatus status = sensor.readLatest(data);
+        uint32_t took_us = static_cast<uint32_t>(esp_timer_get_time() - call_us);
+        if (took_us > slowest_us) slowest_us = took_us;
+        
+        if (status == SensorStatus::OK) {
+            TEST_ASSERT_FLOAT_WITHIN(0.01f, expected_t[samples % 3], data.temperatureCelsius());
+            samples++;
+        } else {
+            TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::ERROR_NOT_READY), static_cast<int>(status));
+        }
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+    
+    char msg[80];
+    snprintf(msg, sizeof(msg), "10 mps: %u samples in 340 ms, slowest readLatest %u us",
+             (unsigned)samples, (unsigned)slowest_us);
+    TEST_MESSAGE(msg);
+    
+    TEST_ASSERT_EQUAL_UINT32(4, samples);
+    TEST_ASSERT_EQUAL_UINT32(4, s_sht31.measurementsStarted());
+    TEST_ASSERT_LESS_THAN_UINT32(3000, slowest_us);  // A fetch, never a 15 ms conversion
+    TEST_ASSERT_EQUAL_UINT32(0, I2CDriver::getInstance().getStats().speed_fallbacks);
+}
+
+void test_sim_periodic_early_fetch_keeps_clock_profile() {
+    SHT31Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    I2CDriver& driver = I2CDriver::getInstance();
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CSpeed::FAST_PLUS), static_cast<int>(driver.getDeviceSpeed(0x44)));
+    
+    // Sensor clock 3% slow: every fetch on the nominal schedule is early and
+    // NACKed until the sample lands, often between two back-to-back attempts
+    s_sht31.setPeriodicLagUs(3000);
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK),
+                      static_cast<int>(sensor.startPeriodic(PeriodicRate::MPS_10)));
+    
+    SensorData data;
+    uint32_t samples = 0;
+    uint32_t early = 0;
+    int64_t start_us = esp_timer_get_time();
+    while (esp_timer_get_time() - start_us < 340000) {
+        uint32_t transfers_before = s_bus.transferCount();
+        SensorStatus status = sensor.readLatest(data);
+        if (status == SensorStatus::OK) {
+            samples++;
+        } else {
+            TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::ERROR_NOT_READY), static_cast<int>(status));
+            if (s_bus.transferCount() != transfers_before) early++;
+        }
+    }
+    
+    TEST_ASSERT_EQUAL_UINT32(4, samples);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, early);
+    TEST_ASSERT_EQUAL_UINT32(0, driver.getStats().speed_fallbacks);
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CSpeed::FAST_PLUS), static_cast<int>(driver.getDeviceSpeed(0x44)));
+}
+
+void test_sim_periodic_blocks_single_shot_until_break() {
+    SHT31Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK),
+                      static_cast<int>(sensor.startPeriodic(PeriodicRate::ART)));
+    
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::ERROR_NOT_READY),
+                      static_cast<int>(sensor.triggerMeasurement()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::ERROR_NOT_READY),
+                      static_cast<int>(sensor.triggerMeasurementAsync()));
+    
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.stopPeriodic()));
+    TEST_ASSERT_FALSE(sensor.isPeriodic());
+    TEST_ASSERT_FALSE(s_sht31.periodicActive());
+    
+    // Back in single-shot mode; readLatest falls back to a full measurement
+    SensorData data;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.readLatest(data)));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 25.0f, data.temperatureCelsius());
+}
+
+void test_sim_poll_ready_tracks_real_conversion_time() {
+    SHT31Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    SensorData data;
+    
+    // Default: no-stretch command, NACK polling from just before the typical time
+    int64_t start_us = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.triggerMeasurement()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.read(data)));
+    uint32_t polled_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+    TEST_ASSERT_FALSE(s_sht31.lastCommandStretched());
+    TEST_ASSERT_GREATER_THAN_UINT32(0, s_sht31.notReadyNacks());
+    
+    // Clock stretching: fixed worst-case wait
+    SensorConfig config;
+    config.poll_ready = false;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.configure(config)));
+    start_us = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.triggerMeasurement()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.read(data)));
+    uint32_t fixed_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+    TEST_ASSERT_TRUE(s_sht31.lastCommandStretched());
+    
+    char msg[80];
+    snprintf(msg, sizeof(msg), "High repeatability read: polled %u us, fixed wait %u us",
+             (unsigned)polled_us, (unsigned)fixed_us);
+    TEST_MESSAGE(msg);
+    
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(12500, polled_us);
+    TEST_ASSERT_LESS_THAN_UINT32(14000, polled_us);   // Typical 12.5 ms + one poll interval
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(15000, fixed_us);
+    TEST_ASSERT_LESS_THAN_UINT32(16000, fixed_us);    // No tick rounding on top of 15 ms
+}
+
+void test_sim_async_poll_nacks_do_not_degrade_bus() {
+    SHT31Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    
+    SensorConfig config;
+    config.precision = 0;  // Low repeatability: 2.5 ms typical, 4 ms budget
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.configure(config)));
+    
+    SensorData data;
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK),
+                          static_cast<int>(sensor.triggerMeasurementAsync()));
+        TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK),
+                          static_cast<int>(sensor.awaitMeasurement(data)));
+    }
+    
+    // Not-ready NACKs are expected: no recovery, no clock step-down
+    I2CDriverStats stats = I2CDriver::getInstance().getStats();
+    TEST_ASSERT_GREATER_THAN_UINT32(0, s_sht31.notReadyNacks());
+    TEST_ASSERT_EQUAL_UINT32(0, stats.speed_fallbacks);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.bus_recoveries);
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CSpeed::FAST_PLUS),
+                      static_cast<int>(I2CDriver::getInstance().getDeviceSpeed(0x44)));
+}
+
+void test_sim_burst_masks_crc_error_and_spike() {
+    TEST_ASSERT_TRUE(s_sht31.loadTraceCsvString(
+        "temperature_c,humidity_pct\n"
+        "22.40,61.0\n"
+        "22.50,61.0\n"
+        "40.00,20.0\n"
+        "22.60,61.2\n"
+        "22.50,61.0\n"));
+    
+    SHT31Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.configure(SensorConfig())));
+    
+    s_sht31.corruptNextCrc();
+    BurstResult burst;
+    int64_t start_us = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.readBurst(burst)));
+    uint32_t burst_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+    
+    char msg[80];
+    snprintf(msg, sizeof(msg), "Burst of 5 low-repeatability samples: %u us", (unsigned)burst_us);
+    TEST_MESSAGE(msg);
+    
+    // Sample 0 failed its CRC; the spike is outvoted by the median
+    TEST_ASSERT_EQUAL_UINT32(5, s_sht31.measurementsStarted());
+    TEST_ASSERT_EQUAL_UINT8(4, burst.valid);
+    TEST_ASSERT_EQUAL_HEX16(0x001E, burst.sample_mask);
+    TEST_ASSERT_INT_WITHIN(2, 2255, burst.data.temperature_centi_c);
+    TEST_ASSERT_INT_WITHIN(2, 6100, burst.data.humidity_centi_pct);
+    TEST_ASSERT_FALSE(s_sht31.lastCommandStretched());
+    TEST_ASSERT_LESS_THAN_UINT32(30000, burst_us);   // 5 x 2.5 ms typical, not 5 x 12.5 ms
+}
+
+void test_sim_alert_limits_track_out_of_range_climate() {
+    s_sht31.setConditions(22.0f, 65.0f);
+    SHT31Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    
+    SensorAlertLimits limits = {1500, 3000, 4000, 8000, 50, 200};
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.armAlert(limits)));
+    TEST_ASSERT_TRUE(s_sht31.periodicActive());
+    TEST_ASSERT_EQUAL_HEX16(0xCCDB, s_sht31.alertLimit(0));   // 30.00 °C / 80.00 %RH
+    vTaskDelay(pdMS_TO_TICKS(5));                              // First low-repeatability sample
+    
+    TEST_ASSERT_FALSE(s_sht31.alertActive());
+    s_sht31.setConditions(31.0f, 65.0f);
+    TEST_ASSERT_TRUE(s_sht31.alertActive());
+    s_sht31.setConditions(29.8f, 65.0f);
+    TEST_ASSERT_TRUE(s_sht31.alertActive());     // Releases only below 29.50 °C
+    s_sht31.setConditions(22.0f, 35.0f);
+    TEST_ASSERT_TRUE(s_sht31.alertActive());     // Too dry
+    s_sht31.setConditions(22.0f, 65.0f);
+    TEST_ASSERT_FALSE(s_sht31.alertActive());
+    
+    // Single-shot commands wait until monitoring ends
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::ERROR_NOT_READY),
+                      static_cast<int>(sensor.triggerMeasurement()));
+    
+    // Wake from deep sleep: the new instance breaks out of periodic mode first
+    startDriver(ESP_RST_DEEPSLEEP);
+    SHT31Sensor woken;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(woken.init()));
+    TEST_ASSERT_FALSE(s_sht31.periodicActive());
+    
+    SensorData data;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(woken.triggerMeasurement()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(woken.read(data)));
+    TEST_ASSERT_INT_WITHIN(2, 2200, data.temperature_centi_c);
+}
+
+void test_sim_aht20_calibrates_and_reads() {
+    s_bus.attach(&s_aht20);
+    s_aht20.setCalibrated(false);
+    s_aht20.setConditions(23.4f, 55.5f);
+    
+    AHT20Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    TEST_ASSERT_EQUAL_UINT32(1, s_aht20.calibrationCommands());
+    TEST_ASSERT_TRUE(s_aht20.isCalibrated());
+    
+    SensorData data;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.triggerMeasurement()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.read(data)));
+    TEST_ASSERT_INT_WITHIN(2, 2340, data.temperature_centi_c);
+    TEST_ASSERT_INT_WITHIN(2, 5550, data.humidity_centi_pct);
+    TEST_ASSERT_TRUE(data.isValid());
+    
+    // Warm wake: the cached topology skips the status check and calibration
+    startDriver(ESP_RST_DEEPSLEEP);
+    AHT20Sensor woken;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(woken.init()));
+    TEST_ASSERT_EQUAL_UINT32(1, s_aht20.calibrationCommands());
+}
+
+void test_sim_group_overlaps_conversions() {
+    s_bus.attach(&s_aht20);
+    s_sht31.setConditions(22.00f, 60.00f);
+    s_aht20.setConditions(22.40f, 62.00f);
+    
+    SHT31Sensor sht31;
+    AHT20Sensor aht20;
+    SensorConfig config;
+    config.precision = 2;
+    
+    // Sequential reference: one sensor after the other
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sht31.init()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(aht20.init()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sht31.configure(config)));
+    SensorData data;
+    int64_t start_us = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sht31.triggerMeasurement()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sht31.read(data)));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(aht20.triggerMeasurement()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(aht20.read(data)));
+    uint32_t sequential_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+    
+    // Group: both conversions run at the same time
+    SensorGroup group;
+    TEST_ASSERT_TRUE(group.add(&sht31));
+    TEST_ASSERT_TRUE(group.add(&aht20));
+    TEST_ASSERT_FALSE(group.add(&sht31));   // Duplicate
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.init()));
+    TEST_ASSERT_EQUAL_HEX8(0x03, group.activeMask());
+    
+    start_us = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.triggerMeasurement()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.read(data)));
+    uint32_t group_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+    
+    char msg[96];
+    snprintf(msg, sizeof(msg), "SHT31 + AHT20: sequential %u us, grouped %u us",
+             (unsigned)sequential_us, (unsigned)group_us);
+    TEST_MESSAGE(msg);
+    
+    TEST_ASSERT_EQUAL_HEX8(0x03, group.validMask());
+    TEST_ASSERT_INT_WITHIN(2, 2220, data.temperature_centi_c);   // Median of two = mean
+    TEST_ASSERT_INT_WITHIN(2, 6100, data.humidity_centi_pct);
+    TEST_ASSERT_INT_WITHIN(2, 2200, group.memberData(0).temperature_centi_c);
+    TEST_ASSERT_INT_WITHIN(2, 2240, group.memberData(1).temperature_centi_c);
+    
+    // Wake time follows the slowest sensor (AHT20, 80 ms), not the sum
+    TEST_ASSERT_LESS_THAN_UINT32(sequential_us - 8000, group_us);
+    TEST_ASSERT_LESS_THAN_UINT32(90000, group_us);
+    
+    // Merged metadata: intersection of the ranges, worst accuracy, summed current
+    const SensorInfo& info = group.getInfo();
+    TEST_ASSERT_EQUAL_INT16(-4000, info.temp_min_centi_c);
+    TEST_ASSERT_EQUAL_INT16(8500, info.temp_max_centi_c);
+    TEST_ASSERT_EQUAL_UINT16(80, info.measurement_time_ms);
+    TEST_ASSERT_EQUAL_UINT16(100, info.startup_time_ms);
+    TEST_ASSERT_EQUAL_UINT16(200 + 250, info.power_sleep_na);
+    
+    // A scheduler selects only the due members: the SHT31 stays idle
+    group.select(0x02);
+    uint32_t sht31_measurements = s_sht31.measurementsStarted();
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.triggerMeasurement()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.read(data)));
+    TEST_ASSERT_EQUAL_HEX8(0x02, group.validMask());
+    TEST_ASSERT_EQUAL_UINT32(sht31_measurements, s_sht31.measurementsStarted());
+    TEST_ASSERT_INT_WITHIN(2, 2240, data.temperature_centi_c);
+}
+
+void test_sim_group_masks_failing_member() {
+    s_bus.attach(&s_aht20);
+    s_sht31.setConditions(21.00f, 58.00f);
+    s_aht20.setConditions(21.20f, 58.40f);
+    
+    SHT31Sensor sht31;
+    AHT20Sensor aht20;
+    SensorGroup group;
+    TEST_ASSERT_TRUE(group.add(&sht31));
+    TEST_ASSERT_TRUE(group.add(&aht20));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.init()));
+    
+    // CRC error on the AHT20: the SHT31 alone carries the reading
+    s_aht20.corruptNextCrc();
+    SensorData data;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.triggerMeasurement()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.read(data)));
+    TEST_ASSERT_EQUAL_HEX8(0x01, group.validMask());
+    TEST_ASSERT_INT_WITHIN(2, 2100, data.temperature_centi_c);
+    
+    // The AHT20 drops off the bus: bursts keep going on the SHT31
+    s_aht20.setAbsent(true);
+    BurstResult burst;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.readBurst(burst)));
+    TEST_ASSERT_EQUAL_HEX8(0x01, group.validMask());
+    TEST_ASSERT_EQUAL_UINT8(5, burst.valid);
+    TEST_ASSERT_INT_WITHIN(2, 2100, burst.data.temperature_centi_c);
+    TEST_ASSERT_INT_WITHIN(2, 5800, burst.data.humidity_centi_pct);
+    TEST_ASSERT_EQUAL_UINT32(5, s_sht31.measurementsAt(0));   // Burst precision (low), not high
+    
+    // Single-shot reads return to the member's own precision
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.triggerMeasurement()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.read(data)));
+    TEST_ASSERT_EQUAL_UINT8(2, s_sht31.lastRepeatability());
+    
+    // Both gone: the group reports the failure
+    s_bus.detachAll();
+    TEST_ASSERT_NOT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.triggerMeasurement()));
+}
+
+void test_sim_adaptive_precision_follows_noise_and_limits() {
+    s_sht31.setConditions(22.0f, 62.0f);
+    s_sht31.setNoise(1.0f);
+    
+    SHT31Sensor sensor;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.init()));
+    SensorConfig config;
+    config.adaptive_precision = true;
+    config.precision_window = {1600, 2900, 4500, 7500, 0, 0};   // Basil critical limits less a margin
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.configure(config)));
+    
+    // Quiet room: high, medium, then low repeatability from the third wake on
+    const uint8_t expected[] = {2, 1, 0, 0, 0};
+    uint32_t burst_us[5];
+    BurstResult burst;
+    for (uint8_t wake = 0; wake < 5; wake++) {
+        int64_t start_us = esp_timer_get_time();
+        TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.readBurst(burst)));
+        burst_us[wake] = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+        TEST_ASSERT_EQUAL_UINT8(expected[wake], s_sht31.lastRepeatability());
+        TEST_ASSERT_INT_WITHIN(10, 2200, burst.data.temperature_centi_c);
+    }
+    
+    char msg[96];
+    snprintf(msg, sizeof(msg), "Burst of 5: high repeatability %u us, adaptive (low) %u us",
+             (unsigned)burst_us[0], (unsigned)burst_us[4]);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_THAN_UINT32(burst_us[0] / 3, burst_us[4]);
+    
+    // Approaching the 30 °C critical limit: the burst after the first warm reading runs high
+    s_sht31.setConditions(29.5f, 62.0f);
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.readBurst(burst)));
+    TEST_ASSERT_EQUAL_UINT8(0, s_sht31.lastRepeatability());
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.readBurst(burst)));
+    TEST_ASSERT_EQUAL_UINT8(2, s_sht31.lastRepeatability());
+    
+    // Back to normal, but turbulent air: low repeatability cannot meet the target
+    s_sht31.setConditions(22.0f, 62.0f);
+    s_sht31.setNoise(1.0f, 0.15f);
+    for (uint8_t wake = 0; wake < 6; wake++) {
+        TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.readBurst(burst)));
+    }
+    TEST_ASSERT_EQUAL_UINT8(2, s_sht31.lastRepeatability());
+    
+    // Quiet again, sampled through a group: the member's selector still steps down
+    s_sht31.setNoise(1.0f);
+    SensorGroup group;
+    TEST_ASSERT_TRUE(group.add(&sensor));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.init()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.configure(config)));
+    for (uint8_t wake = 0; wake < 12; wake++) {
+        TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(group.readBurst(burst)));
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, s_sht31.lastRepeatability());
+}
+
+// =======================================================================================
+// TEST RUNNER
+// =======================================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    
+    RUN_TEST(test_sim_async_acquisition_replays_trace);
+    RUN_TEST(test_sim_sync_trigger_and_read);
+    RUN_TEST(test_sim_crc_error_detected);
+    RUN_TEST(test_sim_clock_profile_shrinks_bus_time);
+    RUN_TEST(test_sim_speed_fallback_when_device_too_slow);
+    RUN_TEST(test_sim_stuck_bus_recovered_transparently);
+    RUN_TEST(test_sim_batch_failure_aborts_later_steps);
+    RUN_TEST(test_sim_batch_delay_until_offsets_from_batch_start);
+    RUN_TEST(test_sim_topology_cache_skips_probe_on_warm_wake);
+    RUN_TEST(test_sim_periodic_streams_without_conversion_wait);
+    RUN_TEST(test_sim_periodic_early_fetch_keeps_clock_profile);
+    RUN_TEST(test_sim_periodic_blocks_single_shot_until_break);
+    RUN_TEST(test_sim_poll_ready_tracks_real_conversion_time);
+    RUN_TEST(test_sim_async_poll_nacks_do_not_degrade_bus);
+    RUN_TEST(test_sim_burst_masks_crc_error_and_spike);
+    RUN_TEST(test_sim_alert_limits_track_out_of_range_climate);
+    RUN_TEST(test_sim_aht20_calibrates_and_reads);
+    RUN_TEST(test_sim_group_overlaps_conversions);
+    RUN_TEST(test_sim_group_masks_failing_member);
+    RUN_TEST(test_sim_adaptive_precision_follows_noise_and_limits);
+    
+    return UNITY_END();
+}
@@ -0,0 +1,166 @@
+/**
+ * @file test_i2c_stats.cpp
+ * @brief Native Unit Tests for the per-address I2C statistics table
+ *
+ * I2CStats.hpp is header-only and free of ESP-IDF dependencies, so these
+ * tests exercise the same code that runs in the firmware.
+ *
+ * Test Coverage:
+ * - Count, bytes and min/avg/max latency per address
+ * - log2 latency histogram bucketing
+ * - NACK, timeout and retry counters
+ * - Fixed-size table overflow (dropped records)
+ * - Concurrent recording from several threads (lock-free totals)
+ * - Bus utilisation and reset
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#include <unity.h>
+#include <thread>
+#include <vector>
+#include "I2CStats.hpp"
+
+static I2CStats s_stats;
+
+// =======================================================================================
+// TEST SETUP & TEARDOWN
+// =======================================================================================
+
+void setUp(void) {
+    s_stats.reset();
+}
+
+void tearDown(void) {}
+
+// =======================================================================================
+// TESTS
+// =======================================================================================
+
+void test_stats_latency_min_avg_max() {
+    s_stats.record(0x44, 100, 2, I2CStatsOutcome::OK);
+    s_stats.record(0x44, 300, 6, I2CStatsOutcome::OK);
+    s_stats.record(0x44, 200, 6, I2CStatsOutcome::OK);
+    
+    I2CDeviceStatsSnapshot snap;
+    TEST_ASSERT_TRUE(s_stats.snapshot(0x44, snap));
+    TEST_ASSERT_EQUAL_UINT32(3, snap.transactions);
+    TEST_ASSERT_EQUAL_UINT32(14, snap.bytes);
+    TEST_ASSERT_EQUAL_UINT32(100, snap.min_us);
+    TEST_ASSERT_EQUAL_UINT32(200, snap.avgUs());
+    TEST_ASSERT_EQUAL_UINT32(300, snap.max_us);
+}
+
+void test_stats_histogram_buckets() {
+    TEST_ASSERT_EQUAL_UINT8(0, I2CStats::bucketFor(0));
+    TEST_ASSERT_EQUAL_UINT8(0, I2CStats::bucketFor(1));
+    TEST_ASSERT_EQUAL_UINT8(1, I2CStats::bucketFor(2));
+    TEST_ASSERT_EQUAL_UINT8(9, I2CStats::bucketFor(1000));
+    TEST_ASSERT_EQUAL_UINT8(I2C_STATS_HISTOGRAM_BUCKETS - 1, I2CStats::bucketFor(UINT32_MAX));
+    
+    s_stats.record(0x44, 600, 6, I2CStatsOutcome::OK);   // bucket 9
+    s_stats.record(0x44, 1000, 6, I2CStatsOutcome::OK);  // bucket 9
+    s_stats.record(0x44, 70, 2, I2CStatsOutcome::OK);    // bucket 6
+    
+    I2CDeviceStatsSnapshot snap;
+    TEST_ASSERT_TRUE(s_stats.snapshot(0x44, snap));
+    TEST_ASSERT_EQUAL_UINT32(2, snap.histogram[9]);
+    TEST_ASSERT_EQUAL_UINT32(1, snap.histogram[6]);
+}
+
+void test_stats_error_and_retry_counters() {
+    s_stats.record(0x45, 50, 2, I2CStatsOutcome::NACK);
+    s_stats.record(0x45, 100000, 6, I2CStatsOutcome::TIMEOUT);
+    s_stats.recordRetry(0x45);
+    s_stats.record(0x45, 250, 6, I2CStatsOutcome::OK);
+    
+    I2CDeviceStatsSnapshot snap;
+    TEST_ASSERT_TRUE(s_stats.snapshot(0x45, snap));
+    TEST_ASSERT_EQUAL_UINT32(3, snap.transactions);
+    TEST_ASSERT_EQUAL_UINT32(6, snap.bytes);  // Failed transfers move no payload
+    TEST_ASSERT_EQUAL_UINT32(1, snap.nacks);
+    TEST_ASSERT_EQUAL_UINT32(1, snap.timeouts);
+    TEST_ASSERT_EQUAL_UINT32(1, snap.retries);
+}
+
+void test_stats_table_overflow_drops_records() {
+    for (uint8_t addr = 1; addr <= I2C_STATS_MAX_DEVICES; addr++) {
+        s_stats.record(addr, 10, 1, I2CStatsOutcome::OK);
+    }
+    s_stats.record(0x70, 10, 1, I2CStatsOutcome::OK);
+    s_stats.record(0, 10, 1, I2CStatsOutcome::OK);  // Address 0 is never tracked
+    
+    I2CDeviceStatsSnapshot snap;
+    TEST_ASSERT_EQUAL_UINT8(I2C_STATS_MAX_DEVICES, s_stats.deviceCount());
+    TEST_ASSERT_FALSE(s_stats.snapshot(0x70, snap));
+    TEST_ASSERT_EQUAL_UINT32(2, s_stats.droppedRecords());
+    TEST_ASSERT_TRUE(s_stats.snapshotAt(I2C_STATS_MAX_DEVICES - 1, snap));
+    TEST_ASSERT_FALSE(s_stats.snapshotAt(I2C_STATS_MAX_DEVICES, snap));
+}
+
+void test_stats_concurrent_recording() {
+    const int THREADS = 4;
+    const int RECORDS = 10000;
+    
+    std::vector<std::thread> workers;
+    for (int t = 0; t < THREADS; t++) {
+        workers.emplace_back([t]() {
+            // Every thread touches the shared address and one of its own
+            for (int i = 0; i < RECORDS; i++) {
+                s_stats.record(0x44, 1 + (i % 500), 6, I2CStatsOutcome::OK);
+                s_stats.record(static_cast<uint8_t>(0x10 + t), 5, 1, I2CStatsOutcome::NACK);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    
+    I2CDeviceStatsSnapshot snap;
+    TEST_ASSERT_TRUE(s_stats.snapshot(0x44, snap));
+    TEST_ASSERT_EQUAL_UINT32(THREADS * RECORDS, snap.transactions);
+    TEST_ASSERT_EQUAL_UINT32(THREADS * RECORDS * 6, snap.bytes);
+    TEST_ASSERT_EQUAL_UINT32(1, snap.min_us);
+    TEST_ASSERT_EQUAL_UINT32(500, snap.max_us);
+    
+    uint32_t histogram_total = 0;
+    for (uint8_t b = 0; b < I2C_STATS_HISTOGRAM_BUCKETS; b++) {
+        histogram_total += snap.histogram[b];
+    }
+    TEST_ASSERT_EQUAL_UINT32(snap.transactions, histogram_total);
+    TEST_ASSERT_EQUAL_UINT8(1 + THREADS, s_stats.deviceCount());
+    TEST_ASSERT_EQUAL_UINT32(0, s_stats.droppedRecords());
+}
+
+void test_stats_utilisation_and_reset() {
+    s_stats.record(0x44, 2000, 6, I2CStatsOutcome::OK);
+    s_stats.record(0x45, 3000, 6, I2CStatsOutcome::OK);
+    
+    TEST_ASSERT_EQUAL_UINT32(5000, s_stats.busBusyUs());
+    TEST_ASSERT_EQUAL_UINT32(50, s_stats.utilisationPermille(100000));  // 5 ms of 100 ms
+    TEST_ASSERT_EQUAL_UINT32(0, s_stats.utilisationPermille(0));
+    
+    s_stats.reset();
+    I2CDeviceStatsSnapshot snap;
+    TEST_ASSERT_EQUAL_UINT8(0, s_stats.deviceCount());
+    TEST_ASSERT_FALSE(s_stats.snapshot(0x44, snap));
+    TEST_ASSERT_EQUAL_UINT32(0, s_stats.busBusyUs());
+}
+
+// =======================================================================================
+// TEST RUNNER
+// =======================================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    
+    RUN_TEST(test_stats_latency_min_avg_max);
+    RUN_TEST(test_stats_histogram_buckets);
+    RUN_TEST(test_stats_error_and_retry_counters);
+    RUN_TEST(test_stats_table_overflow_drops_records);
+    RUN_TEST(test_stats_concurrent_recording);
+    RUN_TEST(test_stats_utilisation_and_reset);
+    
+    return UNITY_END();
+}
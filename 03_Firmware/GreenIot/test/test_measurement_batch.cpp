@@ -0,0 +1,154 @@
+/**
+ * @file test_measurement_batch.cpp
+ * @brief Native Unit Tests for the RTC measurement batch
+ *
+ * Test Coverage:
+ * - Samples kept in order with their times (delta encoded)
+ * - Full ring drops the oldest sample and keeps the times right
+ * - Corrupt or foreign RTC contents are discarded, a valid batch is resumed
+ * - Batch payload bytes; partial consume after a publication
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#include <unity.h>
+#include <cstring>
+#include "MeasurementBatch.hpp"
+
+static MeasurementBatchState s_state;
+
+static SensorData reading(int16_t temp_centi_c, uint16_t hum_centi_pct) {
+    SensorData data = {};
+    data.temperature_centi_c = temp_centi_c;
+    data.humidity_centi_pct = hum_centi_pct;
+    data.quality_flags = 0xC0;
+    return data;
+}
+
+// =======================================================================================
+// TEST SETUP & TEARDOWN
+// =======================================================================================
+
+void setUp(void) {
+    memset(&s_state, 0, sizeof(s_state));  // Cold boot
+}
+
+void tearDown(void) {}
+
+// =======================================================================================
+// TESTS
+// =======================================================================================
+
+void test_samples_kept_in_order_with_times() {
+    MeasurementBatch batch(s_state);
+    TEST_ASSERT_FALSE(batch.restore());   // Nothing kept at cold boot
+    TEST_ASSERT_EQUAL_UINT8(0, batch.size());
+    
+    batch.push(1000, reading(2250, 6100));
+    batch.push(1060, reading(2260, 6050));
+    batch.push(1125, reading(-150, 9000));
+    TEST_ASSERT_EQUAL_UINT8(3, batch.size());
+    
+    uint32_t time_s = 0;
+    SensorData data;
+    TEST_ASSERT_TRUE(batch.sample(0, time_s, data));
+    TEST_ASSERT_EQUAL_UINT32(1000, time_s);
+    TEST_ASSERT_EQUAL_INT16(2250, data.temperature_centi_c);
+    TEST_ASSERT_TRUE(batch.sample(2, time_s, data));
+    TEST_ASSERT_EQUAL_UINT32(1125, time_s);
+    TEST_ASSERT_EQUAL_INT16(-150, data.temperature_centi_c);
+    TEST_ASSERT_EQUAL_UINT16(9000, data.humidity_centi_pct);
+    TEST_ASSERT_TRUE(data.isValid());
+    TEST_ASSERT_FALSE(batch.sample(3, time_s, data));
+    
+    // Three 16-bit words per sample
+    TEST_ASSERT_EQUAL(6, sizeof(BatchSample));
+}
+
+void test_full_ring_drops_oldest() {
+    MeasurementBatch batch(s_state);
+    batch.restore();
+    for (uint32_t i = 0; i < MEASUREMENT_BATCH_CAPACITY + 3; i++) {
+        batch.push(100 + i * 60, reading(static_cast<int16_t>(i), 5000));
+    }
+    
+    TEST_ASSERT_TRUE(batch.full());
+    TEST_ASSERT_EQUAL_UINT16(3, batch.dropped());
+    
+    uint32_t time_s = 0;
+    SensorData data;
+    TEST_ASSERT_TRUE(batch.sample(0, time_s, data));
+    TEST_ASSERT_EQUAL_INT16(3, data.temperature_centi_c);
+    TEST_ASSERT_EQUAL_UINT32(100 + 3 * 60, time_s);
+    TEST_ASSERT_TRUE(batch.sample(MEASUREMENT_BATCH_CAPACITY - 1, time_s, data));
+    TEST_ASSERT_EQUAL_INT16(MEASUREMENT_BATCH_CAPACITY + 2, data.temperature_centi_c);
+    TEST_ASSERT_EQUAL_UINT32(100 + (MEASUREMENT_BATCH_CAPACITY + 2) * 60, time_s);
+}
+
+void test_restore_checks_crc() {
+    {
+        MeasurementBatch batch(s_state);
+        batch.restore();
+        batch.push(500, reading(2000, 5000));
+        batch.push(560, reading(2010, 5010));
+    }
+    
+    // Next boot: the RTC copy is resumed
+    MeasurementBatch resumed(s_state);
+    TEST_ASSERT_TRUE(resumed.restore());
+    TEST_ASSERT_EQUAL_UINT8(2, resumed.size());
+    
+    // A flipped bit (brown-out, new image) discards it
+    s_state.samples[1].humidity_centi_pct ^= 0x0100;
+    MeasurementBatch corrupt(s_state);
+    TEST_ASSERT_FALSE(corrupt.restore());
+    TEST_ASSERT_EQUAL_UINT8(0, corrupt.size());
+    TEST_ASSERT_TRUE(corrupt.restore());  // Cleared state is valid again
+}
+
+void test_encode_and_consume() {
+    MeasurementBatch batch(s_state);
+    batch.restore();
+    uint8_t payload[MEASUREMENT_BATCH_PAYLOAD_MAX];
+    TEST_ASSERT_EQUAL(0, batch.encode(payload, 0, 90));
+    
+    batch.push(1000, reading(2250, 6120));
+    batch.push(1300, reading(-50, 4500));
+    
+    const uint8_t expected[] = {
+        MEASUREMENT_BATCH_VERSION, 2, 87,
+        0x0A, 0x00,                // Newest is 10 s old
+        0x00, 0x00, 0xCA, 0x08, 0xE8, 0x17,    // Oldest: delta 0, 22.50 °C, 61.20 %
+        0x2C, 0x01, 0xCE, 0xFF, 0x94, 0x11     // +300 s, -0.50 °C, 45.00 %
+    };
+    TEST_ASSERT_EQUAL(sizeof(expected), batch.encode(payload, 1310, 87));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, payload, sizeof(expected));
+    
+    // Published the first sample only: the second stays, with its own time
+    batch.consume(1);
+    uint32_t time_s = 0;
+    SensorData data;
+    TEST_ASSERT_EQUAL_UINT8(1, batch.size());
+    TEST_ASSERT_TRUE(batch.sample(0, time_s, data));
+    TEST_ASSERT_EQUAL_UINT32(1300, time_s);
+    TEST_ASSERT_EQUAL_INT16(-50, data.temperature_centi_c);
+    
+    batch.consume(5);
+    TEST_ASSERT_EQUAL_UINT8(0, batch.size());
+}
+
+// =======================================================================================
+// MAIN TEST RUNNER
+// =======================================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    
+    RUN_TEST(test_samples_kept_in_order_with_times);
+    RUN_TEST(test_full_ring_drops_oldest);
+    RUN_TEST(test_restore_checks_crc);
+    RUN_TEST(test_encode_and_consume);
+    
+    return UNITY_END();
+}
@@ -0,0 +1,299 @@
+/**
+ * @file test_measurement_pipeline.cpp
+ * @brief Native Unit Tests for the compile-time measurement pipeline
+ *
+ * The pipeline and its stages are header-only templates; a scripted sensor
+ * stands in for the driver so every branch can be reached without a bus.
+ *
+ * Test Coverage:
+ * - Stages run in order on the caller's buffer; the pipeline adds no state
+ * - The first failing stage ends the run
+ * - Acquire, range check and alert check stages
+ * - BLE Mesh Sensor Status encoding (MPIDs, units, rounding, clamping)
+ * - Transmission of several kept readings: one batch message, or the newest
+ *   reading as a Sensor Status while the mesh carries no batch
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#include <unity.h>
+#include "MeasurementStages.hpp"
+
+// =======================================================================================
+// TEST STAGES
+// =======================================================================================
+
+static uint8_t s_order[8];
+static uint8_t s_calls;
+static const MeasurementSample* s_seen[8];
+
+// Records its position; fails if told to
+template <uint8_t ID>
+class RecordStage {
+public:
+    explicit RecordStage(bool fail = false) : m_fail(fail) {}
+    
+    PipelineStatus process(MeasurementSample& sample) {
+        s_seen[s_calls] = &sample;
+        s_order[s_calls++] = ID;
+        sample.payload[sample.payload_len++] = ID;
+        return m_fail ? PipelineStatus::ERROR_RANGE : PipelineStatus::OK;
+    }
+    
+private:
+    bool m_fail;
+};
+
+// Returns a scripted burst; only what AcquireStage and RangeCheckStage use
+class ScriptedSensor {
+public:
+    SensorStatus status;
+    BurstResult burst;
+    SensorInfo info;
+    uint8_t reads;
+    
+    ScriptedSensor() : status(SensorStatus::OK), burst(), info(), reads(0) {
+        info.temp_min_centi_c = -4000;
+        info.temp_max_centi_c = 12500;
+        info.hum_min_centi_pct = 0;
+        info.hum_max_centi_pct = 10000;
+        setReading(2250, 6120);
+    }
+    
+    void setReading(int16_t temp_centi_c, uint16_t hum_centi_pct) {
+        burst.data.temperature_centi_c = temp_centi_c;
+        burst.data.humidity_centi_pct = hum_centi_pct;
+        burst.data.quality_flags = 0xC0;
+        burst.samples = 5;
+        burst.valid = 5;
+    }
+    
+    SensorStatus readBurst(BurstResult& result) {
+        reads++;
+        result = burst;
+        return status;
+    }
+    
+    const SensorInfo& getInfo() const { return info; }
+};
+
+// Records publications; only what MeshTransmitStage uses
+class ScriptedMesh {
+public:
+    BLEMeshStatus batch_status;
+    BLEMeshStatus status_status;
+    uint8_t batches;
+    uint8_t statuses;
+    uint16_t batch_length;
+    uint8_t status_length;
+    
+    ScriptedMesh()
+        : batch_status(BLEMeshStatus::OK), status_status(BLEMeshStatus::OK)
+        , batches(0), statuses(0), batch_length(0), status_length(0) {}
+    
+    BLEMeshStatus publishSensorBatch(const uint8_t* payload, uint16_t length) {
+        batches++;
+        batch_length = length;
+        return batch_status;
+    }
+    
+    BLEMeshStatus publishSensorStatus(const uint8_t* payload, uint8_t length) {
+        statuses++;
+        status_length = length;
+        return status_status;
+    }
+};
+
+static MeasurementBatchState s_batch_state;
+static uint8_t s_batch_payload[MEASUREMENT_BATCH_PAYLOAD_MAX];
+
+// Keeps readings 300 s apart; the sample holds the newest, as after MEASURE
+static void keepReadings(MeasurementBatch& batch, MeasurementSample& sample, uint8_t count) {
+    batch.clear();
+    for (uint8_t i = 0; i < count; i++) {
+        sample.burst.data.temperature_centi_c = static_cast<int16_t>(2000 + 100 * i);
+        sample.burst.data.humidity_centi_pct = 6000;
+        batch.push(1000 + 300 * i, sample.burst.data);
+    }
+}
+
+static const SensorAlertLimits LIMITS = {1500, 3000, 4000, 8000, 50, 200};
+
+// =======================================================================================
+// TEST SETUP & TEARDOWN
+// =======================================================================================
+
+void setUp(void) {
+    s_calls = 0;
+}
+
+void tearDown(void) {}
+
+// =======================================================================================
+// TESTS
+// =======================================================================================
+
+void test_pipeline_runs_stages_in_order_on_one_buffer() {
+    MeasurementPipeline pipeline(RecordStage<1>{}, RecordStage<2>{}, RecordStage<3>{});
+    MeasurementSample sample = {};
+    size_t failed = 0;
+    
+    TEST_ASSERT_EQUAL(PipelineStatus::OK, pipeline.run(sample, &failed));
+    TEST_ASSERT_EQUAL(3, failed);
+    TEST_ASSERT_EQUAL_UINT8(3, s_calls);
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_UINT8(i + 1, s_order[i]);
+        TEST_ASSERT_EQUAL_PTR(&sample, s_seen[i]);  // No copies between stages
+    }
+    TEST_ASSERT_EQUAL_UINT8(3, sample.payload_len);
+    
+    // The pipeline is only its stages: empty stages cost nothing, a stage
+    // holding a reference costs one pointer
+    static_assert(sizeof(MeasurementPipeline<MeshEncodeStage, MeshPublishStage>) == 1, "stateless pipeline");
+    static_assert(sizeof(MeasurementPipeline<AcquireStage<ScriptedSensor>, AlertCheckStage>) ==
+                  2 * sizeof(void*), "pipeline adds no state");
+}
+
+void test_pipeline_stops_at_first_failure() {
+    MeasurementPipeline pipeline(RecordStage<1>{}, RecordStage<2>(true), RecordStage<3>{});
+    MeasurementSample sample = {};
+    size_t failed = 0;
+    
+    TEST_ASSERT_EQUAL(PipelineStatus::ERROR_RANGE, pipeline.run(sample, &failed));
+    TEST_ASSERT_EQUAL(1, failed);
+    TEST_ASSERT_EQUAL_UINT8(2, s_calls);  // Stage 3 never ran
+    
+    // Stages can be retuned between runs
+    pipeline.stage<1>() = RecordStage<2>(false);
+    s_calls = 0;
+    TEST_ASSERT_EQUAL(PipelineStatus::OK, pipeline.run(sample));
+    TEST_ASSERT_EQUAL_UINT8(3, s_calls);
+}
+
+void test_acquire_range_and_alert_stages() {
+    ScriptedSensor sensor;
+    MeasurementPipeline pipeline(AcquireStage<ScriptedSensor>(sensor),
+                                 RangeCheckStage(sensor.getInfo()),
+                                 AlertCheckStage(LIMITS));
+    MeasurementSample sample = {};
+    
+    // In range, inside the alert window
+    TEST_ASSERT_EQUAL(PipelineStatus::OK, pipeline.run(sample));
+    TEST_ASSERT_EQUAL_INT16(2250, sample.data().temperature_centi_c);
+    TEST_ASSERT_FALSE(sample.alert);
+    
+    // Too humid: published as an alert
+    sensor.setReading(2250, 8500);
+    TEST_ASSERT_EQUAL(PipelineStatus::OK, pipeline.run(sample));
+    TEST_ASSERT_TRUE(sample.alert);
+    
+    // The next acquisition clears the flag
+    sensor.setReading(2000, 6000);
+    TEST_ASSERT_EQUAL(PipelineStatus::OK, pipeline.run(sample));
+    TEST_ASSERT_FALSE(sample.alert);
+    
+    // Physically impossible aggregate
+    sensor.setReading(-5000, 6000);
+    TEST_ASSERT_EQUAL(PipelineStatus::ERROR_RANGE, pipeline.run(sample));
+    
+    // Driver failure is reported with its own status
+    sensor.status = SensorStatus::ERROR_CRC;
+    size_t failed = 0;
+    TEST_ASSERT_EQUAL(PipelineStatus::ERROR_ACQUIRE, pipeline.run(sample, &failed));
+    TEST_ASSERT_EQUAL(0, failed);
+    TEST_ASSERT_EQUAL(SensorStatus::ERROR_CRC, sample.sensor_status);
+    TEST_ASSERT_EQUAL_UINT8(5, sensor.reads);
+}
+
+void test_mesh_encode_sensor_status() {
+    MeasurementSample sample = {};
+    sample.burst.data.temperature_centi_c = 2250;   // 22.50 °C
+    sample.burst.data.humidity_centi_pct = 6120;    // 61.20 %RH
+    sample.battery_percent = 87;
+    
+    MeasurementPipeline encode(MeshEncodeStage{});
+    TEST_ASSERT_EQUAL(PipelineStatus::OK, encode.run(sample));
+    
+    const uint8_t expected[] = {
+        0xE0, 0x09, 45,            // Temperature 8 (0x004F), 1 byte: 22.5 °C / 0.5
+        0xC2, 0x0E, 0xE8, 0x17,    // Humidity (0x0076), 2 bytes: 6120
+        0xC0, 0x0D, 174            // Percentage 8 (0x006E), 1 byte: 87 % / 0.5
+    };
+    TEST_ASSERT_EQUAL_UINT8(sizeof(expected), sample.payload_len);
+    TEST_ASSERT_EQUAL_UINT8(MeshEncodeStage::PAYLOAD_LEN, sample.payload_len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, sample.payload, sizeof(expected));
+    
+    // Rounded to the nearest half degree, clamped to the Temperature 8 range
+    TEST_ASSERT_EQUAL_INT8(2, MeshEncodeStage::temperature8(124));   // 1.24 -> 1.0
+    TEST_ASSERT_EQUAL_INT8(3, MeshEncodeStage::temperature8(126));   // 1.26 -> 1.5
+    TEST_ASSERT_EQUAL_INT8(-3, MeshEncodeStage::temperature8(-126));
+    TEST_ASSERT_EQUAL_INT8(126, MeshEncodeStage::temperature8(7000));
+    TEST_ASSERT_EQUAL_INT8(-128, MeshEncodeStage::temperature8(-7000));
+}
+
+void test_transmit_batch_of_kept_readings() {
+    ScriptedMesh mesh;
+    MeasurementBatch batch(s_batch_state);
+    MeasurementSample sample = {};
+    keepReadings(batch, sample, 3);
+    
+    MeasurementPipeline transmit(MeshTransmitStage<ScriptedMesh>(mesh, batch, s_batch_payload, 1700));
+    TEST_ASSERT_EQUAL(PipelineStatus::OK, transmit.run(sample));
+    TEST_ASSERT_EQUAL_UINT8(1, mesh.batches);
+    TEST_ASSERT_EQUAL_UINT8(0, mesh.statuses);
+    TEST_ASSERT_EQUAL_UINT16(MEASUREMENT_BATCH_HEADER_LEN + 3 * MEASUREMENT_BATCH_SAMPLE_LEN, mesh.batch_length);
+    TEST_ASSERT_EQUAL_UINT8(3, s_batch_payload[1]);
+    
+    // Not provisioned: nothing sent, no fallback
+    mesh = ScriptedMesh();
+    mesh.batch_status = BLEMeshStatus::ERROR_NOT_PROVISIONED;
+    TEST_ASSERT_EQUAL(PipelineStatus::ERROR_OFFLINE, transmit.run(sample));
+    TEST_ASSERT_EQUAL_UINT8(0, mesh.statuses);
+}
+
+void test_transmit_falls_back_to_sensor_status() {
+    ScriptedMesh mesh;
+    mesh.batch_status = BLEMeshStatus::ERROR_NOT_SUPPORTED;
+    MeasurementBatch batch(s_batch_state);
+    MeasurementSample sample = {};
+    sample.battery_percent = 87;
+    keepReadings(batch, sample, 6);
+    
+    // Every kept reading is covered by the newest one's Sensor Status
+    MeasurementPipeline transmit(MeshTransmitStage<ScriptedMesh>(mesh, batch, s_batch_payload, 2500));
+    TEST_ASSERT_EQUAL(PipelineStatus::OK, transmit.run(sample));
+    TEST_ASSERT_EQUAL_UINT8(1, mesh.batches);
+    TEST_ASSERT_EQUAL_UINT8(1, mesh.statuses);
+    TEST_ASSERT_EQUAL_UINT8(MeshEncodeStage::PAYLOAD_LEN, mesh.status_length);
+    TEST_ASSERT_EQUAL_UINT8(MeshEncodeStage::temperature8(2500), sample.payload[2]);
+    
+    mesh = ScriptedMesh();
+    mesh.batch_status = BLEMeshStatus::ERROR_NOT_SUPPORTED;
+    mesh.status_status = BLEMeshStatus::ERROR_SEND;
+    TEST_ASSERT_EQUAL(PipelineStatus::ERROR_PUBLISH, transmit.run(sample));
+    
+    // A single kept reading is a Sensor Status straight away
+    keepReadings(batch, sample, 1);
+    mesh = ScriptedMesh();
+    TEST_ASSERT_EQUAL(PipelineStatus::OK, transmit.run(sample));
+    TEST_ASSERT_EQUAL_UINT8(0, mesh.batches);
+    TEST_ASSERT_EQUAL_UINT8(1, mesh.statuses);
+}
+
+// =======================================================================================
+// MAIN TEST RUNNER
+// =======================================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    
+    RUN_TEST(test_pipeline_runs_stages_in_order_on_one_buffer);
+    RUN_TEST(test_pipeline_stops_at_first_failure);
+    RUN_TEST(test_acquire_range_and_alert_stages);
+    RUN_TEST(test_mesh_encode_sensor_status);
+    RUN_TEST(test_transmit_batch_of_kept_readings);
+    RUN_TEST(test_transmit_falls_back_to_sensor_status);
+    
+    return UNITY_END();
+}
@@ -0,0 +1,154 @@
+/**
+ * @file test_rtc_timebase.cpp
+ * @brief Native Unit Tests for the RTC slow-clock timebase
+ *
+ * Counter readings and calibrations are scripted: a 136 kHz RC clock that
+ * runs faster or slower between wakes, as it does with temperature.
+ *
+ * Test Coverage:
+ * - Tick conversion (Q13.19 period, no overflow on 48-bit counters)
+ * - Sleeps bridged with the mean period; clock monotonic across a counter reset
+ * - Wake latency learned on timer wakes only and taken off the next sleep
+ * - Drift estimate and guard time; invalid RTC contents restart the clock
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#include <unity.h>
+#include <cstring>
+#include "RtcTimebase.hpp"
+
+static RtcTimebaseState s_state;
+
+// 136 kHz: 7.3529 µs per tick
+static const uint32_t PERIOD_136K = 3855059;
+static const uint64_t TICKS_PER_S = 136000;
+
+// Period of a clock off by ppm (positive = slower clock, longer period)
+static uint32_t period(int32_t ppm) {
+    return static_cast<uint32_t>(PERIOD_136K + static_cast<int64_t>(PERIOD_136K) * ppm / 1000000);
+}
+
+// =======================================================================================
+// TEST SETUP & TEARDOWN
+// =======================================================================================
+
+void setUp(void) {
+    memset(&s_state, 0, sizeof(s_state));  // Cold boot
+}
+
+void tearDown(void) {}
+
+// =======================================================================================
+// TESTS
+// =======================================================================================
+
+void test_tick_conversion() {
+    TEST_ASSERT_UINT64_WITHIN(1, 1000000, RtcTimebase::ticksToUs(TICKS_PER_S, PERIOD_136K));
+    TEST_ASSERT_EQUAL_UINT64(0, RtcTimebase::ticksToUs(0, PERIOD_136K));
+    
+    // Two years of counter ticks: ticks x period alone would overflow 64 bits
+    uint64_t ticks = TICKS_PER_S * 2 * 365 * 24 * 3600;
+    double exact_us = static_cast<double>(ticks) * PERIOD_136K / (1 << RTC_TIMEBASE_PERIOD_SHIFT);
+    TEST_ASSERT_UINT64_WITHIN(1, static_cast<uint64_t>(exact_us), RtcTimebase::ticksToUs(ticks, PERIOD_136K));
+}
+
+void test_sleep_bridged_with_mean_period() {
+    RtcTimebase clock(s_state);
+    TEST_ASSERT_FALSE(clock.start(TICKS_PER_S, period(1000), false));  // Cold boot
+    uint64_t base_us = RtcTimebase::ticksToUs(TICKS_PER_S, period(1000));
+    TEST_ASSERT_EQUAL_UINT64(base_us, clock.nowUs(TICKS_PER_S));
+    TEST_ASSERT_UINT64_WITHIN(1, base_us + 500000 + 500, clock.nowUs(TICKS_PER_S * 3 / 2));
+    
+    // 300 s of ticks; the clock was 1000 ppm slow before and 3000 ppm slow
+    // after: the mean (2000 ppm) is used for the whole sleep
+    uint64_t wake_ticks = TICKS_PER_S + 300 * TICKS_PER_S;
+    TEST_ASSERT_TRUE(clock.start(wake_ticks, period(3000), true));
+    TEST_ASSERT_UINT64_WITHIN(2, base_us + RtcTimebase::ticksToUs(300 * TICKS_PER_S, period(2000)),
+                              clock.nowUs(wake_ticks));
+    TEST_ASSERT_EQUAL_UINT32(1, clock.sleeps());
+    
+    // Awake time runs on this wake's period
+    TEST_ASSERT_UINT64_WITHIN(2, clock.nowUs(wake_ticks) + RtcTimebase::ticksToUs(TICKS_PER_S, period(3000)),
+                              clock.nowUs(wake_ticks + TICKS_PER_S));
+    
+    // Counter restarted with RTC memory kept: the clock does not step back
+    uint64_t last_us = clock.nowUs(wake_ticks);
+    TEST_ASSERT_TRUE(clock.start(TICKS_PER_S, PERIOD_136K, false));
+    TEST_ASSERT_TRUE(clock.nowUs(TICKS_PER_S) >= last_us);
+    TEST_ASSERT_EQUAL_UINT64(clock.nowUs(TICKS_PER_S), clock.nowUs(0));  // Before the base: held
+}
+
+void test_wake_latency_learned_and_compensated() {
+    RtcTimebase clock(s_state);
+    clock.start(0, PERIOD_136K, false);
+    TEST_ASSERT_EQUAL_UINT64(60000000, clock.sleepUs(0, 60000000));  // Nothing learned yet
+    
+    // Sleep 60 s; the application runs 180 ms after the timer fired
+    uint64_t ticks = 0;
+    uint64_t now_us = clock.nowUs(ticks);
+    clock.prepareSleep(now_us, 60000000);
+    ticks += 60 * TICKS_PER_S + 180 * TICKS_PER_S / 1000;
+    clock.start(ticks, PERIOD_136K, true);
+    TEST_ASSERT_UINT32_WITHIN(10, 180000, clock.wakeLatencyUs());
+    
+    // The next sleep ends a latency before the deadline
+    now_us = clock.nowUs(ticks);
+    TEST_ASSERT_UINT64_WITHIN(10, 300000000 - 180000, clock.sleepUs(now_us, now_us + 300000000));
+    TEST_ASSERT_EQUAL_UINT64(0, clock.sleepUs(now_us, now_us + 100000));  // Closer than the latency
+    
+    // A GPIO wake (or one long after the timer) teaches nothing
+    clock.prepareSleep(now_us, 60000000);
+    ticks += 20 * TICKS_PER_S;
+    clock.start(ticks, PERIOD_136K, false);
+    TEST_ASSERT_UINT32_WITHIN(10, 180000, clock.wakeLatencyUs());
+    now_us = clock.nowUs(ticks);
+    clock.prepareSleep(now_us, 1000000);
+    ticks += 10 * TICKS_PER_S;
+    clock.start(ticks, PERIOD_136K, true);
+    TEST_ASSERT_UINT32_WITHIN(10, 180000, clock.wakeLatencyUs());
+    
+    // Later samples move the running mean by a quarter
+    now_us = clock.nowUs(ticks);
+    clock.prepareSleep(now_us, 1000000);
+    ticks += TICKS_PER_S + 260 * TICKS_PER_S / 1000;
+    clock.start(ticks, PERIOD_136K, true);
+    TEST_ASSERT_UINT32_WITHIN(10, 200000, clock.wakeLatencyUs());
+}
+
+void test_drift_guard_and_invalid_state() {
+    RtcTimebase clock(s_state);
+    clock.start(0, period(0), false);
+    TEST_ASSERT_EQUAL_UINT32(0, clock.guardUs(300000000));
+    
+    // Period changes 500 ppm across each sleep
+    uint64_t ticks = 0;
+    for (int32_t i = 1; i <= 4; i++) {
+        ticks += 300 * TICKS_PER_S;
+        clock.start(ticks, period((i % 2) ? 500 : 0), false);
+    }
+    TEST_ASSERT_UINT32_WITHIN(5, 500, clock.driftPpm());
+    TEST_ASSERT_UINT32_WITHIN(2000, 150000, clock.guardUs(300000000));  // 500 ppm of 300 s
+    
+    // A period no RC clock can have: RTC contents are not a timebase
+    s_state.period_q19 = 0xFFFFFFFF;
+    TEST_ASSERT_FALSE(clock.start(ticks, PERIOD_136K, true));
+    TEST_ASSERT_EQUAL_UINT32(0, clock.sleeps());
+    TEST_ASSERT_EQUAL_UINT32(0, clock.driftPpm());
+}
+
+// =======================================================================================
+// MAIN TEST RUNNER
+// =======================================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    
+    RUN_TEST(test_tick_conversion);
+    RUN_TEST(test_sleep_bridged_with_mean_period);
+    RUN_TEST(test_wake_latency_learned_and_compensated);
+    RUN_TEST(test_drift_guard_and_invalid_state);
+    
+    return UNITY_END();
+}
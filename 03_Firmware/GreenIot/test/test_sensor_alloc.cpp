@@ -0,0 +1,157 @@
+/**
+ * @file test_sensor_alloc.cpp
+ * @brief Native Unit Tests: the sensor HAL does not touch the heap
+ *
+ * Replaces the global operator new / delete with counting versions and runs
+ * the real SensorFactory + SHT31Sensor + I2CDriver against the simulated bus.
+ * The driver is started before counting begins, as it is at boot.
+ *
+ * Test Coverage:
+ * - Factory lookup through the first read() performs zero allocations
+ * - Burst acquisition performs zero allocations
+ * - Registry lookups, static instances and constexpr sensor metadata
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#include <unity.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include "I2CDriver.hpp"
+#include "ISensor.hpp"
+#include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sim_i2c_bus.h"
+#include "virtual_sht31.h"
+
+// =======================================================================================
+// HEAP TRACKING
+// =======================================================================================
+
+static std::atomic<uint32_t> s_allocations(0);
+
+void* operator new(size_t size) {
+    s_allocations++;
+    void* ptr = malloc(size != 0 ? size : 1);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+static_assert(std::is_trivially_destructible<SensorInfo>::value,
+              "SensorInfo must stay a literal type (no owning strings)");
+
+static SimI2CBus s_bus;
+static VirtualSHT31 s_sht31(0x44);
+
+// =======================================================================================
+// TEST SETUP & TEARDOWN
+// =======================================================================================
+
+void setUp(void) {
+    s_bus.detachAll();
+    s_sht31 = VirtualSHT31(0x44);
+    s_bus.attach(&s_sht31);
+    
+    I2CDriver& driver = I2CDriver::getInstance();
+    driver.deinit();
+    native_set_reset_reason(ESP_RST_POWERON);
+    driver.setBackend(&s_bus);
+    
+    I2CConfig config;
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(driver.init(config)));
+    
+    // The host RTOS creates the calling thread's notification slot on first
+    // use; on target the TCB is static
+    xTaskGetCurrentTaskHandle();
+}
+
+void tearDown(void) {
+    I2CDriver::getInstance().waitIdle(100);
+}
+
+// =======================================================================================
+// TESTS
+// =======================================================================================
+
+void test_alloc_factory_to_first_read_is_heap_free() {
+    s_sht31.setConditions(21.5f, 58.0f);
+    
+    // The counter itself works
+    uint32_t before = s_allocations;
+    delete new int(0);
+    TEST_ASSERT_EQUAL_UINT32(before + 1, s_allocations.load());
+    
+    s_allocations = 0;
+    
+    ISensor* sensor = SensorFactory::create("SHT31");
+    TEST_ASSERT_NOT_NULL(sensor);
+    const SensorInfo& info = sensor->getInfo();
+    TEST_ASSERT_EQUAL_STRING("SHT31", info.name);
+    
+    SensorConfig config;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor->init()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor->configure(config)));
+    
+    SensorData data;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor->triggerMeasurement()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor->read(data)));
+    
+    TEST_ASSERT_EQUAL_UINT32(0, s_allocations.load());
+    TEST_ASSERT_EQUAL_INT16(2150, data.temperature_centi_c);
+    TEST_ASSERT_EQUAL_UINT16(5800, data.humidity_centi_pct);
+}
+
+void test_alloc_burst_is_heap_free() {
+    ISensor* sensor = SensorFactory::create("SHT31");
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor->init()));
+    
+    s_allocations = 0;
+    
+    BurstResult burst;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor->readBurst(burst)));
+    TEST_ASSERT_EQUAL_UINT8(burst.samples, burst.valid);
+    
+    TEST_ASSERT_EQUAL_UINT32(0, s_allocations.load());
+}
+
+void test_alloc_registry_static_instances() {
+    TEST_ASSERT_EQUAL(2, static_cast<int>(SensorFactory::getSensorCount()));
+    TEST_ASSERT_EQUAL_STRING("SHT31", SensorFactory::getSensorName(0));
+    TEST_ASSERT_EQUAL_STRING("AHT20", SensorFactory::getSensorName(1));
+    TEST_ASSERT_NULL(SensorFactory::getSensorName(2));
+    
+    TEST_ASSERT_NULL(SensorFactory::create("UNKNOWN_SENSOR"));
+    TEST_ASSERT_NULL(SensorFactory::create(nullptr));
+    TEST_ASSERT_EQUAL_PTR(SensorFactory::create("SHT31"), SensorFactory::create("SHT31"));
+    
+    // Metadata is the same flash table on every call
+    const SensorInfo& info = SensorFactory::create("SHT31")->getInfo();
+    TEST_ASSERT_EQUAL_PTR(&info, &SensorFactory::create("SHT31")->getInfo());
+    TEST_ASSERT_EQUAL_STRING("Sensirion", info.manufacturer);
+}
+
+// =======================================================================================
+// MAIN TEST RUNNER
+// =======================================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    
+    RUN_TEST(test_alloc_factory_to_first_read_is_heap_free);
+    RUN_TEST(test_alloc_burst_is_heap_free);
+    RUN_TEST(test_alloc_registry_static_instances);
+    
+    return UNITY_END();
+}
@@ -0,0 +1,186 @@
+/**
+ * @file test_sensor_binding.cpp
+ * @brief Native Unit Tests + benchmark for compile-time sensor binding
+ *
+ * A bus-free final sensor runs the shared burst engine once through the
+ * ISensor interface (virtual per-sample calls) and once through its own
+ * type (direct, inlinable calls) so only the dispatch cost differs.
+ *
+ * Test Coverage:
+ * - SensorBinding and SensorFactory share one static instance
+ * - Static and dynamic burst paths return identical results
+ * - Per-burst benchmark: virtual vs devirtualised dispatch
+ *
+ * Code size: compare `pio run -e esp32-c3-devkitm-1 -t size` (static
+ * SHT31 binding) with `pio run -e esp32-c3-dynamic-sensor -t size`.
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include "SensorBinding.hpp"
+#include "SHT31Sensor.hpp"
+
+#ifndef NATIVE_BUILD
+#include "esp_cpu.h"
+#endif
+
+// =======================================================================================
+// BUS-FREE SENSOR
+// =======================================================================================
+
+// Feeds SHT31 raw codes through the real conversions; no I/O, so the
+// benchmark measures dispatch and arithmetic only
+class CountingSensor final : public ISensor {
+public:
+    CountingSensor() : m_raw(0x6000) {}
+    
+    SensorStatus init() override { return SensorStatus::OK; }
+    SensorStatus deinit() override { return SensorStatus::OK; }
+    SensorStatus triggerMeasurement() override { return SensorStatus::OK; }
+    
+    SensorStatus read(SensorData& data) override {
+        m_raw = static_cast<uint16_t>(m_raw * 75 + 74);  // Cheap pseudo-random walk
+        uint16_t raw = static_cast<uint16_t>(0x6000 + (m_raw & 0x00FF));
+        data.temperature_centi_c = SHT31Sensor::rawToCentiCelsius(raw);
+        data.humidity_centi_pct = SHT31Sensor::rawToCentiPercent(raw);
+        data.timestamp = raw;
+        data.quality_flags = 0xC0;
+        return SensorStatus::OK;
+    }
+    
+    SensorStatus sleep() override { return SensorStatus::OK; }
+    SensorStatus wakeup() override { return SensorStatus::OK; }
+    SensorStatus selfTest() override { return SensorStatus::OK; }
+    SensorStatus reset() override { m_raw = 0x6000; return SensorStatus::OK; }
+    SensorStatus configure(const SensorConfig& config) override { return SensorStatus::OK; }
+    
+    const SensorInfo& getInfo() const override {
+        static constexpr SensorInfo info = {
+            .name = "Counting",
+            .manufacturer = "Test",
+            .temp_min_centi_c = -4000,
+            .temp_max_centi_c = 12500,
+            .hum_min_centi_pct = 0,
+            .hum_max_centi_pct = 10000,
+            .temp_accuracy_centi_c = 30,
+            .hum_accuracy_centi_pct = 200,
+            .measurement_time_ms = 0,
+            .startup_time_ms = 0,
+            .reset_time_ms = 0,
+            .first_conversion_ms = 0,
+            .power_active_ua = 0,
+            .power_sleep_na = 0
+        };
+        return info;
+    }
+    
+    SensorStatus burstStatic(BurstResult& result) {
+        return acquireBurst(*this, 5, BurstFilter::MEDIAN, result);
+    }
+    
+    static SensorStatus burstDynamic(ISensor& sensor, BurstResult& result) {
+        return acquireBurst(sensor, 5, BurstFilter::MEDIAN, result);
+    }
+    
+private:
+    uint16_t m_raw;
+};
+
+static uint32_t nowTicks() {
+#ifdef NATIVE_BUILD
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#else
+    return esp_cpu_get_cycle_count();
+#endif
+}
+
+// =======================================================================================
+// TEST SETUP & TEARDOWN
+// =======================================================================================
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// =======================================================================================
+// TESTS
+// =======================================================================================
+
+void test_binding_shares_factory_instance() {
+    SHT31Sensor& bound = SensorBinding<SHT31Sensor>::instance();
+    TEST_ASSERT_EQUAL_PTR(&bound, SensorFactory::create("SHT31"));
+    TEST_ASSERT_EQUAL_PTR(&bound, SensorBinding<SHT31Sensor>::dynamicInstance());
+}
+
+void test_binding_static_and_dynamic_paths_agree() {
+    CountingSensor sensor;
+    BurstResult direct;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.burstStatic(direct)));
+    
+    sensor.reset();
+    BurstResult dynamic;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK),
+                      static_cast<int>(CountingSensor::burstDynamic(sensor, dynamic)));
+    
+    TEST_ASSERT_EQUAL_INT16(direct.data.temperature_centi_c, dynamic.data.temperature_centi_c);
+    TEST_ASSERT_EQUAL_UINT16(direct.data.humidity_centi_pct, dynamic.data.humidity_centi_pct);
+    TEST_ASSERT_EQUAL_HEX16(0x001F, dynamic.sample_mask);
+}
+
+// =======================================================================================
+// BENCHMARK
+// =======================================================================================
+
+void test_binding_benchmark_per_burst() {
+    const uint32_t ROUNDS = 20000;
+    CountingSensor sensor;
+    ISensor* volatile opaque = &sensor;  // volatile: hide the dynamic type from the compiler
+    volatile int32_t sink = 0;
+    BurstResult result = {};
+    
+    uint32_t start = nowTicks();
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        CountingSensor::burstDynamic(*opaque, result);
+        sink = sink + result.data.temperature_centi_c;
+    }
+    uint32_t virtual_ticks = nowTicks() - start;
+    
+    start = nowTicks();
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        sensor.burstStatic(result);
+        sink = sink + result.data.temperature_centi_c;
+    }
+    uint32_t static_ticks = nowTicks() - start;
+    
+    char message[120];
+#ifdef NATIVE_BUILD
+    snprintf(message, sizeof(message), "Per 5-sample burst (host): virtual %u ns, static %u ns",
+             static_cast<unsigned>(virtual_ticks / ROUNDS), static_cast<unsigned>(static_ticks / ROUNDS));
+#else
+    snprintf(message, sizeof(message), "Per 5-sample burst (ESP32-C3): virtual %u cycles, static %u cycles",
+             static_cast<unsigned>(virtual_ticks / ROUNDS), static_cast<unsigned>(static_ticks / ROUNDS));
+#endif
+    TEST_MESSAGE(message);
+    (void)sink;
+}
+
+// =======================================================================================
+// MAIN TEST RUNNER
+// =======================================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    
+    RUN_TEST(test_binding_shares_factory_instance);
+    RUN_TEST(test_binding_static_and_dynamic_paths_agree);
+    RUN_TEST(test_binding_benchmark_per_burst);
+    
+    return UNITY_END();
+}
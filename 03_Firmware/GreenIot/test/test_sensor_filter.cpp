@@ -0,0 +1,323 @@
+/**
+ * @file test_sensor_filter.cpp
+ * @brief Native Unit Tests for burst acquisition and its robust aggregates
+ *
+ * SensorFilter.hpp and the ISensor burst engine are header-only, so a
+ * scripted sensor exercises the same code that runs in the firmware.
+ *
+ * Test Coverage:
+ * - Median for odd / even counts, rounding of negative values
+ * - Trimmed mean drops a quarter at each end
+ * - Failed and out-of-range samples (temperature or humidity) are masked, not fatal
+ * - Burst fails, and stops early, once a majority is out of reach
+ * - Invalid sample counts are rejected
+ * - Sample-to-sample variance ignores a slow drift
+ * - Adaptive repeatability steps down one level at a time, escalates on
+ *   excess noise and near the precision window edges
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-05
+ */
+
+#include <unity.h>
+#include "ISensor.hpp"
+#include "AdaptivePrecision.hpp"
+
+// =======================================================================================
+// SCRIPTED SENSOR
+// =======================================================================================
+
+struct ScriptedSample {
+    SensorStatus status;
+    int16_t temperature_centi_c;
+    uint16_t humidity_centi_pct;
+};
+
+class ScriptedSensor : public ISensor {
+public:
+    ScriptedSensor(const ScriptedSample* script, uint8_t length)
+        : m_script(script)
+        , m_length(length)
+        , m_next(0)
+        , m_samples(1)
+        , m_filter(BurstFilter::MEDIAN) {}
+    
+    SensorStatus init() override { return SensorStatus::OK; }
+    SensorStatus deinit() override { return SensorStatus::OK; }
+    SensorStatus triggerMeasurement() override { return SensorStatus::OK; }
+    
+    SensorStatus read(SensorData& data) override {
+        if (m_next >= m_length) return SensorStatus::ERROR_COMM;
+        const ScriptedSample& sample = m_script[m_next++];
+        data.temperature_centi_c = sample.temperature_centi_c;
+        data.humidity_centi_pct = sample.humidity_centi_pct;
+        data.timestamp = m_next;
+        data.quality_flags = 0xC0;
+        return sample.status;
+    }
+    
+    SensorStatus readBurst(BurstResult& result) override {
+        return acquireBurst(m_samples, m_filter, result);
+    }
+    
+    SensorStatus sleep() override { return SensorStatus::OK; }
+    SensorStatus wakeup() override { return SensorStatus::OK; }
+    SensorStatus selfTest() override { return SensorStatus::OK; }
+    SensorStatus reset() override { return SensorStatus::OK; }
+    
+    SensorStatus configure(const SensorConfig& config) override {
+        m_samples = config.burst_samples;
+        m_filter = config.burst_filter;
+        return SensorStatus::OK;
+    }
+    
+    const SensorInfo& getInfo() const override {
+        static const SensorInfo info = {
+            .name = "Scripted",
+            .manufacturer = "Test",
+            .temp_min_centi_c = -4000,
+            .temp_max_centi_c = 12500,
+            .hum_min_centi_pct = 0,
+            .hum_max_centi_pct = 10000,
+            .temp_accuracy_centi_c = 30,
+            .hum_accuracy_centi_pct = 200,
+            .measurement_time_ms = 15,
+            .startup_time_ms = 2,
+            .reset_time_ms = 0,
+            .first_conversion_ms = 0,
+            .power_active_ua = 800,
+            .power_sleep_na = 200
+        };
+        return info;
+    }
+    
+    uint8_t samplesTaken() const { return m_next; }
+    
+private:
+    const ScriptedSample* m_script;
+    uint8_t m_length;
+    uint8_t m_next;
+    uint8_t m_samples;
+    BurstFilter m_filter;
+};
+
+static SensorConfig burstConfig(uint8_t samples, BurstFilter filter) {
+    SensorConfig config;
+    config.burst_samples = samples;
+    config.burst_filter = filter;
+    return config;
+}
+
+// =======================================================================================
+// TEST SETUP & TEARDOWN
+// =======================================================================================
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// =======================================================================================
+// FILTER TESTS
+// =======================================================================================
+
+void test_filter_median_odd_and_even() {
+    int32_t odd[] = {2250, 9000, 2240, 2260, 2255};
+    TEST_ASSERT_EQUAL_INT32(2255, SensorFilter::median(odd, 5));
+    
+    int32_t even[] = {2250, 2261, 9000, 2240};
+    TEST_ASSERT_EQUAL_INT32(2256, SensorFilter::median(even, 4));  // (2250 + 2261) / 2, rounded
+    
+    int32_t negative[] = {-101, -100};
+    TEST_ASSERT_EQUAL_INT32(-101, SensorFilter::median(negative, 2));  // Half away from zero
+    
+    int32_t single[] = {42};
+    TEST_ASSERT_EQUAL_INT32(42, SensorFilter::median(single, 1));
+    TEST_ASSERT_EQUAL_INT32(0, SensorFilter::median(single, 0));
+}
+
+void test_filter_trimmed_mean_drops_quarters() {
+    // 8 values: the lowest 2 and the highest 2 are dropped
+    int32_t values[] = {-5000, 2250, 2252, 9000, 2248, 2250, 8000, 2252};
+    TEST_ASSERT_EQUAL_INT32(2251, SensorFilter::trimmedMean(values, 8));
+    
+    // Fewer than 4 values: plain mean
+    int32_t few[] = {10, 20, 31};
+    TEST_ASSERT_EQUAL_INT32(20, SensorFilter::trimmedMean(few, 3));
+}
+
+void test_filter_successive_variance_ignores_drift() {
+    // Steady ramp: plain variance 5, successive-difference variance 2
+    int32_t ramp[] = {2250, 2252, 2254, 2256};
+    TEST_ASSERT_EQUAL_UINT32(32, SensorFilter::successiveVarianceQ4(ramp, 4));
+    
+    // Alternating +-5 around 2255: variance 50 either way
+    int32_t noisy[] = {2250, 2260, 2250, 2260};
+    TEST_ASSERT_EQUAL_UINT32(800, SensorFilter::successiveVarianceQ4(noisy, 4));
+    
+    TEST_ASSERT_EQUAL_UINT32(0, SensorFilter::successiveVarianceQ4(noisy, 1));
+}
+
+// =======================================================================================
+// BURST TESTS
+// =======================================================================================
+
+void test_burst_masks_bad_samples() {
+    const ScriptedSample script[] = {
+        {SensorStatus::OK,        2250, 6100},
+        {SensorStatus::ERROR_CRC, 2250, 6100},
+        {SensorStatus::OK,       13000, 6100},   // Above the sensor's rated range
+        {SensorStatus::OK,        2260, 6120},
+        {SensorStatus::OK,        2240, 6080},
+    };
+    ScriptedSensor sensor(script, 5);
+    sensor.configure(burstConfig(5, BurstFilter::MEDIAN));
+    
+    BurstResult result;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.readBurst(result)));
+    TEST_ASSERT_EQUAL_UINT8(5, result.samples);
+    TEST_ASSERT_EQUAL_UINT8(3, result.valid);
+    TEST_ASSERT_EQUAL_HEX16(0x0019, result.sample_mask);
+    TEST_ASSERT_EQUAL_INT16(2250, result.data.temperature_centi_c);
+    TEST_ASSERT_EQUAL_UINT16(6100, result.data.humidity_centi_pct);
+    TEST_ASSERT_TRUE(result.data.isValid());
+    TEST_ASSERT_EQUAL_UINT32(5, result.data.timestamp);  // Newest valid sample
+    TEST_ASSERT_EQUAL_UINT32(2000, result.temp_variance_q4);  // 2250, 2260, 2240: (100 + 400) / 4
+}
+
+void test_burst_masks_humidity_out_of_range() {
+    const ScriptedSample script[] = {
+        {SensorStatus::OK,        2250,  6100},
+        {SensorStatus::OK,        2250, 10500},  // Above 100 %RH
+        {SensorStatus::OK,        2260,  6120},
+        {SensorStatus::OK,        2240,  6080},
+        {SensorStatus::OK,        2250,  6100},
+    };
+    ScriptedSensor sensor(script, 5);
+    sensor.configure(burstConfig(5, BurstFilter::MEDIAN));
+    
+    BurstResult result;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor.readBurst(result)));
+    TEST_ASSERT_EQUAL_UINT8(4, result.valid);
+    TEST_ASSERT_EQUAL_HEX16(0x001D, result.sample_mask);
+    TEST_ASSERT_EQUAL_UINT16(6100, result.data.humidity_centi_pct);
+}
+
+void test_burst_fails_without_majority() {
+    const ScriptedSample script[] = {
+        {SensorStatus::ERROR_COMM, 0, 0},
+        {SensorStatus::OK,      2250, 6100},
+        {SensorStatus::ERROR_COMM, 0, 0},
+        {SensorStatus::ERROR_COMM, 0, 0},
+        {SensorStatus::OK,      2250, 6100},
+    };
+    ScriptedSensor sensor(script, 5);
+    sensor.configure(burstConfig(5, BurstFilter::TRIMMED_MEAN));
+    
+    BurstResult result;
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::ERROR_COMM),
+                      static_cast<int>(sensor.readBurst(result)));
+    TEST_ASSERT_EQUAL_UINT8(1, result.valid);
+    TEST_ASSERT_EQUAL_UINT8(4, sensor.samplesTaken());  // Third failure ends the burst
+}
+
+void test_burst_rejects_invalid_sample_count() {
+    ScriptedSensor sensor(nullptr, 0);
+    BurstResult result;
+    
+    sensor.configure(burstConfig(0, BurstFilter::MEDIAN));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::ERROR_INVALID_PARAM),
+                      static_cast<int>(sensor.readBurst(result)));
+    
+    sensor.configure(burstConfig(SENSOR_BURST_MAX_SAMPLES + 1, BurstFilter::MEDIAN));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::ERROR_INVALID_PARAM),
+                      static_cast<int>(sensor.readBurst(result)));
+    TEST_ASSERT_EQUAL_UINT8(0, sensor.samplesTaken());
+}
+
+// =======================================================================================
+// ADAPTIVE PRECISION TESTS
+// =======================================================================================
+
+static const SensorNoiseProfile PROFILE = {{400, 114, 28}, {784, 400, 114}};
+
+static BurstResult quietBurst(uint32_t temp_variance_q4, uint32_t hum_variance_q4) {
+    BurstResult burst = {};
+    burst.data = {2200, 6500, 0, 0xC0};
+    burst.samples = 5;
+    burst.valid = 5;
+    burst.sample_mask = 0x1F;
+    burst.temp_variance_q4 = temp_variance_q4;
+    burst.hum_variance_q4 = hum_variance_q4;
+    return burst;
+}
+
+void test_adaptive_precision_steps_down_and_escalates() {
+    SensorConfig config;   // 5 samples, 0.05 °C / 0.2 %RH target, no window
+    AdaptivePrecisionState state = {};
+    
+    // Nothing learnt yet: high
+    TEST_ASSERT_EQUAL_UINT8(2, AdaptivePrecision::select(state, PROFILE, config));
+    
+    // Noise at the datasheet level: one step down per burst
+    AdaptivePrecision::observe(state, PROFILE, 2, quietBurst(28, 114));
+    TEST_ASSERT_EQUAL_UINT8(1, AdaptivePrecision::select(state, PROFILE, config));
+    AdaptivePrecision::observe(state, PROFILE, 1, quietBurst(114, 400));
+    TEST_ASSERT_EQUAL_UINT8(0, AdaptivePrecision::select(state, PROFILE, config));
+    AdaptivePrecision::observe(state, PROFILE, 0, quietBurst(400, 784));
+    TEST_ASSERT_EQUAL_UINT8(0, AdaptivePrecision::select(state, PROFILE, config));
+    TEST_ASSERT_EQUAL_UINT32(0, state.temp_excess_q4);
+    
+    // Turbulent air: the low-repeatability burst misses the target, straight back to high
+    AdaptivePrecision::observe(state, PROFILE, 0, quietBurst(400 + 8000, 784));
+    TEST_ASSERT_EQUAL_UINT32(2000, state.temp_excess_q4);   // Smoothed by 1/4
+    TEST_ASSERT_EQUAL_UINT8(2, AdaptivePrecision::select(state, PROFILE, config));
+    
+    // A burst with too few valid samples does not move the estimate
+    BurstResult sparse = quietBurst(0, 0);
+    sparse.valid = 2;
+    AdaptivePrecision::observe(state, PROFILE, 2, sparse);
+    TEST_ASSERT_EQUAL_UINT32(2000, state.temp_excess_q4);
+}
+
+void test_adaptive_precision_window_forces_high() {
+    SensorConfig config;
+    config.precision_window = {1600, 2900, 4500, 7500, 0, 0};
+    AdaptivePrecisionState state = {};
+    
+    AdaptivePrecision::observe(state, PROFILE, 0, quietBurst(400, 784));
+    TEST_ASSERT_EQUAL_UINT8(0, AdaptivePrecision::select(state, PROFILE, config));
+    
+    BurstResult warm = quietBurst(400, 784);
+    warm.data.temperature_centi_c = 2950;   // Within 0.5 °C of the 30 °C critical limit
+    AdaptivePrecision::observe(state, PROFILE, 0, warm);
+    TEST_ASSERT_EQUAL_UINT8(2, AdaptivePrecision::select(state, PROFILE, config));
+    
+    BurstResult humid = quietBurst(400, 784);
+    humid.data.humidity_centi_pct = 7800;
+    AdaptivePrecision::observe(state, PROFILE, 2, humid);
+    TEST_ASSERT_EQUAL_UINT8(2, AdaptivePrecision::select(state, PROFILE, config));
+    
+    // Back inside: steps down again
+    AdaptivePrecision::observe(state, PROFILE, 2, quietBurst(28, 114));
+    TEST_ASSERT_EQUAL_UINT8(1, AdaptivePrecision::select(state, PROFILE, config));
+}
+
+// =======================================================================================
+// MAIN TEST RUNNER
+// =======================================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    
+    RUN_TEST(test_filter_median_odd_and_even);
+    RUN_TEST(test_filter_trimmed_mean_drops_quarters);
+    RUN_TEST(test_filter_successive_variance_ignores_drift);
+    RUN_TEST(test_burst_masks_bad_samples);
+    RUN_TEST(test_burst_masks_humidity_out_of_range);
+    RUN_TEST(test_burst_fails_without_majority);
+    RUN_TEST(test_burst_rejects_invalid_sample_count);
+    RUN_TEST(test_adaptive_precision_steps_down_and_escalates);
+    RUN_TEST(test_adaptive_precision_window_forces_high);
+    
+    return UNITY_END();
+}
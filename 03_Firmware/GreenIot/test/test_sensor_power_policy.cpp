@@ -0,0 +1,94 @@
+/**
+ * @file test_sensor_power_policy.cpp
+ * @brief Native Unit Tests for the sensor rail break-even model
+ *
+ * Test Coverage:
+ * - Keep / gate charges and the break-even sleep length
+ * - SHT31: rail kept for short sleeps, gated for long ones
+ * - AHT20: slow startup, rail kept for any practical sleep
+ * - A sensor with no idle current is never gated
+ * - Power-up reset and discarded first conversion add to the gate charge
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#include <unity.h>
+#include "SensorPowerPolicy.hpp"
+
+// PowerConfig defaults: 20 mA while waiting, 1 µF rail at 3.3 V
+static const uint32_t WAIT_UA = 20000;
+static const uint32_t RAIL_NC = 3300;
+
+// Figures from the drivers' SensorInfo
+static const SensorPowerModel SHT31_MODEL = {200, 2, WAIT_UA, RAIL_NC, 800, 0, 0};
+static const SensorPowerModel AHT20_MODEL = {250, 100, WAIT_UA, RAIL_NC, 980, 0, 0};
+
+// =======================================================================================
+// TEST SETUP & TEARDOWN
+// =======================================================================================
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// =======================================================================================
+// TESTS
+// =======================================================================================
+
+void test_charges_and_break_even() {
+    // 0.2 µA for 60 s = 12 µC
+    TEST_ASSERT_EQUAL_UINT64(12000, SensorPowerPolicy::keepChargeNc(SHT31_MODEL, 60000));
+    // 20 mA x 2 ms + 3.3 µC
+    TEST_ASSERT_EQUAL_UINT64(43300, SensorPowerPolicy::gateChargeNc(SHT31_MODEL));
+    TEST_ASSERT_EQUAL_UINT32(216500, SensorPowerPolicy::breakEvenMs(SHT31_MODEL));
+    
+    // Both sides are equal at break-even: the rail is kept
+    TEST_ASSERT_TRUE(SensorPowerPolicy::keepPowered(SHT31_MODEL, 216500));
+    TEST_ASSERT_FALSE(SensorPowerPolicy::keepPowered(SHT31_MODEL, 216510));
+}
+
+void test_sht31_gated_only_for_long_sleeps() {
+    TEST_ASSERT_TRUE(SensorPowerPolicy::keepPowered(SHT31_MODEL, 1000));      // Light sleep
+    TEST_ASSERT_TRUE(SensorPowerPolicy::keepPowered(SHT31_MODEL, 60000));     // Default deep sleep
+    TEST_ASSERT_FALSE(SensorPowerPolicy::keepPowered(SHT31_MODEL, 600000));   // Low battery interval
+}
+
+void test_aht20_rail_kept() {
+    // 100 ms power-up: about 2.2 h of idle current
+    TEST_ASSERT_EQUAL_UINT32(8013200, SensorPowerPolicy::breakEvenMs(AHT20_MODEL));
+    TEST_ASSERT_TRUE(SensorPowerPolicy::keepPowered(AHT20_MODEL, 600000));
+    TEST_ASSERT_TRUE(SensorPowerPolicy::keepPowered(AHT20_MODEL, 3600000));
+    TEST_ASSERT_FALSE(SensorPowerPolicy::keepPowered(AHT20_MODEL, 4 * 3600000UL));
+}
+
+void test_no_idle_current_never_gated() {
+    const SensorPowerModel model = {0, 2, WAIT_UA, RAIL_NC, 800, 0, 0};
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, SensorPowerPolicy::breakEvenMs(model));
+    TEST_ASSERT_TRUE(SensorPowerPolicy::keepPowered(model, UINT32_MAX));
+}
+
+void test_powerup_reset_and_first_conversion_priced() {
+    // 10 ms soft reset + 20 ms discarded conversion, MCU waiting and sensor active
+    const SensorPowerModel model = {200, 2, WAIT_UA, RAIL_NC, 800, 10, 20};
+    // 20 mA x 2 ms + 20.8 mA x 30 ms + 3.3 µC
+    TEST_ASSERT_EQUAL_UINT64(667300, SensorPowerPolicy::gateChargeNc(model));
+    TEST_ASSERT_EQUAL_UINT32(3336500, SensorPowerPolicy::breakEvenMs(model));
+    TEST_ASSERT_TRUE(SensorPowerPolicy::keepPowered(model, 600000));   // Gated without these terms
+}
+
+// =======================================================================================
+// MAIN TEST RUNNER
+// =======================================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    
+    RUN_TEST(test_charges_and_break_even);
+    RUN_TEST(test_sht31_gated_only_for_long_sleeps);
+    RUN_TEST(test_aht20_rail_kept);
+    RUN_TEST(test_no_idle_current_never_gated);
+    RUN_TEST(test_powerup_reset_and_first_conversion_priced);
+    
+    return UNITY_END();
+}
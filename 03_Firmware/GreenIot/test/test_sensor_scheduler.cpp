@@ -0,0 +1,179 @@
+/**
+ * @file test_sensor_scheduler.cpp
+ * @brief Native Unit Tests for the multi-rate acquisition scheduler
+ *
+ * SensorScheduler only does arithmetic on caller-supplied times, so a
+ * simulated clock drives the same code that runs in the firmware.
+ *
+ * Test Coverage:
+ * - Entries whose window has opened share the wake of the earliest deadline
+ * - Deadlines keep their phase after early and late wakes
+ * - Coalescing cuts the wakes per day against one wake per acquisition
+ * - Deadlines resume from the RTC state; changed entries or a clock reset restart them
+ * - Entry validation and slack capping
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#include <unity.h>
+#include <cstdio>
+#include "SensorScheduler.hpp"
+
+static const uint64_t MIN_MS = 60ULL * 1000;
+static const uint64_t DAY_MS = 24ULL * 60 * MIN_MS;
+
+static SensorScheduleState s_state;
+
+// =======================================================================================
+// TEST SETUP & TEARDOWN
+// =======================================================================================
+
+void setUp(void) {
+    s_state = {};
+}
+
+void tearDown(void) {}
+
+// =======================================================================================
+// TESTS
+// =======================================================================================
+
+void test_scheduler_coalesces_open_windows() {
+    SensorScheduler scheduler(s_state);
+    TEST_ASSERT_EQUAL_INT8(0, scheduler.add("climate", 5 * MIN_MS, 1 * MIN_MS));
+    TEST_ASSERT_EQUAL_INT8(1, scheduler.add("co2", 2 * MIN_MS, 1 * MIN_MS));
+    
+    // Cold start: everything due at once
+    uint64_t t0 = 1000000;
+    TEST_ASSERT_FALSE(scheduler.start(t0));
+    TEST_ASSERT_EQUAL_HEX32(0x3, scheduler.dueMask(t0));
+    scheduler.complete(0x3, t0);
+    TEST_ASSERT_EQUAL_UINT64(t0 + 2 * MIN_MS, scheduler.nextWakeMs());
+    TEST_ASSERT_EQUAL_UINT32(2 * MIN_MS, scheduler.sleepMs(t0));
+    
+    // t0+2: only co2
+    uint64_t t = scheduler.nextWakeMs();
+    TEST_ASSERT_EQUAL_HEX32(0x2, scheduler.dueMask(t));
+    scheduler.complete(0x2, t);
+    
+    // t0+4: co2 is due and climate (t0+5) is inside its 1 min slack: one wake for both
+    t = scheduler.nextWakeMs();
+    TEST_ASSERT_EQUAL_UINT64(t0 + 4 * MIN_MS, t);
+    TEST_ASSERT_EQUAL_HEX32(0x3, scheduler.dueMask(t));
+    scheduler.complete(0x3, t);
+    
+    // Climate ran a minute early but keeps its 5 min phase
+    TEST_ASSERT_EQUAL_UINT64(t0 + 10 * MIN_MS, scheduler.deadline(0));
+    TEST_ASSERT_EQUAL_UINT64(t0 + 6 * MIN_MS, scheduler.deadline(1));
+    TEST_ASSERT_EQUAL_UINT32(3, scheduler.wakes());
+    
+    // Completing an entry before its window opens does not move it
+    scheduler.complete(0x1, t0 + 6 * MIN_MS);
+    TEST_ASSERT_EQUAL_UINT64(t0 + 10 * MIN_MS, scheduler.deadline(0));
+}
+
+void test_scheduler_late_wake_skips_missed_periods() {
+    SensorScheduler scheduler(s_state);
+    scheduler.add("climate", 5 * MIN_MS, 30 * 1000);
+    scheduler.start(0);
+    scheduler.complete(0x1, 0);
+    
+    // Woken 17 minutes later (e.g. a long radio retry): one run, back on the 5 min grid
+    uint64_t late = 17 * MIN_MS;
+    TEST_ASSERT_EQUAL_HEX32(0x1, scheduler.dueMask(late));
+    scheduler.complete(0x1, late);
+    TEST_ASSERT_EQUAL_UINT64(20 * MIN_MS, scheduler.deadline(0));
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.sleepMs(25 * MIN_MS));
+}
+
+void test_scheduler_coalescing_reduces_wakes_per_day() {
+    SensorScheduler scheduler(s_state);
+    scheduler.add("climate", 5 * MIN_MS, 1 * MIN_MS);     // 288 / day
+    scheduler.add("light", 3 * MIN_MS, 1 * MIN_MS);       // 480 / day
+    scheduler.add("co2", 10 * MIN_MS, 2 * MIN_MS);        // 144 / day
+    scheduler.add("transmit", 15 * MIN_MS, 1 * MIN_MS);   //  96 / day
+    scheduler.start(0);
+    
+    uint32_t uncoalesced = 0;
+    uint32_t planned = scheduler.plannedWakes(0, DAY_MS, &uncoalesced);
+    char msg[96];
+    snprintf(msg, sizeof(msg), "Wakes per day: %u coalesced, %u one per acquisition",
+             (unsigned)planned, (unsigned)uncoalesced);
+    TEST_MESSAGE(msg);
+    
+    TEST_ASSERT_EQUAL_UINT32(288 + 480 + 144 + 96, uncoalesced);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(480, planned);      // The fastest entry sets the floor
+    TEST_ASSERT_LESS_THAN_UINT32(uncoalesced / 2, planned);
+    
+    // The dry run leaves the real deadlines alone
+    TEST_ASSERT_EQUAL_HEX32(0xF, scheduler.dueMask(0));
+}
+
+void test_scheduler_resumes_from_rtc_state() {
+    {
+        SensorScheduler scheduler(s_state);
+        scheduler.add("climate", 5 * MIN_MS, 30 * 1000);
+        scheduler.add("transmit", 15 * MIN_MS, 30 * 1000);
+        scheduler.start(0);
+        scheduler.complete(0x3, 0);
+    }
+    
+    // Next boot: same entries, deadlines come back from the state
+    SensorScheduler woken(s_state);
+    woken.add("climate", 5 * MIN_MS, 30 * 1000);
+    woken.add("transmit", 15 * MIN_MS, 30 * 1000);
+    TEST_ASSERT_TRUE(woken.start(5 * MIN_MS));
+    TEST_ASSERT_EQUAL_HEX32(0x1, woken.dueMask(5 * MIN_MS));
+    TEST_ASSERT_EQUAL_UINT64(15 * MIN_MS, woken.deadline(1));
+    woken.complete(0x1, 5 * MIN_MS);
+    
+    // Clock went backwards (RTC lost power): a deadline is now more than a period ahead
+    TEST_ASSERT_FALSE(woken.start(1000));
+    TEST_ASSERT_EQUAL_HEX32(0x3, woken.dueMask(1000));
+    
+    // New configuration: restart
+    SensorScheduler changed(s_state);
+    changed.add("climate", 2 * MIN_MS, 30 * 1000);
+    changed.add("transmit", 15 * MIN_MS, 30 * 1000);
+    TEST_ASSERT_FALSE(changed.start(5000));
+    TEST_ASSERT_EQUAL_HEX32(0x3, changed.dueMask(5000));
+}
+
+void test_scheduler_rejects_invalid_entries() {
+    SensorScheduler scheduler(s_state);
+    TEST_ASSERT_EQUAL_INT8(-1, scheduler.add("zero", 0, 0));
+    
+    // Slack is capped at half the period
+    TEST_ASSERT_EQUAL_INT8(0, scheduler.add("fast", 10000, 60000));
+    scheduler.start(0);
+    scheduler.complete(0x1, 0);
+    TEST_ASSERT_EQUAL_HEX32(0x0, scheduler.dueMask(4999));
+    TEST_ASSERT_EQUAL_HEX32(0x1, scheduler.dueMask(5000));
+    
+    for (uint8_t i = 1; i < SENSOR_SCHEDULER_MAX_ENTRIES; i++) {
+        TEST_ASSERT_EQUAL_INT8(i, scheduler.add("fill", 1000, 0));
+    }
+    TEST_ASSERT_EQUAL_INT8(-1, scheduler.add("overflow", 1000, 0));
+    TEST_ASSERT_EQUAL_UINT8(SENSOR_SCHEDULER_MAX_ENTRIES, scheduler.size());
+    
+    SensorScheduler empty(s_state);
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, empty.nextWakeMs());
+    TEST_ASSERT_EQUAL_UINT32(0, empty.plannedWakes(0, DAY_MS));
+}
+
+// =======================================================================================
+// MAIN TEST RUNNER
+// =======================================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    
+    RUN_TEST(test_scheduler_coalesces_open_windows);
+    RUN_TEST(test_scheduler_late_wake_skips_missed_periods);
+    RUN_TEST(test_scheduler_coalescing_reduces_wakes_per_day);
+    RUN_TEST(test_scheduler_resumes_from_rtc_state);
+    RUN_TEST(test_scheduler_rejects_invalid_entries);
+    
+    return UNITY_END();
+}
@@ -1,174 +1,81 @@
 /**
  * @file test_sensor_simple.cpp
- * @brief Simplified Unit Tests for C++ Sensor Interface
- * 
- * This test file contains mock implementations to run tests natively
- * without needing ESP-IDF or hardware dependencies.
+ * @brief Unit Tests for the C++ Sensor Interface
+ *
+ * Runs the real SensorFactory, SHT31Sensor and I2CDriver against the
+ * simulated bus (SimI2CBus + VirtualSHT31 at 0x44), so the suite builds with
+ * the HAL sources of the native environment instead of shadowing them.
+ *
+ * Test Coverage:
+ * - Sensor factory lookup and registry
+ * - I2C driver singleton and init on the simulated bus
+ * - SHT31 metadata, init, single-shot read and configuration
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-04
  */
 
 #include <unity.h>
-#include <memory>
-#include <string>
-#include <vector>
 #include <cstring>
-#include <cstdint>
+#include "I2CDriver.hpp"
+#include "ISensor.hpp"
+#include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sim_i2c_bus.h"
+#include "virtual_sht31.h"
 
-// =======================================================================================
-// MOCK ENUMS AND STRUCTURES (mirroring the real ones)
-// =======================================================================================
-
-enum class SensorStatus {
-    OK = 0,
-    ERROR_INIT,
-    ERROR_COMM,
-    ERROR_TIMEOUT,
-    ERROR_CRC,
-    ERROR_INVALID_PARAM
-};
-
-enum class I2CStatus {
-    OK = 0,
-    ERROR_INIT,
-    ERROR_COMM
-};
-
-struct SensorData {
-    float temperature_celsius;
-    float humidity_percent;
-    uint32_t timestamp;
-};
-
-struct SensorInfo {
-    std::string name;
-    std::string manufacturer;
-    float temp_min, temp_max, temp_accuracy;
-    float hum_min, hum_max, hum_accuracy;
-};
-
-struct SensorConfig {};
-struct I2CConfig { int sda_pin, scl_pin, frequency_hz; };
-
-// =======================================================================================
-// MOCK SENSOR INTERFACE
-// =======================================================================================
-
-class ISensor {
-public:
-    virtual ~ISensor() = default;
-    virtual SensorStatus init() = 0;
-    virtual SensorStatus read(SensorData& data) = 0;
-    virtual SensorStatus triggerMeasurement() = 0;
-    virtual SensorStatus configure(const SensorConfig& config) = 0;
-    virtual const SensorInfo& getInfo() const = 0;
-};
-
-// =======================================================================================
-// MOCK I2C DRIVER
-// =======================================================================================
-
-class I2CDriver {
-public:
-    static I2CDriver& getInstance() {
-        static I2CDriver instance;
-        return instance;
-    }
-    
-    I2CStatus init(const I2CConfig& config) {
-        (void)config;
-        return I2CStatus::OK;
-    }
-private:
-    I2CDriver() = default;
-};
+static SimI2CBus s_bus;
+static VirtualSHT31 s_sht31(0x44);
 
 // =======================================================================================
-// MOCK SHT31 SENSOR
+// TEST SETUP & TEARDOWN
 // =======================================================================================
 
-class SHT31Sensor : public ISensor {
-public:
-    SHT31Sensor() {
-        m_info.name = "SHT31";
-        m_info.manufacturer = "Sensirion";
-        m_info.temp_min = -40.0f;
-        m_info.temp_max = 125.0f;
-        m_info.temp_accuracy = 0.3f;
-        m_info.hum_min = 0.0f;
-        m_info.hum_max = 100.0f;
-        m_info.hum_accuracy = 2.0f;
-    }
-    
-    SensorStatus init() override {
-        m_initialized = true;
-        return SensorStatus::OK;
-    }
-    
-    SensorStatus triggerMeasurement() override {
-        if (!m_initialized) return SensorStatus::ERROR_INIT;
-        return SensorStatus::OK;
-    }
+void setUp(void) {
+    s_bus.detachAll();
+    s_sht31 = VirtualSHT31(0x44);
+    s_bus.attach(&s_sht31);
     
-    SensorStatus read(SensorData& data) override {
-        if (!m_initialized) return SensorStatus::ERROR_INIT;
-        
-        // Return mock data
-        data.temperature_celsius = 25.0f;
-        data.humidity_percent = 60.0f;
-        data.timestamp = 1000;
-        
-        return SensorStatus::OK;
-    }
+    // Cold boot: empty topology cache, sensor starts uninitialised
+    I2CDriver& driver = I2CDriver::getInstance();
+    driver.deinit();
+    native_set_reset_reason(ESP_RST_POWERON);
+    driver.setBackend(&s_bus);
     
-    SensorStatus configure(const SensorConfig& config) override {
-        (void)config;
-        return SensorStatus::OK;
-    }
-    
-    const SensorInfo& getInfo() const override {
-        return m_info;
-    }
+    I2CConfig config;
+    TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(driver.init(config)));
+    SensorFactory::create("SHT31")->deinit();
     
-private:
-    bool m_initialized = false;
-    SensorInfo m_info;
-};
-
-// =======================================================================================
-// MOCK SENSOR FACTORY
-// =======================================================================================
+    // The host RTOS creates the calling thread's notification slot on first
+    // use; on target the TCB is static
+    xTaskGetCurrentTaskHandle();
+}
 
-class SensorFactory {
-public:
-    static std::unique_ptr<ISensor> create(const std::string& name) {
-        if (name == "SHT31") {
-            return std::make_unique<SHT31Sensor>();
-        }
-        return nullptr;
-    }
-    
-    static std::vector<std::string> getAvailableSensors() {
-        return {"SHT31"};
-    }
-};
+void tearDown(void) {
+    I2CDriver::getInstance().waitIdle(100);
+}
 
 // =======================================================================================
 // UNIT TESTS
 // =======================================================================================
 
 void test_sensor_factory_create_sht31() {
-    auto sensor = SensorFactory::create("SHT31");
-    TEST_ASSERT_NOT_NULL(sensor.get());
+    ISensor* sensor = SensorFactory::create("SHT31");
+    TEST_ASSERT_NOT_NULL(sensor);
+    TEST_ASSERT_EQUAL_PTR(sensor, SensorFactory::create("SHT31"));  // One static instance
 }
 
 void test_sensor_factory_create_unknown_returns_null() {
-    auto sensor = SensorFactory::create("UNKNOWN_SENSOR");
-    TEST_ASSERT_NULL(sensor.get());
+    TEST_ASSERT_NULL(SensorFactory::create("UNKNOWN_SENSOR"));
+    TEST_ASSERT_NULL(SensorFactory::create(nullptr));
 }
 
 void test_sensor_factory_get_available_sensors() {
-    auto sensors = SensorFactory::getAvailableSensors();
-    TEST_ASSERT_EQUAL(1, sensors.size());
-    TEST_ASSERT_EQUAL_STRING("SHT31", sensors[0].c_str());
+    TEST_ASSERT_EQUAL(2, SensorFactory::getSensorCount());
+    TEST_ASSERT_EQUAL_STRING("SHT31", SensorFactory::getSensorName(0));
+    TEST_ASSERT_EQUAL_STRING("AHT20", SensorFactory::getSensorName(1));
+    TEST_ASSERT_NULL(SensorFactory::getSensorName(2));
 }
 
 void test_i2c_driver_singleton() {
@@ -178,37 +85,44 @@ void test_i2c_driver_singleton() {
 }
 
 void test_i2c_driver_init() {
+    I2CDriver& driver = I2CDriver::getInstance();
+    driver.deinit();
+    
     I2CConfig config;
     config.sda_pin = 8;
     config.scl_pin = 9;
     config.frequency_hz = 100000;
     
-    I2CStatus status = I2CDriver::getInstance().init(config);
+    I2CStatus status = driver.init(config);
     TEST_ASSERT_EQUAL(static_cast<int>(I2CStatus::OK), static_cast<int>(status));
+    TEST_ASSERT_TRUE(driver.isDevicePresent(0x44));
+    TEST_ASSERT_FALSE(driver.isDevicePresent(0x45));
 }
 
 void test_sht31_sensor_info() {
-    auto sensor = SensorFactory::create("SHT31");
-    TEST_ASSERT_NOT_NULL(sensor.get());
+    ISensor* sensor = SensorFactory::create("SHT31");
+    TEST_ASSERT_NOT_NULL(sensor);
     
     const SensorInfo& info = sensor->getInfo();
-    TEST_ASSERT_EQUAL_STRING("SHT31", info.name.c_str());
-    TEST_ASSERT_EQUAL_STRING("Sensirion", info.manufacturer.c_str());
-    TEST_ASSERT_EQUAL_FLOAT(-40.0f, info.temp_min);
-    TEST_ASSERT_EQUAL_FLOAT(125.0f, info.temp_max);
+    TEST_ASSERT_EQUAL_STRING("SHT31", info.name);
+    TEST_ASSERT_EQUAL_STRING("Sensirion", info.manufacturer);
+    TEST_ASSERT_EQUAL_INT16(-4000, info.temp_min_centi_c);
+    TEST_ASSERT_EQUAL_INT16(12500, info.temp_max_centi_c);
 }
 
 void test_sht31_sensor_init() {
-    auto sensor = SensorFactory::create("SHT31");
-    TEST_ASSERT_NOT_NULL(sensor.get());
+    ISensor* sensor = SensorFactory::create("SHT31");
+    TEST_ASSERT_NOT_NULL(sensor);
     
     SensorStatus status = sensor->init();
     TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(status));
+    TEST_ASSERT_EQUAL_UINT32(1, s_sht31.softResets());  // Cold boot: discovered by soft reset
 }
 
 void test_sht31_sensor_read_data() {
-    auto sensor = SensorFactory::create("SHT31");
-    sensor->init();
+    s_sht31.setConditions(25.0f, 60.0f);
+    ISensor* sensor = SensorFactory::create("SHT31");
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor->init()));
     
     // Trigger measurement
     SensorStatus status = sensor->triggerMeasurement();
@@ -219,24 +133,25 @@ void test_sht31_sensor_read_data() {
     status = sensor->read(data);
     TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(status));
     
-    // Verify mock data
-    TEST_ASSERT_EQUAL_FLOAT(25.0f, data.temperature_celsius);
-    TEST_ASSERT_EQUAL_FLOAT(60.0f, data.humidity_percent);
-    TEST_ASSERT_EQUAL_UINT32(1000, data.timestamp);
+    // Raw codes round to the nearest centi-unit
+    TEST_ASSERT_INT_WITHIN(1, 2500, data.temperature_centi_c);
+    TEST_ASSERT_INT_WITHIN(1, 6000, data.humidity_centi_pct);
+    TEST_ASSERT_EQUAL_UINT32(1, s_sht31.measurementsStarted());
 }
 
 void test_sht31_sensor_read_without_init_fails() {
-    auto sensor = SensorFactory::create("SHT31");
+    ISensor* sensor = SensorFactory::create("SHT31");
     
     SensorData data;
     SensorStatus status = sensor->read(data);
     
-    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::ERROR_INIT), static_cast<int>(status));
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::ERROR_NOT_READY), static_cast<int>(status));
+    TEST_ASSERT_EQUAL_UINT32(0, s_sht31.measurementsStarted());
 }
 
 void test_sensor_configure() {
-    auto sensor = SensorFactory::create("SHT31");
-    sensor->init();
+    ISensor* sensor = SensorFactory::create("SHT31");
+    TEST_ASSERT_EQUAL(static_cast<int>(SensorStatus::OK), static_cast<int>(sensor->init()));
     
     SensorConfig config;
     SensorStatus status = sensor->configure(config);
@@ -265,4 +180,3 @@ int main(int argc, char **argv) {
     
     return UNITY_END();
 }
-
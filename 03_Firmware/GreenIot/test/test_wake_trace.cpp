@@ -0,0 +1,159 @@
+/**
+ * @file test_wake_trace.cpp
+ * @brief Native Unit Tests for the wake-cycle trace ring
+ *
+ * Test Coverage:
+ * - Cycle and clock records open a wake; records kept in order with stamps
+ * - Nothing recorded before the first cycle; scoped spans close themselves
+ * - Full ring overwrites the oldest record and counts the loss
+ * - Ring printed and cleared before a cycle that might not fit
+ * - Garbage RTC contents are discarded
+ *
+ * @author GreenIoT Vertical Farming Project
+ * @date 2025-11-06
+ */
+
+#include <unity.h>
+#include <cstring>
+#include "WakeTrace.hpp"
+
+static WakeTraceState s_state;
+
+// =======================================================================================
+// TEST SETUP & TEARDOWN
+// =======================================================================================
+
+void setUp(void) {
+    memset(&s_state, 0, sizeof(s_state));  // Cold boot
+}
+
+void tearDown(void) {}
+
+// =======================================================================================
+// TESTS
+// =======================================================================================
+
+void test_cycle_opens_with_clock_and_keeps_order() {
+    WakeTrace trace(s_state);
+    trace.record(TraceType::BEGIN, TracePoint::SETUP);  // Before the first cycle: dropped
+    TEST_ASSERT_EQUAL_UINT16(0, trace.size());
+    
+    trace.startCycle(1700000123456ULL);
+    trace.record(TraceType::BEGIN, TracePoint::I2C_INIT);
+    trace.record(TraceType::END, TracePoint::I2C_INIT);
+    trace.record(TraceType::INSTANT, TracePoint::DEEP_SLEEP, 300);
+    TEST_ASSERT_EQUAL_UINT16(5, trace.size());
+    TEST_ASSERT_EQUAL_UINT16(1, trace.cycle());
+    
+    TraceEvent ev;
+    TEST_ASSERT_TRUE(trace.event(0, ev));
+    TEST_ASSERT_EQUAL(TraceType::CYCLE, ev.type);
+    TEST_ASSERT_EQUAL_UINT16(1, ev.arg);
+    uint32_t cycle_us = ev.time_us;
+    TEST_ASSERT_TRUE(trace.event(1, ev));
+    TEST_ASSERT_EQUAL(TraceType::CLOCK, ev.type);
+    TEST_ASSERT_EQUAL_UINT32(1700000123, ev.time_us);
+    TEST_ASSERT_EQUAL_UINT16(456, ev.arg);
+    
+    TEST_ASSERT_TRUE(trace.event(2, ev));
+    TEST_ASSERT_EQUAL(TraceType::BEGIN, ev.type);
+    TEST_ASSERT_EQUAL(TracePoint::I2C_INIT, ev.point);
+    TEST_ASSERT_TRUE(ev.time_us >= cycle_us);
+    TEST_ASSERT_TRUE(trace.event(4, ev));
+    TEST_ASSERT_EQUAL(TraceType::INSTANT, ev.type);
+    TEST_ASSERT_EQUAL_UINT16(300, ev.arg);
+    TEST_ASSERT_EQUAL_STRING("DEEP_SLEEP", tracePointName(ev.point));
+    TEST_ASSERT_FALSE(trace.event(5, ev));
+    
+    // Next wake: records kept, counter advances
+    trace.startCycle(1700000423456ULL);
+    TEST_ASSERT_EQUAL_UINT16(7, trace.size());
+    TEST_ASSERT_EQUAL_UINT16(2, trace.cycle());
+    
+    // The firmware's ring: a scope records both ends of its span
+    WakeTrace& global = WakeTrace::getInstance();
+    global.startCycle(0);
+    uint16_t before = global.size();
+    {
+        WakeTraceScope scope(TracePoint::SENSOR_INIT);
+        TEST_ASSERT_EQUAL_UINT16(before + 1, global.size());
+    }
+    TEST_ASSERT_TRUE(global.event(before + 1, ev));
+    TEST_ASSERT_EQUAL(TraceType::END, ev.type);
+    TEST_ASSERT_EQUAL(TracePoint::SENSOR_INIT, ev.point);
+}
+
+void test_full_ring_overwrites_oldest() {
+    WakeTrace trace(s_state);
+    trace.startCycle(0);
+    for (uint16_t i = 0; i < WAKE_TRACE_CAPACITY; i++) {
+        trace.record(TraceType::INSTANT, TracePoint::RADIO_DONE, i);
+    }
+    
+    // CYCLE and CLOCK were pushed out
+    TEST_ASSERT_EQUAL_UINT16(WAKE_TRACE_CAPACITY, trace.size());
+    TEST_ASSERT_EQUAL_UINT16(2, trace.lost());
+    TraceEvent ev;
+    TEST_ASSERT_TRUE(trace.event(0, ev));
+    TEST_ASSERT_EQUAL(TraceType::INSTANT, ev.type);
+    TEST_ASSERT_EQUAL_UINT16(0, ev.arg);
+    TEST_ASSERT_TRUE(trace.event(WAKE_TRACE_CAPACITY - 1, ev));
+    TEST_ASSERT_EQUAL_UINT16(WAKE_TRACE_CAPACITY - 1, ev.arg);
+}
+
+void test_ring_printed_before_a_cycle_that_might_not_fit() {
+    WakeTrace trace(s_state);
+    trace.startCycle(0);
+    while (!trace.dumpDue()) {
+        trace.record(TraceType::INSTANT, TracePoint::MEASURE_ONLY);
+    }
+    uint16_t kept = trace.size();
+    TEST_ASSERT_EQUAL_UINT16(WAKE_TRACE_CAPACITY - WAKE_TRACE_CYCLE_RESERVE + 1, kept);
+    
+    // The dump empties the ring; the new cycle notes how much was printed
+    trace.startCycle(1000);
+    TEST_ASSERT_EQUAL_UINT16(3, trace.size());
+    TEST_ASSERT_EQUAL_UINT16(2, trace.cycle());
+    TraceEvent ev;
+    TEST_ASSERT_TRUE(trace.event(0, ev));
+    TEST_ASSERT_EQUAL(TraceType::CYCLE, ev.type);
+    TEST_ASSERT_TRUE(trace.event(2, ev));
+    TEST_ASSERT_EQUAL(TracePoint::TRACE_DUMP, ev.point);
+    TEST_ASSERT_EQUAL_UINT16(kept, ev.arg);
+}
+
+void test_garbage_rtc_contents_discarded() {
+    WakeTrace trace(s_state);
+    trace.startCycle(0);
+    trace.startCycle(0);
+    TEST_ASSERT_EQUAL_UINT16(2, trace.cycle());
+    
+    // Right magic, impossible bounds (e.g. a new image with another layout)
+    s_state.count = WAKE_TRACE_CAPACITY + 7;
+    trace.startCycle(0);
+    TEST_ASSERT_EQUAL_UINT16(1, trace.cycle());
+    TEST_ASSERT_EQUAL_UINT16(2, trace.size());
+    
+    // Power-on garbage
+    memset(&s_state, 0xA5, sizeof(s_state));
+    trace.record(TraceType::BEGIN, TracePoint::SETUP);  // Not a valid ring yet: ignored
+    trace.startCycle(0);
+    TEST_ASSERT_EQUAL_UINT16(1, trace.cycle());
+    TEST_ASSERT_EQUAL_UINT16(2, trace.size());
+    TEST_ASSERT_EQUAL_UINT16(0, trace.lost());
+}
+
+// =======================================================================================
+// MAIN TEST RUNNER
+// =======================================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    
+    RUN_TEST(test_cycle_opens_with_clock_and_keeps_order);
+    RUN_TEST(test_full_ring_overwrites_oldest);
+    RUN_TEST(test_ring_printed_before_a_cycle_that_might_not_fit);
+    RUN_TEST(test_garbage_rtc_contents_discarded);
+    
+    return UNITY_END();
+}
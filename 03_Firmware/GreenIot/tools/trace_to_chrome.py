@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+"""
+Wake Trace to Chrome Trace Converter
+
+Reads serial monitor logs of a node built with the esp32-c3-trace env and
+converts the printed WakeTrace records into Chrome trace JSON, which opens
+in chrome://tracing or https://ui.perfetto.dev:
+- One span per phase of each wake (setup, I2C, sensor, radio, states)
+- Instants (measure-only wake, radio done, deep sleep)
+- Wakes placed on one timeline by their clock time, or stacked one row
+  per wake (--stack) to compare the phases of many cycles
+
+A per-phase summary (count, mean, max) is printed as well.
+
+Usage:
+    python trace_to_chrome.py monitor.log [more.log ...] -o trace.json
+    python trace_to_chrome.py monitor.log --stack -o cycles.json
+
+Author: GreenIoT Vertical Farming Project
+Date: November 6, 2025
+"""
+
+import argparse
+import json
+import re
+import sys
+from collections import defaultdict
+
+# "I (1234) TRACE: B I2C_INIT 81234 0" (see WakeTrace.hpp)
+RECORD_RE = re.compile(r'TRACE: ([BEICK]) (\S+) (\d+) (\d+)\s*$')
+ANSI_RE = re.compile(r'\x1b\[[0-9;]*m')
+
+WRAP_US = 1 << 32
+
+
+def parse_logs(filenames):
+    """Yield (type, point, time_us, arg) for every trace record in the logs"""
+    for filename in filenames:
+        with open(filename, 'r', errors='replace') as f:
+            for line in f:
+                match = RECORD_RE.search(ANSI_RE.sub('', line))
+                if match:
+                    yield (match.group(1), match.group(2),
+                           int(match.group(3)), int(match.group(4)))
+
+
+def split_cycles(records):
+    """Group records into wakes; records before a wake's CYCLE/CLOCK are dropped"""
+    cycles = []
+    cycle = None
+    skipped = 0
+
+    for kind, point, time_us, arg in records:
+        if kind == 'C':
+            cycle = {'number': arg, 'boot_ref_us': time_us, 'clock_us': None,
+                     'events': [], 'last_raw': time_us, 'wrap': 0}
+            cycles.append(cycle)
+        elif kind == 'K':
+            if cycle is not None:
+                cycle['clock_us'] = time_us * 1000000 + arg * 1000
+        elif cycle is None or cycle['clock_us'] is None:
+            skipped += 1
+        else:
+            # esp_timer stamps are 32 bits: about 71 minutes awake
+            if time_us + WRAP_US // 2 < cycle['last_raw']:
+                cycle['wrap'] += WRAP_US
+            cycle['last_raw'] = time_us
+            cycle['events'].append((kind, point, time_us + cycle['wrap'], arg))
+
+    if skipped:
+        print(f"⚠️  {skipped} records outside a complete cycle skipped", file=sys.stderr)
+    return [c for c in cycles if c['clock_us'] is not None]
+
+
+def to_chrome(cycles, stack):
+    """Build the Chrome trace event list and the per-phase durations"""
+    trace = []
+    durations = defaultdict(list)
+    if not cycles:
+        return trace, durations
+
+    # Absolute: µs since the first wake's boot, on the node's clock
+    origin_us = cycles[0]['clock_us'] - cycles[0]['boot_ref_us']
+
+    for cycle in cycles:
+        tid = cycle['number'] if stack else 1
+        offset = 0 if stack else cycle['clock_us'] - cycle['boot_ref_us'] - origin_us
+        if stack:
+            trace.append({'name': 'thread_name', 'ph': 'M', 'pid': 1, 'tid': tid,
+                          'args': {'name': f"wake {cycle['number']}"}})
+
+        open_spans = []
+        last_ts = 0
+        for kind, point, time_us, arg in cycle['events']:
+            ts = time_us + offset
+            last_ts = ts
+            if kind == 'B':
+                open_spans.append((point, ts))
+                trace.append({'name': point, 'ph': 'B', 'ts': ts, 'pid': 1, 'tid': tid,
+                              'args': {'wake': cycle['number']}})
+            elif kind == 'E':
+                # Close up to the matching begin (an early return may skip an end)
+                names = [name for name, _ in open_spans]
+                if point not in names:
+                    continue
+                while open_spans:
+                    name, begin_ts = open_spans.pop()
+                    trace.append({'name': name, 'ph': 'E', 'ts': ts, 'pid': 1, 'tid': tid})
+                    durations[name].append(ts - begin_ts)
+                    if name == point:
+                        break
+            else:
+                trace.append({'name': point, 'ph': 'i', 's': 't', 'ts': ts, 'pid': 1, 'tid': tid,
+                              'args': {'arg': arg, 'wake': cycle['number']}})
+
+        # Spans still open at deep sleep (e.g. the SLEEP state) end with the wake
+        while open_spans:
+            name, begin_ts = open_spans.pop()
+            trace.append({'name': name, 'ph': 'E', 'ts': last_ts, 'pid': 1, 'tid': tid})
+            durations[name].append(last_ts - begin_ts)
+
+        awake_us = cycle['events'][-1][2] if cycle['events'] else 0
+        durations['(awake)'].append(awake_us)
+
+    return trace, durations
+
+
+def print_summary(cycles, durations):
+    """Print count, mean and max duration per phase"""
+    print(f"\n📊 {len(cycles)} wakes")
+    print(f"{'Phase':<16} {'Count':>6} {'Mean ms':>10} {'Max ms':>10}")
+    print('-' * 45)
+    for name in sorted(durations, key=lambda n: -sum(durations[n]) / len(durations[n])):
+        values = durations[name]
+        mean_ms = sum(values) / len(values) / 1000
+        max_ms = max(values) / 1000
+        print(f"{name:<16} {len(values):>6} {mean_ms:>10.2f} {max_ms:>10.2f}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert WakeTrace dumps to Chrome trace JSON')
+    parser.add_argument('logs', nargs='+', help='Serial monitor log files (in time order)')
+    parser.add_argument('-o', '--output', default='wake_trace.json', help='Output JSON file')
+    parser.add_argument('--stack', action='store_true',
+                        help='One row per wake, all aligned at boot')
+    args = parser.parse_args()
+
+    cycles = split_cycles(parse_logs(args.logs))
+    if not cycles:
+        print("❌ No trace cycles found (is the node built with the esp32-c3-trace env?)")
+        return 1
+
+    trace, durations = to_chrome(cycles, args.stack)
+    with open(args.output, 'w') as f:
+        json.dump({'traceEvents': trace, 'displayTimeUnit': 'ms'}, f)
+
+    print(f"✅ {len(trace)} trace events written to {args.output}")
+    print_summary(cycles, durations)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())